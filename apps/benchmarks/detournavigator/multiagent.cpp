@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/esm3/loadland.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    RecastSettings makeSettings()
+    {
+        RecastSettings result;
+        result.mBorderSize = 16;
+        result.mCellHeight = 0.2f;
+        result.mCellSize = 0.2f;
+        result.mDetailSampleDist = 6;
+        result.mDetailSampleMaxError = 1;
+        result.mMaxClimb = 34;
+        result.mMaxSimplificationError = 1.3f;
+        result.mMaxSlope = 49;
+        result.mRecastScaleFactor = 0.017647058823529415f;
+        result.mSwimHeightScale = 0.89999997615814208984375f;
+        result.mMaxEdgeLen = 12;
+        result.mMaxVertsPerPoly = 6;
+        result.mRegionMergeArea = 400;
+        result.mRegionMinArea = 64;
+        result.mTileSize = 64;
+        return result;
+    }
+
+    // Hilly terrain partially covered by water to make each agent produce a different tile
+    std::shared_ptr<RecastMesh> makeRecastMesh(const RecastSettings& settings, const TilePosition& tilePosition)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-50, 50);
+        std::vector<float> heights(ESM::Land::LAND_NUM_VERTS);
+        for (int y = 0; y < ESM::Land::LAND_SIZE; ++y)
+            for (int x = 0; x < ESM::Land::LAND_SIZE; ++x)
+                heights[y * ESM::Land::LAND_SIZE + x]
+                    = 1000 * std::sin(x * 0.3f) * std::cos(y * 0.2f) + distribution(random);
+        const auto [minHeight, maxHeight] = std::minmax_element(heights.begin(), heights.end());
+        const osg::Vec2i cellPosition(0, 0);
+        RecastMeshBuilder builder(makeRealTileBoundsWithBorder(settings, tilePosition));
+        builder.addHeightfield(cellPosition, ESM::Land::REAL_SIZE, heights.data(), heights.size(), *minHeight,
+            *maxHeight);
+        builder.addWater(cellPosition, Water{ ESM::Land::REAL_SIZE, 0 });
+        return std::move(builder).create(Version{});
+    }
+
+    std::vector<AgentBounds> makeAgentsBounds(std::size_t count)
+    {
+        std::vector<AgentBounds> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float size = static_cast<float>(i);
+            result.push_back(AgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(20 + size, 20 + size, 50 + 4 * size) });
+        }
+        return result;
+    }
+
+    struct Input
+    {
+        const RecastSettings mSettings = makeSettings();
+        const TilePosition mTilePosition{ 1, 1 };
+        const ESM::RefId mWorldspace = ESM::RefId::stringRefId("sys::default");
+        const std::shared_ptr<RecastMesh> mRecastMesh = makeRecastMesh(mSettings, mTilePosition);
+    };
+
+    void prepareNavMeshTileDataPerAgent(benchmark::State& state)
+    {
+        const Input input;
+        const std::vector<AgentBounds> agentsBounds = makeAgentsBounds(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            for (const AgentBounds& agentBounds : agentsBounds)
+            {
+                std::unique_ptr<PreparedNavMeshData> result = prepareNavMeshTileData(
+                    *input.mRecastMesh, input.mWorldspace, input.mTilePosition, agentBounds, input.mSettings);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void prepareNavMeshTilesDataForAllAgents(benchmark::State& state)
+    {
+        const Input input;
+        const std::vector<AgentBounds> agentsBounds = makeAgentsBounds(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            std::vector<std::unique_ptr<PreparedNavMeshData>> result = prepareNavMeshTilesData(
+                *input.mRecastMesh, input.mWorldspace, input.mTilePosition, agentsBounds, input.mSettings);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(prepareNavMeshTileDataPerAgent)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(prepareNavMeshTilesDataForAllAgents)->Arg(1)->Arg(4)->Arg(16);
+
+BENCHMARK_MAIN();
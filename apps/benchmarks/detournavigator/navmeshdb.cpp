@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/misc/compression.hpp>
+#include <components/sqlite3/db.hpp>
+#include <components/sqlite3/request.hpp>
+#include <components/sqlite3/statement.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    struct Key
+    {
+        ESM::RefId mWorldspace;
+        TilePosition mTilePosition;
+        std::vector<std::byte> mInput;
+    };
+
+    struct GetTilesKeys
+    {
+        static std::string_view text() noexcept
+        {
+            return "SELECT worldspace, tile_position_x, tile_position_y, input FROM tiles";
+        }
+
+        static void bind(sqlite3&, sqlite3_stmt&) {}
+    };
+
+    // Mimics serialized recast mesh: vertices on a grid with a few distinct heights
+    std::vector<std::byte> generateInput(std::size_t size, auto& random)
+    {
+        std::uniform_int_distribution<int> distribution(0, 64);
+        std::vector<float> values(size / sizeof(float));
+        std::generate(values.begin(), values.end(), [&] { return static_cast<float>(distribution(random)) * 16; });
+        std::vector<std::byte> result(values.size() * sizeof(float));
+        std::memcpy(result.data(), values.data(), result.size());
+        return result;
+    }
+
+    std::filesystem::path getDbPath()
+    {
+        return std::filesystem::temp_directory_path() / "openmw_navmeshdb_benchmark.db";
+    }
+
+    std::vector<Key> generateDb(std::size_t tilesCount)
+    {
+        const std::filesystem::path path = getDbPath();
+        std::filesystem::remove(path);
+        NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> inputSize(4 * 1024, 64 * 1024);
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const int side = static_cast<int>(std::sqrt(static_cast<double>(tilesCount))) + 1;
+        const std::vector<std::byte> data(16 * 1024);
+        std::vector<Key> result;
+        auto transaction = db.startTransaction();
+        for (std::size_t i = 0; i < tilesCount; ++i)
+        {
+            const TilePosition tilePosition(static_cast<int>(i) % side, static_cast<int>(i) / side);
+            std::vector<std::byte> input = generateInput(inputSize(random), random);
+            db.insertTile(TileId{ static_cast<std::int64_t>(i + 1) }, worldspace, tilePosition, TileVersion{ 1 },
+                input, data);
+            result.push_back(Key{ worldspace, tilePosition, std::move(input) });
+        }
+        transaction.commit();
+        return result;
+    }
+
+    // Reads lookup keys from a navmeshtool generated database copied to a temporary file
+    std::vector<Key> copyDb(const std::filesystem::path& source)
+    {
+        const std::filesystem::path path = getDbPath();
+        std::filesystem::copy_file(source, path, std::filesystem::copy_options::overwrite_existing);
+        NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+        const Sqlite3::Db handle = Sqlite3::makeDb(path.string(), "");
+        Sqlite3::Statement<GetTilesKeys> statement(*handle);
+        std::vector<std::tuple<std::string, int, int, std::vector<std::byte>>> rows;
+        Sqlite3::request(*handle, statement, std::back_inserter(rows), std::numeric_limits<std::size_t>::max());
+        std::vector<Key> result;
+        result.reserve(rows.size());
+        for (auto& [worldspace, x, y, input] : rows)
+            result.push_back(Key{ ESM::RefId::deserializeText(worldspace), TilePosition(x, y),
+                Misc::decompress(input) });
+        return result;
+    }
+
+    const std::vector<Key>& getKeys()
+    {
+        static const std::vector<Key> keys = [] {
+            if (const char* const path = std::getenv("OPENMW_NAVMESHDB_BENCHMARK_PATH"))
+                return copyDb(path);
+            return generateDb(1024);
+        }();
+        return keys;
+    }
+
+    void findTile(benchmark::State& state)
+    {
+        const std::vector<Key>& keys = getKeys();
+        NavMeshDb db(getDbPath().string(), std::numeric_limits<std::uint64_t>::max());
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            const Key& key = keys[i++ % keys.size()];
+            benchmark::DoNotOptimize(db.findTile(key.mWorldspace, key.mTilePosition, key.mInput));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void findMissingTile(benchmark::State& state)
+    {
+        std::vector<Key> keys = getKeys();
+        for (Key& key : keys)
+            key.mInput.push_back(std::byte{ 0 });
+        NavMeshDb db(getDbPath().string(), std::numeric_limits<std::uint64_t>::max());
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            const Key& key = keys[i++ % keys.size()];
+            benchmark::DoNotOptimize(db.findTile(key.mWorldspace, key.mTilePosition, key.mInput));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void getTileData(benchmark::State& state)
+    {
+        const std::vector<Key>& keys = getKeys();
+        NavMeshDb db(getDbPath().string(), std::numeric_limits<std::uint64_t>::max());
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            const Key& key = keys[i++ % keys.size()];
+            benchmark::DoNotOptimize(db.getTileData(key.mWorldspace, key.mTilePosition, key.mInput));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(findTile);
+BENCHMARK(findMissingTile);
+BENCHMARK(getTileData);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include "components/bsa/memorystream.hpp"
+#include "components/esm4/common.hpp"
+#include "components/esm4/readahead.hpp"
+#include "components/esm4/reader.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t recordsCount = 4096;
+    constexpr std::uint32_t recordType = ESM4::REC_NPC_;
+    // Record header and uncompressed size precede compressed data
+    constexpr std::streamoff recordPrefixSize = sizeof(ESM4::RecordHeader) + sizeof(std::uint32_t);
+
+    struct File
+    {
+        std::string mContent;
+        std::vector<std::streamoff> mRecordPositions;
+    };
+
+    // Mimics record data: subrecords with a few distinct values compress about as well as real records
+    template <class Random>
+    std::string generateRecordData(std::size_t size, Random& random)
+    {
+        std::uniform_int_distribution<int> distribution(0, 15);
+        std::string result;
+        result.reserve(size);
+        std::generate_n(
+            std::back_inserter(result), size, [&] { return static_cast<char>('A' + distribution(random)); });
+        return result;
+    }
+
+    File generateFile(std::size_t recordSize)
+    {
+        std::minstd_rand random;
+        File result;
+        ESM4::RecordHeader groupHeader{};
+        groupHeader.group.typeId = ESM4::REC_GRUP;
+        result.mContent.append(reinterpret_cast<const char*>(&groupHeader), sizeof(groupHeader));
+        for (std::size_t i = 0; i < recordsCount; ++i)
+        {
+            const std::string data = generateRecordData(recordSize, random);
+            uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
+            std::string compressed(compressedSize, '\0');
+            if (compress(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                    reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()))
+                != Z_OK)
+                throw std::runtime_error("Failed to compress record data");
+            compressed.resize(compressedSize);
+            ESM4::RecordHeader header{};
+            header.record.typeId = recordType;
+            header.record.dataSize = static_cast<std::uint32_t>(sizeof(std::uint32_t) + compressed.size());
+            header.record.flags = ESM4::Rec_Compressed;
+            const auto uncompressedSize = static_cast<std::uint32_t>(data.size());
+            result.mContent.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            result.mContent.append(reinterpret_cast<const char*>(&uncompressedSize), sizeof(uncompressedSize));
+            result.mRecordPositions.push_back(static_cast<std::streamoff>(result.mContent.size()));
+            result.mContent.append(compressed);
+        }
+        return result;
+    }
+
+    // Follows ESM4::Reader::getRecordData for each record of the file
+    void readRecords(benchmark::State& state)
+    {
+        const File file = generateFile(static_cast<std::size_t>(state.range(1)));
+        const auto fileSize = static_cast<std::streamoff>(file.mContent.size());
+
+        for (auto _ : state)
+        {
+            std::istringstream stream(file.mContent);
+            ESM4::ReadAhead readAhead(static_cast<std::size_t>(state.range(0)));
+            std::vector<char> compressed;
+            for (std::size_t i = 0; i < file.mRecordPositions.size(); ++i)
+            {
+                const std::streamoff position = file.mRecordPositions[i];
+                const std::streamoff end = i + 1 < file.mRecordPositions.size()
+                    ? file.mRecordPositions[i + 1] - recordPrefixSize
+                    : fileSize;
+                std::uint32_t uncompressedSize = 0;
+                stream.seekg(position - static_cast<std::streamoff>(sizeof(uncompressedSize)));
+                stream.read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uncompressedSize));
+                auto data = readAhead.take(recordType, position);
+                if (data == nullptr)
+                {
+                    compressed.resize(static_cast<std::size_t>(end - position));
+                    stream.read(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+                    data = ESM4::decompress(position, compressed, uncompressedSize);
+                }
+                else
+                {
+                    stream.seekg(end);
+                }
+                readAhead.read(stream, sizeof(ESM4::RecordHeader), fileSize);
+                benchmark::DoNotOptimize(data);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * recordsCount);
+        state.SetBytesProcessed(state.iterations() * recordsCount * state.range(1));
+    }
+}
+
+BENCHMARK(readRecords)->ArgsProduct({ { 0, 1, 2, 4 }, { 1024, 16 * 1024 } })->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <components/lua/serialization.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+    // Mimics a typical event payload: a table with a few fields and a list of small records
+    sol::table makePayload(sol::state& lua, std::int64_t records)
+    {
+        sol::table payload(lua, sol::create);
+        payload["name"] = "openmw_benchmark_event";
+        payload["position"] = osg::Vec3f(1, 2, 3);
+        payload["enabled"] = true;
+        sol::table list(lua, sol::create);
+        for (std::int64_t i = 1; i <= records; ++i)
+        {
+            sol::table record(lua, sol::create);
+            record["id"] = i;
+            record["value"] = static_cast<double>(i) * 0.5;
+            record["tag"] = "record" + std::to_string(i);
+            list[i] = record;
+        }
+        payload["records"] = list;
+        return payload;
+    }
+
+    // Event data passed to another Lua state or saved
+    void serializeAndDeserialize(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table payload = makePayload(lua, state.range(0));
+        for (auto _ : state)
+        {
+            const LuaUtil::BinaryData data = LuaUtil::serialize(payload);
+            benchmark::DoNotOptimize(LuaUtil::deserialize(lua, data));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void serialize(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table payload = makePayload(lua, state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::serialize(payload));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Event data passed within the same Lua state
+    void copy(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table payload = makePayload(lua, state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::copy(payload));
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(serializeAndDeserialize)->Arg(0)->Arg(4)->Arg(64);
+BENCHMARK(serialize)->Arg(0)->Arg(4)->Arg(64);
+BENCHMARK(copy)->Arg(0)->Arg(4)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <components/lua/utilpackage.hpp>
+#include <components/misc/spatialgrid.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Size of 3x3 loaded exterior cells
+    constexpr float worldSize = 3 * 8192;
+    constexpr float queryRadius = 1000;
+    constexpr float gridCellSize = 1024;
+
+    std::vector<osg::Vec3f> generatePositions(std::int64_t count)
+    {
+        std::mt19937 random;
+        std::uniform_real_distribution<float> distribution(0, worldSize);
+        std::vector<osg::Vec3f> result;
+        result.reserve(static_cast<std::size_t>(count));
+        for (std::int64_t i = 0; i < count; ++i)
+            result.emplace_back(distribution(random), distribution(random), distribution(random) / 8);
+        return result;
+    }
+
+    osg::Vec3f getQueryCenter(std::size_t i)
+    {
+        const float t = static_cast<float>(i % 64) / 64;
+        return osg::Vec3f(t * worldSize, (1 - t) * worldSize, 0);
+    }
+
+    // What a script does without native queries: iterates over a nearby list and checks distance to every object
+    void luaFilterInRadius(benchmark::State& state)
+    {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base);
+        lua["util"] = LuaUtil::initUtilPackage(lua);
+        sol::table positions(lua, sol::create);
+        std::size_t index = 1;
+        for (const osg::Vec3f& position : generatePositions(state.range(0)))
+            positions[index++] = position;
+        const sol::protected_function query = lua.safe_script(R"X(
+            return function(positions, center, radius)
+                local result = {}
+                for i, p in ipairs(positions) do
+                    if (p - center):length() <= radius then
+                        result[#result + 1] = i
+                    end
+                end
+                return result
+            end
+        )X");
+        std::size_t i = 0;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(query(positions, getQueryCenter(i++), queryRadius));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void gridFindInRadius(benchmark::State& state)
+    {
+        Misc::SpatialGrid<std::size_t> grid(gridCellSize);
+        std::size_t index = 0;
+        for (const osg::Vec3f& position : generatePositions(state.range(0)))
+            grid.insert(index++, position);
+        std::vector<std::size_t> result;
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            result.clear();
+            grid.findInRadius(getQueryCenter(i++), queryRadius,
+                [&](std::size_t id, const osg::Vec3f& /*position*/) { result.push_back(id); });
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void gridFindNearest(benchmark::State& state)
+    {
+        Misc::SpatialGrid<std::size_t> grid(gridCellSize);
+        std::size_t index = 0;
+        for (const osg::Vec3f& position : generatePositions(state.range(0)))
+            grid.insert(index++, position);
+        std::size_t i = 0;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(grid.findNearest(getQueryCenter(i++), 8, queryRadius));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Cost of keeping the grid up to date when all objects move a bit every frame
+    void gridUpdate(benchmark::State& state)
+    {
+        Misc::SpatialGrid<std::size_t> grid(gridCellSize);
+        std::vector<osg::Vec3f> positions = generatePositions(state.range(0));
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            grid.insert(i, positions[i]);
+        const osg::Vec3f shift(10, 10, 0);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                positions[i] += shift;
+                grid.update(i, positions[i]);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(luaFilterInRadius)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(gridFindInRadius)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(gridFindNearest)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(gridUpdate)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
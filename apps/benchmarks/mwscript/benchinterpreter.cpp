@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <components/testing/mwscript.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace TestingOpenMW;
+
+    const std::string sLoopScript = R"mwscript(Begin loop
+
+short i
+long sum
+float f
+
+set i to 0
+set sum to 0
+while ( i < 100 )
+    set sum to ( sum + i * 2 )
+    set f to ( f + 0.5 )
+    if ( sum > 1000 )
+        set sum to ( sum - 1000 )
+    endif
+    set i to ( i + 1 )
+endwhile
+
+End)mwscript";
+
+    Interpreter::Program compile(const std::string& scriptBody)
+    {
+        TestErrorHandler errorHandler;
+        TestCompilerContext compilerContext;
+        Compiler::FileParser parser(errorHandler, compilerContext);
+        std::istringstream input(scriptBody);
+        Compiler::Scanner scanner(errorHandler, input, compilerContext.getExtensions());
+        scanner.scan(parser);
+        if (!errorHandler.isGood())
+            throw std::runtime_error("Failed to compile benchmark script");
+        return parser.getProgram();
+    }
+
+    const std::string& getScript(std::int64_t index)
+    {
+        static const std::vector<std::string> scripts{ sMathScript, sLoopScript };
+        return scripts.at(static_cast<std::size_t>(index));
+    }
+
+    void runProgram(benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::Program program = compile(getScript(state.range(0)));
+        TestInterpreterContext context;
+        context.setLocalShort(0, 42);
+        for (auto _ : state)
+        {
+            interpreter.run(program, context);
+            benchmark::DoNotOptimize(context.getLocalShort(0));
+        }
+    }
+
+    void runDecodedProgram(benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::Program program = compile(getScript(state.range(0)));
+        const Interpreter::DecodedProgram decoded = interpreter.decode(program);
+        TestInterpreterContext context;
+        context.setLocalShort(0, 42);
+        for (auto _ : state)
+        {
+            interpreter.run(program, decoded, context);
+            benchmark::DoNotOptimize(context.getLocalShort(0));
+        }
+    }
+
+    void decodeProgram(benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::Program program = compile(getScript(state.range(0)));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(interpreter.decode(program));
+    }
+}
+
+BENCHMARK(runProgram)->Arg(0)->Arg(1);
+BENCHMARK(runDecodedProgram)->Arg(0)->Arg(1);
+BENCHMARK(decodeProgram)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
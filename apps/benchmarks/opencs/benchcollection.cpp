@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/opencs/model/world/collection.hpp"
+
+#include "components/esm3/loadglob.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Uses generated global records instead of content files to run without game data. Numbers are only comparable
+// between builds of this benchmark and do not show the time to load or save a real content file.
+namespace
+{
+    std::vector<ESM::RefId> generateIds(std::size_t count)
+    {
+        std::vector<ESM::RefId> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(ESM::RefId::stringRefId("global" + std::to_string(i)));
+        return result;
+    }
+
+    std::unique_ptr<CSMWorld::Record<ESM::Global>> makeRecord(ESM::RefId id, CSMWorld::RecordBase::State state)
+    {
+        auto record = std::make_unique<CSMWorld::Record<ESM::Global>>();
+        record->mState = state;
+        record->mBase.blank();
+        record->mBase.mId = id;
+        return record;
+    }
+
+    void fill(CSMWorld::Collection<ESM::Global>& collection, const std::vector<ESM::RefId>& ids)
+    {
+        for (const ESM::RefId& id : ids)
+            collection.appendRecord(makeRecord(id, CSMWorld::RecordBase::State_BaseOnly));
+    }
+
+    // Same as loading a content file with new records
+    void appendRecord(benchmark::State& state)
+    {
+        const std::vector<ESM::RefId> ids = generateIds(state.range(0));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            CSMWorld::Collection<ESM::Global> collection;
+            fill(collection, ids);
+            benchmark::DoNotOptimize(collection.getSize());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Same as adding records in the middle of a collection like dialogue infos of a topic
+    void insertRecord(benchmark::State& state)
+    {
+        constexpr std::size_t insertCount = 256;
+        const std::vector<ESM::RefId> ids = generateIds(state.range(0) + insertCount);
+        const std::vector<ESM::RefId> baseIds(ids.begin(), ids.begin() + state.range(0));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            CSMWorld::Collection<ESM::Global> collection;
+            fill(collection, baseIds);
+            state.ResumeTiming();
+            for (std::size_t i = 0; i < insertCount; ++i)
+                collection.insertRecord(makeRecord(ids[state.range(0) + i], CSMWorld::RecordBase::State_ModifiedOnly),
+                    collection.getSize() / 2);
+            benchmark::DoNotOptimize(collection.getSize());
+        }
+        state.SetItemsProcessed(state.iterations() * insertCount);
+    }
+
+    // Same as saving a document where every other record is deleted
+    void merge(benchmark::State& state)
+    {
+        const std::vector<ESM::RefId> ids = generateIds(state.range(0));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            CSMWorld::Collection<ESM::Global> collection;
+            for (std::size_t i = 0; i < ids.size(); ++i)
+                collection.appendRecord(makeRecord(
+                    ids[i], i % 2 == 0 ? CSMWorld::RecordBase::State_Deleted : CSMWorld::RecordBase::State_BaseOnly));
+            state.ResumeTiming();
+            collection.merge();
+            benchmark::DoNotOptimize(collection.getSize());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void searchId(benchmark::State& state)
+    {
+        const std::vector<ESM::RefId> ids = generateIds(state.range(0));
+        CSMWorld::Collection<ESM::Global> collection;
+        fill(collection, ids);
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, ids.size() - 1);
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(collection.searchId(ids[distribution(random)]));
+    }
+}
+
+BENCHMARK(appendRecord)->RangeMultiplier(8)->Range(1024, 64 * 1024);
+BENCHMARK(insertRecord)->RangeMultiplier(8)->Range(1024, 64 * 1024);
+BENCHMARK(merge)->RangeMultiplier(8)->Range(1024, 64 * 1024);
+BENCHMARK(searchId)->RangeMultiplier(8)->Range(1024, 64 * 1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/opencs/model/tools/searchindex.hpp"
+#include "apps/opencs/model/world/columnbase.hpp"
+#include "apps/opencs/model/world/idtablebase.hpp"
+#include "apps/opencs/model/world/universalid.hpp"
+
+#include <QString>
+#include <QVariant>
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Read-only table with an ID and a text column like the ones searched by the editor
+    class Table final : public CSMWorld::IdTableBase
+    {
+    public:
+        std::vector<std::array<QString, 2>> mRows;
+
+        explicit Table(std::size_t rows)
+            : IdTableBase(0)
+        {
+            constexpr std::array words{ "iron", "steel", "glass", "ebony", "daedric", "silver", "sword", "dagger",
+                "armor", "shield", "helm", "boots", "of", "the", "fire", "frost", "shock", "poison", "ring", "amulet" };
+            std::minstd_rand random;
+            std::uniform_int_distribution<std::size_t> distribution(0, words.size() - 1);
+            mRows.reserve(rows);
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                QString text;
+                for (int j = 0; j < 4; ++j)
+                    text += QString(words[distribution(random)]) + ' ';
+                mRows.push_back({ QString("record_%1").arg(i), text });
+            }
+        }
+
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override
+        {
+            if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+                return QModelIndex();
+            return createIndex(row, column);
+        }
+
+        QModelIndex parent(const QModelIndex& /*index*/) const override { return QModelIndex(); }
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return parent.isValid() ? 0 : static_cast<int>(mRows.size());
+        }
+
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override { return parent.isValid() ? 0 : 2; }
+
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+        {
+            if (!index.isValid() || role != Qt::DisplayRole)
+                return QVariant();
+            return mRows[index.row()][index.column()];
+        }
+
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+        {
+            if (orientation != Qt::Horizontal || role != CSMWorld::ColumnBase::Role_Display)
+                return QVariant();
+            return static_cast<int>(
+                section == 0 ? CSMWorld::ColumnBase::Display_Id : CSMWorld::ColumnBase::Display_String);
+        }
+
+        QModelIndex getModelIndex(const std::string& /*id*/, int /*column*/) const override { return QModelIndex(); }
+
+        int searchColumnIndex(CSMWorld::Columns::ColumnId /*id*/) const override { return -1; }
+
+        int findColumnIndex(CSMWorld::Columns::ColumnId /*id*/) const override
+        {
+            throw std::logic_error("Not implemented");
+        }
+
+        std::pair<CSMWorld::UniversalId, std::string> view(int /*row*/) const override
+        {
+            return std::make_pair(CSMWorld::UniversalId::Type_None, "");
+        }
+
+        bool isDeleted(const std::string& /*id*/) const override { return false; }
+
+        int getColumnId(int /*column*/) const override { return -1; }
+    };
+
+    const QString text = "frost sword";
+
+    // Same as searching without the index, reading every indexed cell through the model
+    void scanRows(benchmark::State& state)
+    {
+        const Table table(state.range(0));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            std::vector<int> rows;
+            for (int row = 0; row < table.rowCount(); ++row)
+                for (int column = 0; column < table.columnCount(); ++column)
+                    if (table.data(table.index(row, column)).toString().contains(text, Qt::CaseInsensitive))
+                    {
+                        rows.push_back(row);
+                        break;
+                    }
+            benchmark::DoNotOptimize(rows);
+        }
+    }
+
+    // Provides only candidates, the search still checks their cells
+    void findRows(benchmark::State& state)
+    {
+        const Table table(state.range(0));
+        CSMTools::SearchIndex index(&table);
+        index.findRows(text);
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(index.findRows(text));
+    }
+
+    // First search of a table builds the index
+    void buildIndex(benchmark::State& state)
+    {
+        const Table table(state.range(0));
+        for ([[maybe_unused]] auto _ : state)
+        {
+            CSMTools::SearchIndex index(&table);
+            benchmark::DoNotOptimize(index.findRows(text));
+        }
+    }
+}
+
+BENCHMARK(scanRows)->RangeMultiplier(8)->Range(1024, 64 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(findRows)->RangeMultiplier(8)->Range(1024, 64 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(buildIndex)->RangeMultiplier(8)->Range(1024, 64 * 1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
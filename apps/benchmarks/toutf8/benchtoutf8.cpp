@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "components/toutf8/toutf8.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Sizes are close to Morrowind.esm: most of the strings are short ASCII IDs and names, books are long and
+    // contain a few non-ASCII characters like quotation marks
+    constexpr std::size_t shortStringsCount = 64 * 1024;
+    constexpr std::size_t booksCount = 256;
+    constexpr std::size_t bookSize = 4 * 1024;
+
+    template <class Random>
+    char generateAsciiChar(Random& random)
+    {
+        std::uniform_int_distribution<int> distribution(' ', '~');
+        return static_cast<char>(distribution(random));
+    }
+
+    template <class Random>
+    std::vector<std::string> generateShortStrings(Random& random)
+    {
+        std::uniform_int_distribution<std::size_t> size(4, 32);
+        std::vector<std::string> result(shortStringsCount);
+        for (std::string& value : result)
+        {
+            value.resize(size(random));
+            for (char& c : value)
+                c = generateAsciiChar(random);
+        }
+        return result;
+    }
+
+    template <class Random>
+    std::vector<std::string> generateBooks(Random& random, int highBytesPercent)
+    {
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> highByte(0xC0, 0xFF);
+        std::vector<std::string> result(booksCount);
+        for (std::string& value : result)
+        {
+            value.resize(bookSize);
+            for (char& c : value)
+                c = percent(random) < highBytesPercent ? static_cast<char>(highByte(random))
+                                                       : generateAsciiChar(random);
+        }
+        return result;
+    }
+
+    void getUtf8(benchmark::State& state, ToUTF8::FromType encoding, const std::vector<std::string>& corpus)
+    {
+        const ToUTF8::StatelessUtf8Encoder encoder(encoding);
+        std::string buffer;
+        std::size_t bytes = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (const std::string& value : corpus)
+            {
+                benchmark::DoNotOptimize(
+                    encoder.getUtf8(value, ToUTF8::BufferAllocationPolicy::UseGrowFactor, buffer));
+                bytes += value.size();
+            }
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+    }
+
+    void getUtf8ShortAscii(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        getUtf8(state, ToUTF8::WINDOWS_1252, generateShortStrings(random));
+    }
+
+    void getUtf8MostlyAsciiBooks(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        getUtf8(state, ToUTF8::WINDOWS_1252, generateBooks(random, 1));
+    }
+
+    void getUtf8CyrillicBooks(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        getUtf8(state, ToUTF8::WINDOWS_1251, generateBooks(random, 80));
+    }
+}
+
+BENCHMARK(getUtf8ShortAscii);
+BENCHMARK(getUtf8MostlyAsciiBooks);
+BENCHMARK(getUtf8CyrillicBooks);
+
+BENCHMARK_MAIN();
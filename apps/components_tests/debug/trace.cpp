@@ -0,0 +1,119 @@
+#include <components/debug/trace.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug::Trace;
+
+    struct DebugTraceTest : Test
+    {
+        DebugTraceTest() { clear(); }
+
+        ~DebugTraceTest() override
+        {
+            setEnabled(false);
+            clear();
+        }
+
+        static std::string writeToString()
+        {
+            std::ostringstream stream;
+            write(stream);
+            return stream.str();
+        }
+    };
+
+    TEST_F(DebugTraceTest, disabledShouldNotCaptureEvents)
+    {
+        {
+            const Scope scope("disabled");
+        }
+        EXPECT_THAT(writeToString(), Not(HasSubstr("disabled")));
+    }
+
+    TEST_F(DebugTraceTest, shouldWriteCompleteEvent)
+    {
+        setEnabled(true);
+        {
+            const Scope scope("enabled");
+        }
+        EXPECT_THAT(writeToString(), HasSubstr(R"({"name":"enabled","ph":"X","pid":1,"tid":)"));
+    }
+
+    TEST_F(DebugTraceTest, shouldWriteEventsFromOtherThreadsWithThreadName)
+    {
+        setEnabled(true);
+        std::thread([] {
+            setThreadName("worker \"1\"");
+            const Scope scope("work");
+        }).join();
+        const std::string result = writeToString();
+        EXPECT_THAT(result, HasSubstr(R"("args":{"name":"worker \"1\""})"));
+        EXPECT_THAT(result, HasSubstr(R"({"name":"work","ph":"X")"));
+    }
+
+    TEST_F(DebugTraceTest, shouldWriteNameOfThreadWithoutEvents)
+    {
+        std::thread([] { setThreadName("idle"); }).join();
+        EXPECT_THAT(writeToString(), HasSubstr(R"("args":{"name":"idle"})"));
+    }
+
+    TEST_F(DebugTraceTest, clearShouldDiscardEvents)
+    {
+        setEnabled(true);
+        {
+            const Scope scope("cleared");
+        }
+        clear();
+        EXPECT_THAT(writeToString(), Not(HasSubstr("cleared")));
+    }
+
+    TEST_F(DebugTraceTest, shouldKeepOnlyLastEventsWhenBufferIsFull)
+    {
+        setEnabled(true);
+        for (int i = 0; i < (1 << 16) + 1; ++i)
+            const Scope scope(i == 0 ? "first" : "next");
+        const std::string result = writeToString();
+        EXPECT_THAT(result, Not(HasSubstr("first")));
+        EXPECT_THAT(result, HasSubstr("next"));
+    }
+
+    TEST_F(DebugTraceTest, writeShouldProvideOnlyConsistentEventsWhileThreadAddsThem)
+    {
+        setEnabled(true);
+        std::atomic_bool stop{ false };
+        std::atomic_size_t added{ 0 };
+        std::thread thread([&] {
+            const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            // Duration of each event is defined by its name
+            for (std::size_t i = 0; !stop; ++i, ++added)
+                Detail::addEvent(i % 2 == 0 ? "short" : "long", begin,
+                    begin + (i % 2 == 0 ? std::chrono::milliseconds(1) : std::chrono::milliseconds(2)));
+        });
+        // Make the buffer full, so the oldest events are overwritten while they are written
+        while (added < (1 << 16))
+            std::this_thread::yield();
+        const std::regex event(R"re(\{"name":"(short|long)","ph":"X"[^}]*"dur":([0-9.]+)\})re");
+        std::size_t count = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            const std::string result = writeToString();
+            for (auto it = std::sregex_iterator(result.begin(), result.end(), event); it != std::sregex_iterator();
+                 ++it, ++count)
+                EXPECT_EQ((*it)[2], (*it)[1] == "short" ? "1000.000" : "2000.000");
+        }
+        stop = true;
+        thread.join();
+        EXPECT_GT(count, 0);
+    }
+}
@@ -156,6 +156,39 @@ namespace
         EXPECT_EQ(tile->mVersion, navMeshFormatVersion);
     }
 
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_for_multiple_agents_should_write_tile_for_each_agent_to_db)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        addHeightFieldPlane(mRecastMeshManager);
+        addObject(mBox, mRecastMeshManager);
+        auto db = std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max());
+        NavMeshDb* const dbPtr = db.get();
+        AsyncNavMeshUpdater updater(mSettings, mRecastMeshManager, mOffMeshConnectionsManager, std::move(db));
+        const AgentBounds otherAgentBounds{ CollisionShapeType::Aabb, { 40, 40, 80 } };
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(1, mSettings);
+        const auto otherNavMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(2, mSettings);
+        const TilePosition tilePosition{ 0, 0 };
+        const std::map<TilePosition, ChangeType> changedTiles{ { tilePosition, ChangeType::add } };
+        updater.post(mAgentBounds, navMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.post(otherAgentBounds, otherNavMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.wait(WaitConditionType::allJobsDone, &mListener);
+        updater.stop();
+        EXPECT_NE(navMeshCacheItem->lockConst()->getImpl().getTileRefAt(0, 0, 0), 0u);
+        EXPECT_NE(otherNavMeshCacheItem->lockConst()->getImpl().getTileRefAt(0, 0, 0), 0u);
+        const auto recastMesh = mRecastMeshManager.getMesh(mWorldspace, tilePosition);
+        ASSERT_NE(recastMesh, nullptr);
+        ShapeId nextShapeId{ 1 };
+        const std::vector<DbRefGeometryObject> objects = makeDbRefGeometryObjects(recastMesh->getMeshSources(),
+            [&](const MeshSource& v) { return resolveMeshSource(*dbPtr, v, nextShapeId); });
+        for (const AgentBounds& agentBounds : { mAgentBounds, otherAgentBounds })
+        {
+            const auto tile = dbPtr->findTile(
+                mWorldspace, tilePosition, serialize(mSettings.mRecast, agentBounds, *recastMesh, objects));
+            ASSERT_TRUE(tile.has_value());
+            EXPECT_EQ(tile->mVersion, navMeshFormatVersion);
+        }
+    }
+
     TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_when_writing_to_db_disabled_should_not_write_tiles)
     {
         mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
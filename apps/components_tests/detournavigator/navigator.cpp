@@ -5,6 +5,7 @@
 #include <components/detournavigator/navigatorimpl.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/pathqueryservice.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
@@ -26,7 +27,9 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <vector>
 
 MATCHER_P3(Vec3fEq, x, y, z, "")
 {
@@ -182,6 +185,72 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, path_query_service_should_pass_path_to_callback_on_update)
+    {
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        PathQueryService service(*mNavigator, 2);
+        std::optional<PathQueryResult> result;
+        service.enqueue(
+            PathQuery{
+                .mAgentBounds = mAgentBounds,
+                .mStart = mStart,
+                .mEnd = mEnd,
+                .mIncludeFlags = Flag_walk,
+                .mAreaCosts = mAreaCosts,
+                .mEndTolerance = mEndTolerance,
+                .mCheckpoints = {},
+            },
+            [&](PathQueryResult&& value) { result = std::move(value); });
+        service.wait();
+
+        EXPECT_FALSE(result.has_value());
+
+        service.update();
+
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mStatus, Status::Success);
+        EXPECT_THAT(result->mPath,
+            ElementsAre( //
+                Vec3fEq(56.66664886474609375, 460, 1.99999392032623291015625),
+                Vec3fEq(460, 56.66664886474609375, 1.99999392032623291015625)));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, path_query_service_should_return_nav_mesh_not_found_for_unknown_agent)
+    {
+        PathQueryService service(*mNavigator, 1);
+        std::vector<PathQueryResult> results;
+        for (int i = 0; i < 3; ++i)
+            service.enqueue(
+                PathQuery{
+                    .mAgentBounds = mAgentBounds,
+                    .mStart = mStart,
+                    .mEnd = mEnd,
+                    .mIncludeFlags = Flag_walk,
+                    .mAreaCosts = mAreaCosts,
+                    .mEndTolerance = mEndTolerance,
+                    .mCheckpoints = {},
+                },
+                [&](PathQueryResult&& value) { results.push_back(std::move(value)); });
+        service.wait();
+        service.update();
+
+        ASSERT_EQ(results.size(), 3u);
+        for (const PathQueryResult& result : results)
+        {
+            EXPECT_EQ(result.mStatus, Status::NavMeshNotFound);
+            EXPECT_THAT(result.mPath, IsEmpty());
+        }
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, find_path_to_the_start_position_should_contain_single_point)
     {
         const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
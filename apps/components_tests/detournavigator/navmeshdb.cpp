@@ -1,12 +1,18 @@
 #include "generate.hpp"
 
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/misc/compression.hpp>
+#include <components/sqlite3/db.hpp>
+#include <components/testing/util.hpp>
 
 #include <DetourAlloc.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <sqlite3.h>
+
+#include <filesystem>
 #include <limits>
 #include <random>
 
@@ -96,6 +102,18 @@ namespace
         EXPECT_THROW(mDb.insertTile(tileId, worldspace, tilePosition, version, input, data), std::runtime_error);
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, on_inserted_tile_with_same_input_at_same_position_should_throw_exception)
+    {
+        const TileVersion version{ 1 };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        ASSERT_EQ(mDb.insertTile(TileId{ 53 }, worldspace, tilePosition, version, input, data), 1);
+        EXPECT_THROW(
+            mDb.insertTile(TileId{ 54 }, worldspace, tilePosition, version, input, data), std::runtime_error);
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, inserted_duplicate_leaves_db_in_correct_state)
     {
         const TileId tileId{ 53 };
@@ -176,4 +194,101 @@ namespace
         };
         EXPECT_THROW(f(), std::runtime_error);
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, should_find_tiles_inserted_with_previous_schema_version)
+    {
+        constexpr const char previousSchema[] = R"(
+            CREATE TABLE tiles (
+                tile_id INTEGER PRIMARY KEY,
+                revision INTEGER NOT NULL DEFAULT 1,
+                worldspace TEXT NOT NULL,
+                tile_position_x INTEGER NOT NULL,
+                tile_position_y INTEGER NOT NULL,
+                version INTEGER NOT NULL,
+                input BLOB,
+                data BLOB
+            );
+
+            CREATE UNIQUE INDEX index_unique_tiles_by_worldspace_and_tile_position_and_input
+                ON tiles (worldspace, tile_position_x, tile_position_y, input);
+        )";
+
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("navmesh_previous_schema.db");
+        std::filesystem::remove(path);
+
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+
+        {
+            const Sqlite3::Db db = Sqlite3::makeDb(path.string(), previousSchema);
+            sqlite3_stmt* statement = nullptr;
+            ASSERT_EQ(sqlite3_prepare_v2(db.get(),
+                          "INSERT INTO tiles (tile_id, worldspace, version, tile_position_x, tile_position_y, input, "
+                          "data) VALUES (42, 'sys::default', 1, 3, 4, ?, ?)",
+                          -1, &statement, nullptr),
+                SQLITE_OK);
+            const std::vector<std::byte> compressedInput = Misc::compress(input);
+            const std::vector<std::byte> compressedData = Misc::compress(data);
+            sqlite3_bind_blob(
+                statement, 1, compressedInput.data(), static_cast<int>(compressedInput.size()), SQLITE_STATIC);
+            sqlite3_bind_blob(
+                statement, 2, compressedData.data(), static_cast<int>(compressedData.size()), SQLITE_STATIC);
+            EXPECT_EQ(sqlite3_step(statement), SQLITE_DONE);
+            sqlite3_finalize(statement);
+        }
+
+        NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const auto tile = db.getTileData(worldspace, TilePosition{ 3, 4 }, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, TileId{ 42 });
+        EXPECT_EQ(tile->mVersion, TileVersion{ 1 });
+        EXPECT_EQ(tile->mData, data);
+        EXPECT_FALSE(db.findTile(worldspace, TilePosition{ 3, 4 }, generateData()).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, should_not_find_tile_with_other_input_at_same_position)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        EXPECT_FALSE(mDb.findTile(worldspace, tilePosition, generateData()).has_value());
+        EXPECT_FALSE(mDb.getTileData(worldspace, tilePosition, generateData()).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, insert_tile_should_replace_tile_with_same_input_hash_and_other_input)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("navmesh_input_hash_collision.db");
+        std::filesystem::remove(path);
+
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+
+        {
+            NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+            ASSERT_EQ(db.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+        }
+
+        // Simulate a hash collision: the stored tile keeps the input hash but has another input
+        {
+            const Sqlite3::Db db = Sqlite3::makeDb(path.string(), "");
+            sqlite3_stmt* statement = nullptr;
+            ASSERT_EQ(sqlite3_prepare_v2(db.get(), "UPDATE tiles SET input = ? WHERE tile_id = 1", -1, &statement,
+                          nullptr),
+                SQLITE_OK);
+            const std::vector<std::byte> otherInput = Misc::compress(generateData());
+            sqlite3_bind_blob(statement, 1, otherInput.data(), static_cast<int>(otherInput.size()), SQLITE_STATIC);
+            EXPECT_EQ(sqlite3_step(statement), SQLITE_DONE);
+            sqlite3_finalize(statement);
+        }
+
+        NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+        EXPECT_FALSE(db.findTile(worldspace, tilePosition, input).has_value());
+        EXPECT_EQ(db.insertTile(TileId{ 2 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+        EXPECT_EQ(db.getInputHashCollisions(), 1);
+        const auto tile = db.findTile(worldspace, tilePosition, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, TileId{ 2 });
+        EXPECT_EQ(db.getMaxTileId(), TileId{ 2 });
+    }
 }
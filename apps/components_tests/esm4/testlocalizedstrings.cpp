@@ -0,0 +1,94 @@
+#include <components/esm4/localizedstrings.hpp>
+#include <components/platform/file.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM4;
+
+    void appendUint32(std::string& content, std::uint32_t value)
+    {
+        content.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // Entries are pairs of string id and string value
+    std::string makeFile(LocalizedStringType type, const std::vector<std::pair<std::uint32_t, std::string>>& entries)
+    {
+        std::string data;
+        std::string directory;
+        for (const auto& [id, value] : entries)
+        {
+            appendUint32(directory, id);
+            appendUint32(directory, static_cast<std::uint32_t>(data.size()));
+            if (type != LocalizedStringType::Strings)
+                appendUint32(data, static_cast<std::uint32_t>(value.size() + 1));
+            data += value;
+            data += '\0';
+        }
+        std::string result;
+        appendUint32(result, static_cast<std::uint32_t>(entries.size()));
+        appendUint32(result, static_cast<std::uint32_t>(data.size()));
+        return result + directory + data;
+    }
+
+    TEST(ESM4LocalizedStringsTest, findShouldReturnZeroTerminatedString)
+    {
+        std::istringstream stream(makeFile(LocalizedStringType::Strings, { { 3, "foo" }, { 1, "bar" } }));
+        const LocalizedStrings strings(LocalizedStringType::Strings, stream);
+        EXPECT_EQ(strings.getSize(), 2);
+        EXPECT_EQ(strings.find(1), "bar");
+        EXPECT_EQ(strings.find(3), "foo");
+        EXPECT_EQ(strings.find(2), std::nullopt);
+    }
+
+    TEST(ESM4LocalizedStringsTest, findShouldReturnStringWithSizePrefix)
+    {
+        std::istringstream stream(makeFile(LocalizedStringType::DLStrings, { { 42, "foo" }, { 13, "" } }));
+        const LocalizedStrings strings(LocalizedStringType::DLStrings, stream);
+        EXPECT_EQ(strings.find(42), "foo");
+        EXPECT_EQ(strings.find(13), "");
+    }
+
+    TEST(ESM4LocalizedStringsTest, shouldThrowExceptionForTruncatedFile)
+    {
+        std::string content = makeFile(LocalizedStringType::Strings, { { 1, "foo" } });
+        content.resize(content.size() - 5);
+        std::istringstream stream(content);
+        EXPECT_THROW(LocalizedStrings(LocalizedStringType::Strings, stream), std::runtime_error);
+    }
+
+    TEST(ESM4LocalizedStringsTest, findShouldThrowExceptionForStringOutOfBounds)
+    {
+        std::string content = makeFile(LocalizedStringType::ILStrings, { { 1, "foo" } });
+        // Replace size of the string
+        const std::uint32_t size = 100;
+        content.replace(content.size() - 4 - sizeof(size), sizeof(size), reinterpret_cast<const char*>(&size),
+            sizeof(size));
+        std::istringstream stream(content);
+        const LocalizedStrings strings(LocalizedStringType::ILStrings, stream);
+        EXPECT_THROW(strings.find(1), std::runtime_error);
+    }
+
+    TEST(ESM4LocalizedStringsTest, shouldSupportMappedFile)
+    {
+        const auto path = TestingOpenMW::outputFilePath("ESM4LocalizedStringsTest_En.STRINGS");
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << makeFile(LocalizedStringType::Strings, { { 7, "mapped" } });
+        }
+        const LocalizedStrings strings(LocalizedStringType::Strings, Platform::File::ScopedMapping(path));
+        EXPECT_EQ(strings.find(7), "mapped");
+    }
+}
@@ -0,0 +1,143 @@
+#include <components/bsa/memorystream.hpp>
+#include <components/esm4/common.hpp>
+#include <components/esm4/readahead.hpp>
+#include <components/esm4/reader.hpp>
+
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM4;
+
+    constexpr std::uint32_t recordType = fourCC("NPC_");
+    constexpr std::uint32_t otherRecordType = fourCC("STAT");
+
+    struct Record
+    {
+        std::streamoff mDataPosition;
+        std::string mData;
+    };
+
+    struct File
+    {
+        std::string mContent;
+        std::vector<Record> mRecords;
+
+        void addGroup()
+        {
+            RecordHeader header{};
+            header.group.typeId = REC_GRUP;
+            header.group.groupSize = sizeof(RecordHeader);
+            mContent.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        void addRecord(std::uint32_t typeId, const std::string& data)
+        {
+            uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
+            std::string compressed(compressedSize, '\0');
+            if (compress(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                    reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()))
+                != Z_OK)
+                throw std::runtime_error("Failed to compress test data");
+            compressed.resize(compressedSize);
+            addCompressedRecord(typeId, static_cast<std::uint32_t>(data.size()), compressed);
+            mRecords.back().mData = data;
+        }
+
+        void addCompressedRecord(std::uint32_t typeId, std::uint32_t uncompressedSize, const std::string& compressed)
+        {
+            RecordHeader header{};
+            header.record.typeId = typeId;
+            header.record.dataSize = static_cast<std::uint32_t>(sizeof(std::uint32_t) + compressed.size());
+            header.record.flags = Rec_Compressed;
+            mContent.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            mContent.append(reinterpret_cast<const char*>(&uncompressedSize), sizeof(uncompressedSize));
+            mRecords.push_back(Record{ .mDataPosition = static_cast<std::streamoff>(mContent.size()), .mData = {} });
+            mContent.append(compressed);
+        }
+    };
+
+    std::string toString(Bsa::MemoryInputStream& stream)
+    {
+        return std::string(std::istreambuf_iterator<char>(stream), {});
+    }
+
+    TEST(ESM4ReadAheadTest, shouldReadAheadRecordsOfLoadedTypes)
+    {
+        File file;
+        file.addGroup();
+        for (int i = 0; i < 4; ++i)
+            file.addRecord(recordType, "record " + std::to_string(i) + std::string(1000, 'a' + i));
+        std::istringstream stream(file.mContent);
+        ReadAhead readAhead(2);
+
+        EXPECT_EQ(readAhead.take(recordType, file.mRecords[0].mDataPosition), nullptr);
+        stream.seekg(file.mRecords[1].mDataPosition - sizeof(std::uint32_t) - sizeof(RecordHeader));
+        readAhead.read(stream, sizeof(RecordHeader), static_cast<std::streamoff>(file.mContent.size()));
+        EXPECT_EQ(stream.tellg(), file.mRecords[1].mDataPosition - sizeof(std::uint32_t) - sizeof(RecordHeader));
+        EXPECT_EQ(readAhead.getPendingCount(), 3);
+
+        for (std::size_t i = 1; i < file.mRecords.size(); ++i)
+        {
+            const auto result = readAhead.take(recordType, file.mRecords[i].mDataPosition);
+            ASSERT_NE(result, nullptr);
+            EXPECT_EQ(toString(*result), file.mRecords[i].mData);
+        }
+    }
+
+    TEST(ESM4ReadAheadTest, shouldNotReadAheadRecordsOfOtherTypes)
+    {
+        File file;
+        file.addRecord(recordType, "loaded");
+        file.addRecord(otherRecordType, "skipped");
+        file.addRecord(recordType, "next");
+        std::istringstream stream(file.mContent);
+        ReadAhead readAhead(1);
+
+        EXPECT_EQ(readAhead.take(recordType, file.mRecords[0].mDataPosition), nullptr);
+        stream.seekg(file.mRecords[1].mDataPosition - sizeof(std::uint32_t) - sizeof(RecordHeader));
+        readAhead.read(stream, sizeof(RecordHeader), static_cast<std::streamoff>(file.mContent.size()));
+        EXPECT_EQ(readAhead.getPendingCount(), 1);
+        EXPECT_EQ(readAhead.take(otherRecordType, file.mRecords[1].mDataPosition), nullptr);
+        const auto result = readAhead.take(recordType, file.mRecords[2].mDataPosition);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(toString(*result), "next");
+    }
+
+    TEST(ESM4ReadAheadTest, takeShouldRethrowDecompressionError)
+    {
+        File file;
+        file.addRecord(recordType, "loaded");
+        file.addCompressedRecord(recordType, 16, "not zlib data");
+        std::istringstream stream(file.mContent);
+        ReadAhead readAhead(1);
+
+        EXPECT_EQ(readAhead.take(recordType, file.mRecords[0].mDataPosition), nullptr);
+        stream.seekg(file.mRecords[1].mDataPosition - sizeof(std::uint32_t) - sizeof(RecordHeader));
+        readAhead.read(stream, sizeof(RecordHeader), static_cast<std::streamoff>(file.mContent.size()));
+        EXPECT_THROW(readAhead.take(recordType, file.mRecords[1].mDataPosition), std::runtime_error);
+    }
+
+    TEST(ESM4ReadAheadTest, withoutThreadsShouldNotReadAhead)
+    {
+        File file;
+        file.addRecord(recordType, "first");
+        file.addRecord(recordType, "second");
+        std::istringstream stream(file.mContent);
+        ReadAhead readAhead(0);
+
+        EXPECT_EQ(readAhead.take(recordType, file.mRecords[0].mDataPosition), nullptr);
+        stream.seekg(file.mRecords[1].mDataPosition - sizeof(std::uint32_t) - sizeof(RecordHeader));
+        readAhead.read(stream, sizeof(RecordHeader), static_cast<std::streamoff>(file.mContent.size()));
+        EXPECT_EQ(readAhead.getPendingCount(), 0);
+    }
+}
@@ -0,0 +1,101 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/bytecodecache.hpp>
+#include <components/testing/util.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+
+    struct LuaUtilBytecodeCacheTest : Test
+    {
+        const std::filesystem::path mDir = TestingOpenMW::outputDirPath("lua_bytecode_cache");
+        LuaUtil::BytecodeCache mCache{ mDir };
+        const std::filesystem::file_time_type mSourceTime = std::filesystem::file_time_type(std::chrono::hours(1));
+
+        LuaUtilBytecodeCacheTest() { std::filesystem::remove_all(mDir); }
+
+        std::filesystem::path getEntryPath() const
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(mDir))
+                return entry.path();
+            return {};
+        }
+    };
+
+    TEST_F(LuaUtilBytecodeCacheTest, getShouldReturnPutBytecode)
+    {
+        EXPECT_EQ(mCache.get("scripts/a.lua", mSourceTime), std::nullopt);
+        mCache.put("scripts/a.lua", mSourceTime, std::string_view("\x1bLua\0bytecode", 13));
+        EXPECT_THAT(mCache.get("scripts/a.lua", mSourceTime), Optional(std::string("\x1bLua\0bytecode", 13)));
+    }
+
+    TEST_F(LuaUtilBytecodeCacheTest, getShouldIgnoreEntryForChangedSource)
+    {
+        mCache.put("scripts/a.lua", mSourceTime, "bytecode");
+        EXPECT_EQ(mCache.get("scripts/b.lua", mSourceTime), std::nullopt);
+        EXPECT_EQ(mCache.get("scripts/a.lua", mSourceTime + std::chrono::seconds(1)), std::nullopt);
+    }
+
+    TEST_F(LuaUtilBytecodeCacheTest, putShouldReplaceStaleEntry)
+    {
+        const std::filesystem::file_time_type newSourceTime = mSourceTime + std::chrono::seconds(1);
+        mCache.put("scripts/a.lua", mSourceTime, "old");
+        mCache.put("scripts/a.lua", newSourceTime, "new");
+        EXPECT_EQ(mCache.get("scripts/a.lua", mSourceTime), std::nullopt);
+        EXPECT_THAT(mCache.get("scripts/a.lua", newSourceTime), Optional(std::string("new")));
+    }
+
+    TEST_F(LuaUtilBytecodeCacheTest, getShouldRemoveTruncatedEntry)
+    {
+        mCache.put("scripts/a.lua", mSourceTime, "bytecode");
+        const std::filesystem::path path = getEntryPath();
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        EXPECT_EQ(mCache.get("scripts/a.lua", mSourceTime), std::nullopt);
+        EXPECT_FALSE(std::filesystem::exists(path));
+    }
+
+    TEST_F(LuaUtilBytecodeCacheTest, getShouldRemoveEntryWithModifiedBytecode)
+    {
+        mCache.put("scripts/a.lua", mSourceTime, "bytecode");
+        const std::filesystem::path path = getEntryPath();
+        std::string data;
+        {
+            std::ifstream stream(path, std::ios::binary);
+            data.assign(std::istreambuf_iterator<char>(stream), {});
+        }
+        data.back() = 'E';
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream << data;
+        }
+        EXPECT_EQ(mCache.get("scripts/a.lua", mSourceTime), std::nullopt);
+        EXPECT_FALSE(std::filesystem::exists(path));
+    }
+
+    TEST_F(LuaUtilBytecodeCacheTest, removeShouldRemoveEntry)
+    {
+        mCache.put("scripts/a.lua", mSourceTime, "bytecode");
+        mCache.remove("scripts/a.lua");
+        EXPECT_EQ(mCache.get("scripts/a.lua", mSourceTime), std::nullopt);
+    }
+
+    TEST_F(LuaUtilBytecodeCacheTest, shouldCountLoads)
+    {
+        mCache.recordLoad(true, 0.5);
+        mCache.recordLoad(true, 0.25);
+        mCache.recordLoad(false, 2);
+        const LuaUtil::BytecodeCache::Stats stats = mCache.getStats();
+        EXPECT_EQ(stats.mHits, 2);
+        EXPECT_EQ(stats.mMisses, 1);
+        EXPECT_EQ(stats.mHitLoadTime, 0.75);
+        EXPECT_EQ(stats.mMissLoadTime, 2);
+    }
+}
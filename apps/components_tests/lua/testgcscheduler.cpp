@@ -0,0 +1,53 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/gcscheduler.hpp>
+
+#include <sol/sol.hpp>
+
+namespace
+{
+    using namespace testing;
+
+    TEST(LuaUtilFrameTimeStatsTest, ShouldReturnPercentilesOfLastFrames)
+    {
+        LuaUtil::FrameTimeStats stats(100);
+        EXPECT_EQ(stats.getPercentile(0.5), 0);
+        for (int i = 1; i <= 100; ++i)
+            stats.add(1000);
+        for (int i = 1; i <= 100; ++i)
+            stats.add(i);
+        EXPECT_EQ(stats.size(), 100);
+        EXPECT_EQ(stats.getPercentile(0), 1);
+        EXPECT_EQ(stats.getPercentile(0.5), 51);
+        EXPECT_EQ(stats.getPercentile(0.99), 99);
+        EXPECT_EQ(stats.getPercentile(1), 100);
+    }
+
+    TEST(LuaUtilGcSchedulerTest, ShouldCollectGarbageWhenMemoryUsageGrows)
+    {
+        sol::state lua;
+        LuaUtil::GcScheduler scheduler;
+        // Not enough garbage to start a cycle
+        scheduler.update(lua, 1, 0);
+        EXPECT_EQ(scheduler.getCycles(), 0);
+
+        lua.safe_script("local garbage = {} for i = 1, 100000 do garbage[i] = {} end");
+        const std::size_t memoryWithGarbage = lua.memory_used();
+        for (int i = 0; i < 1000 && scheduler.getCycles() == 0; ++i)
+            scheduler.update(lua, 1e-4, 0);
+        EXPECT_EQ(scheduler.getCycles(), 1);
+        EXPECT_LT(lua.memory_used(), memoryWithGarbage / 2);
+        EXPECT_GE(scheduler.getFrameTimeStats().size(), 2);
+    }
+
+    TEST(LuaUtilGcSchedulerTest, ZeroBudgetShouldNotCountCycles)
+    {
+        sol::state lua;
+        LuaUtil::GcScheduler scheduler;
+        scheduler.update(lua, 0, 10);
+        scheduler.update(lua, 0, 0);
+        EXPECT_EQ(scheduler.getCycles(), 0);
+        EXPECT_EQ(scheduler.getFrameTimeStats().size(), 2);
+    }
+}
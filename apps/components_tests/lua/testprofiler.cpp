@@ -0,0 +1,85 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/profiler.hpp>
+
+#include <sol/sol.hpp>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+
+    TEST(LuaUtilProfilerTest, InactiveProfilerShouldNotRecordHandlers)
+    {
+        LuaUtil::Profiler profiler;
+        {
+            const LuaUtil::Profiler::Scope scope(profiler, 0, "onUpdate");
+        }
+        profiler.nextWindow(1);
+        EXPECT_THAT(profiler.getLastWindowStats(), IsEmpty());
+    }
+
+    TEST(LuaUtilProfilerTest, ShouldAggregateHandlerCallsOverWindow)
+    {
+        LuaUtil::Profiler profiler;
+        profiler.setActive(true);
+        for (int i = 0; i < 3; ++i)
+        {
+            const LuaUtil::Profiler::Scope scope(profiler, 1, "onUpdate");
+            profiler.countAllocation();
+        }
+        {
+            const LuaUtil::Profiler::Scope scope(profiler, 2, "someEvent");
+        }
+        EXPECT_THAT(profiler.getLastWindowStats(), IsEmpty());
+
+        profiler.nextWindow(5);
+        EXPECT_EQ(profiler.getLastWindowDuration(), 5);
+        const LuaUtil::Profiler::Stats& stats = profiler.getLastWindowStats();
+        ASSERT_EQ(stats.size(), 2);
+        const LuaUtil::Profiler::HandlerStats& onUpdate = stats.at(1).at("onUpdate");
+        EXPECT_EQ(onUpdate.mCalls, 3);
+        EXPECT_EQ(onUpdate.mAllocations, 3);
+        EXPECT_GE(onUpdate.mTime, 0);
+        EXPECT_EQ(stats.at(2).at("someEvent").mCalls, 1);
+
+        profiler.nextWindow(5);
+        EXPECT_THAT(profiler.getLastWindowStats(), IsEmpty());
+    }
+
+    TEST(LuaUtilProfilerTest, ShouldSampleLuaCallStacks)
+    {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base);
+        LuaUtil::Profiler profiler;
+        profiler.setActive(true);
+        lua["sample"] = [&](sol::this_state state) { profiler.sample(state, 3, nullptr); };
+        lua.safe_script(R"X(
+            function inner() sample() end
+            function outer() inner() end
+            outer()
+            outer()
+        )X");
+
+        std::map<std::string, std::uint64_t> stacks;
+        profiler.collectStacks(stacks);
+        ASSERT_EQ(stacks.size(), 1);
+        const auto& [stack, samples] = *stacks.begin();
+        EXPECT_THAT(stack, StartsWith("script#3;[other];"));
+        EXPECT_THAT(stack, HasSubstr("outer ("));
+        EXPECT_THAT(stack, HasSubstr(";inner ("));
+        EXPECT_LT(stack.find("outer"), stack.find("inner"));
+        EXPECT_EQ(samples, 2);
+
+        std::ostringstream stream;
+        LuaUtil::writeCollapsedStacks(stacks, stream);
+        EXPECT_EQ(stream.str(), stack + " 2\n");
+
+        profiler.setActive(false);
+        stacks.clear();
+        profiler.collectStacks(stacks);
+        EXPECT_THAT(stacks, IsEmpty());
+    }
+}
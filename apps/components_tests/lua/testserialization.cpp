@@ -193,6 +193,38 @@ namespace
         EXPECT_ERROR(lua.safe_script("ro_t.nested.x = 5"), "userdata value");
     }
 
+    TEST(LuaSerializationTest, Copy)
+    {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base);
+        sol::table table(lua, sol::create);
+        table["aa"] = 1;
+        table["ab"] = true;
+        table["ba"] = "It is a string with more than 32 characters...........................";
+        table["bb"] = osg::Vec3f(1, 2, 3);
+        table["t"] = lua.create_table_with("x", 5);
+
+        sol::table res = LuaUtil::copy(table);
+        EXPECT_NE(res.pointer(), table.pointer());
+        EXPECT_EQ(res.get<double>("aa"), 1);
+        EXPECT_EQ(res.get<bool>("ab"), true);
+        EXPECT_EQ(res.get<std::string>("ba"), table.get<std::string>("ba"));
+        EXPECT_EQ(res.get<osg::Vec3f>("bb"), osg::Vec3f(1, 2, 3));
+        sol::table t = res["t"];
+        EXPECT_NE(t.pointer(), table.get<sol::table>("t").pointer());
+        EXPECT_EQ(t.get<double>("x"), 5);
+
+        table.get<sol::table>("t")["x"] = 6;
+        EXPECT_EQ(t.get<double>("x"), 5);
+
+        EXPECT_EQ(LuaUtil::copy(sol::nil), sol::nil);
+        table["f"] = lua["print"];
+        EXPECT_ERROR(LuaUtil::copy(table), "Functions are not allowed to be serialized.");
+        table["f"] = sol::nil;
+        table["loop"] = table;
+        EXPECT_ERROR(LuaUtil::copy(table), "Can not serialize more than 32 nested tables");
+    }
+
     struct TestStruct1
     {
         double a, b;
@@ -276,4 +308,18 @@ namespace
         EXPECT_EQ(ry.b, 3);
     }
 
+    TEST(LuaSerializationTest, CopyUserdata)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        table["x"] = TestStruct1{ 1.5, 2.5 };
+        TestSerializer serializer;
+
+        EXPECT_ERROR(LuaUtil::copy(table), "Value is not serializable.");
+        sol::table res = LuaUtil::copy(table, &serializer);
+        TestStruct1 rx = res.get<TestStruct1>("x");
+        EXPECT_EQ(rx.a, 1.5);
+        EXPECT_EQ(rx.b, 2.5);
+    }
+
 }
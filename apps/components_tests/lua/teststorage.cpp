@@ -84,6 +84,34 @@ namespace
         });
     }
 
+    TEST(LuaUtilStorageTest, ReadOnlyValueShouldBeCreatedInEveryState)
+    {
+        LuaUtil::LuaState luaState1{ nullptr, nullptr };
+        LuaUtil::LuaState luaState2{ nullptr, nullptr };
+        LuaUtil::LuaStorage storage;
+        storage.setActive(true);
+
+        luaState1.protectedCall([&](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            auto& lua = view.sol();
+            lua["mutable"] = storage.getMutableSection(lua, "test");
+            lua.safe_script("mutable:set('x', { y = 'abc' })");
+            EXPECT_EQ(get<std::string>(lua, "mutable:get('x').y"), "abc");
+            lua["mutable"] = sol::nil;
+            lua.collect_garbage();
+        });
+
+        luaState2.protectedCall([&](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            auto& lua = view.sol();
+            lua["ro"] = storage.getReadOnlySection(lua, "test");
+            EXPECT_EQ(get<std::string>(lua, "ro:get('x').y"), "abc");
+            EXPECT_TRUE(get<bool>(lua, "ro:get('x') == ro:get('x')"));
+            lua["ro"] = sol::nil;
+            lua.collect_garbage();
+        });
+    }
+
     TEST(LuaUtilStorageTest, Saving)
     {
         LuaUtil::LuaState luaState{ nullptr, nullptr };
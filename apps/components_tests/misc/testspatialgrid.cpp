@@ -0,0 +1,96 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    struct MiscSpatialGridTest : Test
+    {
+        SpatialGrid<int> mGrid{ 10 };
+
+        std::vector<int> findInRadius(const osg::Vec3f& center, float radius) const
+        {
+            std::vector<int> result;
+            mGrid.findInRadius(center, radius, [&](int id, const osg::Vec3f&) { result.push_back(id); });
+            return result;
+        }
+
+        std::vector<int> findInBox(const osg::Vec3f& min, const osg::Vec3f& max) const
+        {
+            std::vector<int> result;
+            mGrid.findInBox(min, max, [&](int id, const osg::Vec3f&) { result.push_back(id); });
+            return result;
+        }
+    };
+
+    TEST_F(MiscSpatialGridTest, findInRadiusShouldCheckExactDistance)
+    {
+        mGrid.insert(1, osg::Vec3f(0, 0, 0));
+        mGrid.insert(2, osg::Vec3f(3, 4, 0));
+        mGrid.insert(3, osg::Vec3f(4, 4, 0));
+        mGrid.insert(4, osg::Vec3f(0, 0, 6));
+        mGrid.insert(5, osg::Vec3f(-25, -3, 0));
+        EXPECT_THAT(findInRadius(osg::Vec3f(0, 0, 0), 5), UnorderedElementsAre(1, 2));
+        EXPECT_THAT(findInRadius(osg::Vec3f(-20, 0, 0), 6), UnorderedElementsAre(5));
+    }
+
+    TEST_F(MiscSpatialGridTest, findInBoxShouldIncludeBorders)
+    {
+        mGrid.insert(1, osg::Vec3f(0, 0, 0));
+        mGrid.insert(2, osg::Vec3f(15, 15, 15));
+        mGrid.insert(3, osg::Vec3f(16, 15, 15));
+        mGrid.insert(4, osg::Vec3f(5, 5, -1));
+        EXPECT_THAT(findInBox(osg::Vec3f(0, 0, 0), osg::Vec3f(15, 15, 15)), UnorderedElementsAre(1, 2));
+    }
+
+    TEST_F(MiscSpatialGridTest, findInBoxShouldSupportUnboundedBox)
+    {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        mGrid.insert(1, osg::Vec3f(0, 0, 0));
+        mGrid.insert(2, osg::Vec3f(1e6f, -1e6f, 0));
+        EXPECT_THAT(findInBox(osg::Vec3f(-inf, -inf, -inf), osg::Vec3f(inf, inf, inf)), UnorderedElementsAre(1, 2));
+    }
+
+    TEST_F(MiscSpatialGridTest, findNearestShouldReturnPointsOrderedByDistance)
+    {
+        mGrid.insert(1, osg::Vec3f(100, 0, 0));
+        mGrid.insert(2, osg::Vec3f(1, 0, 0));
+        mGrid.insert(3, osg::Vec3f(0, 35, 0));
+        mGrid.insert(4, osg::Vec3f(0, 0, 12));
+        EXPECT_THAT(mGrid.findNearest(osg::Vec3f(0, 0, 0), 3, std::numeric_limits<float>::infinity()),
+            ElementsAre(Pair(2, 1), Pair(4, 12), Pair(3, 35)));
+        EXPECT_THAT(mGrid.findNearest(osg::Vec3f(0, 0, 0), 10, 20), ElementsAre(Pair(2, 1), Pair(4, 12)));
+        EXPECT_THAT(mGrid.findNearest(osg::Vec3f(0, 0, 0), 0, 20), IsEmpty());
+    }
+
+    TEST_F(MiscSpatialGridTest, updateShouldMovePointToAnotherCell)
+    {
+        mGrid.insert(1, osg::Vec3f(0, 0, 0));
+        mGrid.insert(2, osg::Vec3f(1, 1, 0));
+        EXPECT_TRUE(mGrid.update(1, osg::Vec3f(50, 50, 0)));
+        EXPECT_FALSE(mGrid.update(3, osg::Vec3f(50, 50, 0)));
+        EXPECT_THAT(findInRadius(osg::Vec3f(0, 0, 0), 5), UnorderedElementsAre(2));
+        EXPECT_THAT(findInRadius(osg::Vec3f(50, 50, 0), 5), UnorderedElementsAre(1));
+        EXPECT_EQ(mGrid.size(), 2);
+    }
+
+    TEST_F(MiscSpatialGridTest, eraseShouldKeepOtherPoints)
+    {
+        for (int i = 0; i < 10; ++i)
+            mGrid.insert(i, osg::Vec3f(i, 0, 0));
+        EXPECT_TRUE(mGrid.erase(0));
+        EXPECT_TRUE(mGrid.erase(5));
+        EXPECT_FALSE(mGrid.erase(5));
+        EXPECT_THAT(findInRadius(osg::Vec3f(0, 0, 0), 100), UnorderedElementsAre(1, 2, 3, 4, 6, 7, 8, 9));
+        mGrid.clear();
+        EXPECT_TRUE(mGrid.empty());
+        EXPECT_THAT(findInRadius(osg::Vec3f(0, 0, 0), 100), IsEmpty());
+    }
+}
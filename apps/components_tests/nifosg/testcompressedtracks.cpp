@@ -0,0 +1,152 @@
+#include <components/nifosg/compressedtracks.hpp>
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    constexpr std::size_t numKeys = 300;
+    constexpr float duration = 10;
+
+    float getAngle(const osg::Quat& a, const osg::Quat& b)
+    {
+        const double dot = std::abs(a.asVec4() * b.asVec4());
+        return static_cast<float>(2 * std::acos(std::min(dot, 1.0)));
+    }
+
+    float getTime(std::size_t key)
+    {
+        return duration * key / (numKeys - 1);
+    }
+
+    std::shared_ptr<Nif::QuaternionKeyMap> makeRotations()
+    {
+        auto result = std::make_shared<Nif::QuaternionKeyMap>();
+        result->mInterpolationType = Nif::InterpolationType_Linear;
+        // Constant angular velocity for the first half, then a wobble
+        for (std::size_t i = 0; i < numKeys; ++i)
+        {
+            const float time = getTime(i);
+            const float angle = time < duration / 2 ? time : duration / 2 + std::sin(time * 3) * 0.5f;
+            result->mKeys.emplace_back(time, Nif::KeyT<osg::Quat>{ osg::Quat(angle, osg::Z_AXIS) });
+        }
+        return result;
+    }
+
+    std::shared_ptr<Nif::Vector3KeyMap> makeTranslations()
+    {
+        auto result = std::make_shared<Nif::Vector3KeyMap>();
+        result->mInterpolationType = Nif::InterpolationType_Linear;
+        for (std::size_t i = 0; i < numKeys; ++i)
+        {
+            const float time = getTime(i);
+            result->mKeys.emplace_back(
+                time, Nif::KeyT<osg::Vec3f>{ osg::Vec3f(time * 20, std::sin(time) * 50, 100) });
+        }
+        return result;
+    }
+
+    std::shared_ptr<Nif::FloatKeyMap> makeScales()
+    {
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = Nif::InterpolationType_Linear;
+        for (std::size_t i = 0; i < numKeys; ++i)
+            result->mKeys.emplace_back(getTime(i), Nif::KeyT<float>{ 1.f + 0.1f * std::cos(getTime(i)) });
+        return result;
+    }
+
+    struct NifOsgCompressedTransformTracksTest : Test
+    {
+        const std::shared_ptr<Nif::QuaternionKeyMap> mRotations = makeRotations();
+        const std::shared_ptr<Nif::Vector3KeyMap> mTranslations = makeTranslations();
+        const std::shared_ptr<Nif::FloatKeyMap> mScales = makeScales();
+        KeyframeCompressionSettings mSettings;
+
+        NifOsgCompressedTransformTracksTest()
+        {
+            mSettings.mRotationTolerance = 0.001f;
+            mSettings.mTranslationTolerance = 0.01f;
+            mSettings.mScaleTolerance = 0.001f;
+        }
+    };
+
+    TEST_F(NifOsgCompressedTransformTracksTest, sampledPosesShouldMatchOriginalWithinErrorBound)
+    {
+        const auto compressed
+            = CompressedTransformTracks::create(mRotations.get(), mTranslations.get(), mScales.get(), mSettings);
+        ASSERT_NE(compressed, nullptr);
+        ASSERT_TRUE(compressed->hasRotations());
+        ASSERT_TRUE(compressed->hasTranslations());
+        ASSERT_TRUE(compressed->hasScales());
+
+        const QuaternionInterpolator rotations(mRotations);
+        const Vec3Interpolator translations(mTranslations);
+        const FloatInterpolator scales(mScales);
+
+        // Quantization error is bounded by half a step of the value range of the track
+        const float rotationBound
+            = mSettings.mRotationTolerance + CompressedTransformTracks::getMaxRotationQuantizationError() + 1e-5f;
+        const float translationBound = mSettings.mTranslationTolerance + 200.f * std::sqrt(3.f) / 65535 + 1e-4f;
+        const float scaleBound = mSettings.mScaleTolerance + 0.2f / 65535 + 1e-6f;
+
+        for (float time = -1; time <= duration + 1; time += 0.0123f)
+        {
+            EXPECT_LE(getAngle(compressed->getRotation(time), rotations.interpKey(time)), rotationBound)
+                << "time=" << time;
+            EXPECT_LE((compressed->getTranslation(time) - translations.interpKey(time)).length(), translationBound)
+                << "time=" << time;
+            EXPECT_LE(std::abs(compressed->getScale(time) - scales.interpKey(time)), scaleBound) << "time=" << time;
+        }
+    }
+
+    TEST_F(NifOsgCompressedTransformTracksTest, shouldUseLessMemoryThanOriginal)
+    {
+        const auto compressed
+            = CompressedTransformTracks::create(mRotations.get(), mTranslations.get(), mScales.get(), mSettings);
+        ASSERT_NE(compressed, nullptr);
+        const std::size_t original
+            = getKeysMemoryUsage(*mRotations) + getKeysMemoryUsage(*mTranslations) + getKeysMemoryUsage(*mScales);
+        EXPECT_LT(compressed->getNumKeys(), 3 * numKeys);
+        EXPECT_LT(compressed->getMemoryUsage() * 4, original);
+    }
+
+    TEST_F(NifOsgCompressedTransformTracksTest, shouldKeepAllKeysForZeroTolerance)
+    {
+        const auto compressed = CompressedTransformTracks::create(
+            mRotations.get(), mTranslations.get(), mScales.get(), KeyframeCompressionSettings{});
+        ASSERT_NE(compressed, nullptr);
+        EXPECT_EQ(compressed->getNumKeys(), 3 * numKeys);
+    }
+
+    TEST_F(NifOsgCompressedTransformTracksTest, shouldSkipTracksWithTangents)
+    {
+        mTranslations->mInterpolationType = Nif::InterpolationType_TCB;
+        mScales->mInterpolationType = Nif::InterpolationType_Quadratic;
+        const auto compressed
+            = CompressedTransformTracks::create(mRotations.get(), mTranslations.get(), mScales.get(), mSettings);
+        ASSERT_NE(compressed, nullptr);
+        EXPECT_TRUE(compressed->hasRotations());
+        EXPECT_FALSE(compressed->hasTranslations());
+        EXPECT_FALSE(compressed->hasScales());
+    }
+
+    TEST_F(NifOsgCompressedTransformTracksTest, constantInterpolationShouldSelectNearestKey)
+    {
+        mScales->mInterpolationType = Nif::InterpolationType_Constant;
+        const auto compressed = CompressedTransformTracks::create(nullptr, nullptr, mScales.get(), mSettings);
+        ASSERT_NE(compressed, nullptr);
+        const FloatInterpolator scales(mScales);
+        const float step = 0.2f / 65535 + 1e-6f;
+        for (std::size_t i = 0; i + 1 < numKeys; i += 7)
+        {
+            const float time = getTime(i) * 0.3f + getTime(i + 1) * 0.7f;
+            EXPECT_NEAR(compressed->getScale(time), scales.interpKey(time), step) << "time=" << time;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include <components/nifosg/posecache.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    PoseCache::KfTransform makeTransform(float x)
+    {
+        PoseCache::KfTransform result;
+        result.mTranslation = osg::Vec3f(x, 0, 0);
+        return result;
+    }
+
+    TEST(NifOsgPoseCacheTest, findShouldReturnNullForEmptyCache)
+    {
+        PoseCache cache;
+        EXPECT_EQ(cache.find(1, 0.5f), nullptr);
+    }
+
+    TEST(NifOsgPoseCacheTest, findShouldReturnInsertedTransformForSameFrameAndTime)
+    {
+        PoseCache cache;
+        cache.insert(1, 0.5f, makeTransform(42));
+        const PoseCache::KfTransform* result = cache.find(1, 0.5f);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result->mTranslation, osg::Vec3f(42, 0, 0));
+    }
+
+    TEST(NifOsgPoseCacheTest, findShouldReturnNullForDifferentTime)
+    {
+        PoseCache cache;
+        cache.insert(1, 0.5f, makeTransform(42));
+        EXPECT_EQ(cache.find(1, 0.25f), nullptr);
+    }
+
+    TEST(NifOsgPoseCacheTest, findShouldReturnNullForNextFrame)
+    {
+        PoseCache cache;
+        cache.insert(1, 0.5f, makeTransform(42));
+        EXPECT_EQ(cache.find(2, 0.5f), nullptr);
+    }
+
+    TEST(NifOsgPoseCacheTest, takePoseCacheStatsShouldReturnAndResetCounters)
+    {
+        takePoseCacheStats();
+        PoseCache cache;
+        cache.find(1, 0.5f);
+        cache.insert(1, 0.5f, makeTransform(42));
+        cache.find(1, 0.5f);
+        const PoseCacheStats stats = takePoseCacheStats();
+        EXPECT_EQ(stats.mGet, 2u);
+        EXPECT_EQ(stats.mHit, 1u);
+        EXPECT_EQ(takePoseCacheStats().mGet, 0u);
+    }
+
+    TEST(NifOsgPoseCacheTest, quantizePoseTimeShouldRoundToTimeStep)
+    {
+        setPoseCacheTimeStep(0.25f);
+        EXPECT_FLOAT_EQ(quantizePoseTime(0.3f), 0.25f);
+        EXPECT_FLOAT_EQ(quantizePoseTime(0.4f), 0.5f);
+        setPoseCacheTimeStep(0);
+        EXPECT_FLOAT_EQ(quantizePoseTime(0.3f), 0.3f);
+    }
+}
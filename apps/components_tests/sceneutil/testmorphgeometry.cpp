@@ -0,0 +1,44 @@
+#include <components/sceneutil/morphgeometry.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    TEST(SceneUtilMorphTargetTest, shouldStoreOnlyNonZeroOffsetsForSparseTarget)
+    {
+        osg::ref_ptr<osg::Vec3Array> offsets = new osg::Vec3Array(8);
+        (*offsets)[2] = osg::Vec3f(1, 2, 3);
+        (*offsets)[5] = osg::Vec3f(-1, 0, 0);
+
+        const MorphGeometry::MorphTarget target(offsets);
+
+        const MorphGeometry::SparseOffsets* sparse = target.getSparseOffsets();
+        ASSERT_NE(sparse, nullptr);
+        EXPECT_EQ(sparse->mIndices, (std::vector<unsigned int>{ 2, 5 }));
+        EXPECT_EQ(sparse->mDeltas, (std::vector<osg::Vec3f>{ osg::Vec3f(1, 2, 3), osg::Vec3f(-1, 0, 0) }));
+    }
+
+    TEST(SceneUtilMorphTargetTest, shouldNotUseSparseOffsetsForDenseTarget)
+    {
+        osg::ref_ptr<osg::Vec3Array> offsets = new osg::Vec3Array(4, osg::Vec3f(1, 1, 1));
+
+        const MorphGeometry::MorphTarget target(offsets);
+
+        EXPECT_EQ(target.getSparseOffsets(), nullptr);
+    }
+
+    TEST(SceneUtilMorphTargetTest, setOffsetsShouldUpdateSparseOffsets)
+    {
+        MorphGeometry::MorphTarget target(new osg::Vec3Array(4, osg::Vec3f(1, 1, 1)));
+
+        osg::ref_ptr<osg::Vec3Array> offsets = new osg::Vec3Array(4);
+        (*offsets)[3] = osg::Vec3f(0, 0, 1);
+        target.setOffsets(offsets);
+
+        const MorphGeometry::SparseOffsets* sparse = target.getSparseOffsets();
+        ASSERT_NE(sparse, nullptr);
+        EXPECT_EQ(sparse->mIndices, (std::vector<unsigned int>{ 3 }));
+    }
+}
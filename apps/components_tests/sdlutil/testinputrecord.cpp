@@ -0,0 +1,103 @@
+#include <components/sdlutil/inputrecord.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SDLUtil;
+
+    SDL_Event makeKeyDown(SDL_Keycode key)
+    {
+        SDL_Event result{};
+        result.type = SDL_KEYDOWN;
+        result.key.keysym.sym = key;
+        return result;
+    }
+
+    TEST(SDLUtilInputRecordTest, readShouldReturnWrittenFrames)
+    {
+        const auto path = TestingOpenMW::outputFilePath("SDLUtilInputRecordTest_frames.omwinput");
+        const std::vector<SDL_Event> events{ makeKeyDown(SDLK_a), makeKeyDown(SDLK_b) };
+        const std::vector<InputPoll> polls{ InputPoll{ InputPollType::RelativeMouseX, -3 },
+            InputPoll{ InputPollType::ControllerAxis, 32767 } };
+        {
+            InputRecordWriter writer(path, 42);
+            writer.write(0.5f, events, polls);
+            writer.write(0.25f, {}, {});
+        }
+        InputRecordReader reader(path);
+        EXPECT_EQ(reader.getSeed(), 42);
+        InputRecordFrame frame;
+        ASSERT_TRUE(reader.read(frame));
+        EXPECT_EQ(frame.mDuration, 0.5f);
+        ASSERT_EQ(frame.mEvents.size(), 2);
+        EXPECT_EQ(frame.mEvents[0].type, SDL_KEYDOWN);
+        EXPECT_EQ(frame.mEvents[0].key.keysym.sym, SDLK_a);
+        EXPECT_EQ(frame.mEvents[1].key.keysym.sym, SDLK_b);
+        ASSERT_EQ(frame.mPolls.size(), 2);
+        EXPECT_EQ(frame.mPolls[0].mType, InputPollType::RelativeMouseX);
+        EXPECT_EQ(frame.mPolls[0].mValue, -3);
+        EXPECT_EQ(frame.mPolls[1].mType, InputPollType::ControllerAxis);
+        EXPECT_EQ(frame.mPolls[1].mValue, 32767);
+        ASSERT_TRUE(reader.read(frame));
+        EXPECT_EQ(frame.mDuration, 0.25f);
+        EXPECT_TRUE(frame.mEvents.empty());
+        EXPECT_TRUE(frame.mPolls.empty());
+        EXPECT_FALSE(reader.read(frame));
+    }
+
+    TEST(SDLUtilInputRecordTest, readerShouldThrowOnInvalidFile)
+    {
+        const auto path = TestingOpenMW::outputFilePath("SDLUtilInputRecordTest_invalid.omwinput");
+        std::ofstream(path, std::ios::binary) << "not an input record";
+        EXPECT_THROW(InputRecordReader{ path }, std::runtime_error);
+    }
+
+    TEST(SDLUtilInputRecordTest, readerShouldThrowOnDifferentSdlVersion)
+    {
+        const auto path = TestingOpenMW::outputFilePath("SDLUtilInputRecordTest_sdl_version.omwinput");
+        {
+            InputRecordWriter writer(path, 0);
+        }
+        {
+            // Magic, format version and event size are followed by SDL major, minor and patch versions
+            std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+            stream.seekg(18);
+            const char patch = static_cast<char>(stream.get());
+            stream.seekp(18);
+            stream.put(static_cast<char>(patch + 1));
+        }
+        EXPECT_THROW(InputRecordReader{ path }, std::runtime_error);
+    }
+
+    TEST(SDLUtilInputRecordTest, readShouldThrowOnTruncatedFrame)
+    {
+        const auto path = TestingOpenMW::outputFilePath("SDLUtilInputRecordTest_truncated.omwinput");
+        {
+            InputRecordWriter writer(path, 0);
+            const std::vector<SDL_Event> events{ makeKeyDown(SDLK_a) };
+            const std::vector<InputPoll> polls{ InputPoll{ InputPollType::Key, 1 } };
+            writer.write(0.5f, events, polls);
+        }
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        InputRecordReader reader(path);
+        InputRecordFrame frame;
+        EXPECT_THROW(reader.read(frame), std::runtime_error);
+    }
+
+    TEST(SDLUtilInputRecordTest, eventsWithPointersShouldNotBeRecordable)
+    {
+        SDL_Event event{};
+        event.type = SDL_DROPFILE;
+        EXPECT_FALSE(isRecordable(event));
+        event.type = SDL_USEREVENT;
+        EXPECT_FALSE(isRecordable(event));
+        EXPECT_TRUE(isRecordable(makeKeyDown(SDLK_a)));
+    }
+}
@@ -80,6 +80,32 @@ namespace
         EXPECT_EQ(result, "a\xE2\x80\x99");
     }
 
+    TEST(Utf8EncoderTest, getUtf8ShouldConvertNonAsciiAtAnyPositionOfLongInput)
+    {
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        for (std::size_t position = 0; position < 40; ++position)
+        {
+            std::string input(40, 'a');
+            input[position] = '\x92';
+            std::string expected(40, 'a');
+            expected.replace(position, 1, "\xe2\x80\x99");
+            EXPECT_EQ(encoder.getUtf8(input), expected) << position;
+        }
+    }
+
+    TEST(Utf8EncoderTest, getUtf8ShouldLookUpUntilZeroAtAnyPositionOfLongInput)
+    {
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        for (std::size_t position = 0; position < 40; ++position)
+        {
+            std::string input(41, 'a');
+            input[position] = '\0';
+            EXPECT_EQ(encoder.getUtf8(input), std::string(position, 'a')) << position;
+            input.back() = '\x92';
+            EXPECT_EQ(encoder.getUtf8(input), std::string(position, 'a')) << position;
+        }
+    }
+
     TEST_P(Utf8EncoderTest, getUtf8ShouldConvertFromLegacyEncodingToUtf8)
     {
         const std::string input(readContent(GetParam().mLegacyEncodingFileName));
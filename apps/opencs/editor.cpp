@@ -10,9 +10,14 @@
 #include <boost/program_options.hpp>
 
 #include <exception>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
 
 #include <apps/opencs/model/doc/document.hpp>
 #include <apps/opencs/model/doc/documentmanager.hpp>
+#include <apps/opencs/model/doc/state.hpp>
+#include <apps/opencs/model/tools/reportmodel.hpp>
 #include <apps/opencs/view/doc/adjusterwidget.hpp>
 #include <apps/opencs/view/doc/filedialog.hpp>
 #include <apps/opencs/view/doc/newgame.hpp>
@@ -48,11 +53,20 @@ CS::Editor::Editor(int argc, char** argv)
     , mIpcServerName("org.openmw.OpenCS")
     , mServer(nullptr)
     , mClientSocket(nullptr)
+    , mVerifyOnly(false)
 {
     std::pair<Files::PathContainer, std::vector<std::string>> config = readConfig();
 
     mViewManager = new CSVDoc::ViewManager(mDocumentManager);
-    if (argc > 1)
+    if (argc > 1 && std::string_view(argv[1]) == "--verify")
+    {
+        if (argc != 3)
+            throw std::runtime_error("Usage: openmw-cs --verify <content file>");
+        mVerifyOnly = true;
+        mFileToLoad = argv[2];
+        mDataDirs = config.first;
+    }
+    else if (argc > 1)
     {
         mFileToLoad = argv[1];
         mDataDirs = config.first;
@@ -70,6 +84,8 @@ CS::Editor::Editor(int argc, char** argv)
     connect(
         &mDocumentManager, &CSMDoc::DocumentManager::documentAboutToBeRemoved, this, &Editor::documentAboutToBeRemoved);
     connect(&mDocumentManager, &CSMDoc::DocumentManager::lastDocumentDeleted, this, &Editor::lastDocumentDeleted);
+    if (mVerifyOnly)
+        connect(&mDocumentManager, &CSMDoc::DocumentManager::loadingStopped, this, &Editor::loadingStopped);
 
     connect(mViewManager, &CSVDoc::ViewManager::newGameRequest, this, &Editor::createGame);
     connect(mViewManager, &CSVDoc::ViewManager::newAddonRequest, this, &Editor::createAddon);
@@ -396,7 +412,7 @@ int CS::Editor::run()
 
     Misc::Rng::init();
 
-    QApplication::setQuitOnLastWindowClosed(true);
+    QApplication::setQuitOnLastWindowClosed(!mVerifyOnly);
 
     if (mFileToLoad.empty())
     {
@@ -446,9 +462,42 @@ int CS::Editor::run()
 
 void CS::Editor::documentAdded(CSMDoc::Document* document)
 {
+    if (mVerifyOnly)
+    {
+        const CSMWorld::UniversalId reportId = document->verify();
+        CSMTools::ReportModel* report = document->getReport(reportId);
+
+        connect(document, &CSMDoc::Document::operationDone, this, [report](int type, bool failed) {
+            if (type != CSMDoc::State_Verifying)
+                return;
+
+            std::ostream& stream = Debug::getRawStdout();
+            for (int i = 0; i < report->rowCount(); ++i)
+            {
+                const CSMDoc::Message& message = report->getMessage(i);
+                stream << CSMDoc::Message::toString(message.mSeverity) << '\t' << message.mId.toString() << '\t'
+                       << message.mMessage << '\n';
+            }
+            stream.flush();
+
+            QApplication::exit(failed || report->countErrors() > 0 ? 1 : 0);
+        });
+
+        return;
+    }
+
     mViewManager->addView(document);
 }
 
+void CS::Editor::loadingStopped(CSMDoc::Document* document, bool completed, const std::string& error)
+{
+    if (completed)
+        return;
+
+    Log(Debug::Error) << "Failed to load \"" << document->getSavePath() << "\": " << error;
+    QApplication::exit(1);
+}
+
 void CS::Editor::documentAboutToBeRemoved(CSMDoc::Document* document)
 {
     if (mMerge.getDocument() == document)
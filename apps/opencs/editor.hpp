@@ -65,6 +65,7 @@ namespace CS
         std::filesystem::path mFileToLoad;
         Files::PathContainer mDataDirs;
         std::string mEncodingName;
+        bool mVerifyOnly;
 
         boost::program_options::variables_map readConfiguration();
         ///< Calls mCfgMgr.readConfiguration; should be used before initialization of mSettingsState as it depends on
@@ -80,6 +81,10 @@ namespace CS
         Editor(int argc, char** argv);
         ~Editor();
 
+        bool isVerifyOnly() const { return mVerifyOnly; }
+        ///< Started as "openmw-cs --verify <file>" to load the file, print the verifier report to stdout and exit
+        ///< with non-zero status if it contains errors.
+
         bool makeIPCServer();
         void connectToIPCServer();
 
@@ -107,6 +112,8 @@ namespace CS
 
         void documentAboutToBeRemoved(CSMDoc::Document* document);
 
+        void loadingStopped(CSMDoc::Document* document, bool completed, const std::string& error);
+
         void lastDocumentDeleted();
 
         void mergeDocument(CSMDoc::Document* document);
@@ -70,7 +70,7 @@ int runApplication(int argc, char* argv[])
     setlocale(LC_NUMERIC, "C");
 #endif
 
-    if (!editor.makeIPCServer())
+    if (!editor.isVerifyOnly() && !editor.makeIPCServer())
     {
         editor.connectToIPCServer();
         return 0;
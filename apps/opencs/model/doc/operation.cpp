@@ -4,6 +4,7 @@
 #include <exception>
 #include <vector>
 
+#include <QThreadPool>
 #include <QTimer>
 
 #include <components/debug/debuglog.hpp>
@@ -18,6 +19,12 @@ namespace CSMDoc
 {
     namespace
     {
+        // Several tasks per thread balance the load when steps take different time
+        constexpr int tasksPerThread = 4;
+
+        // Workers are polled for finished tasks instead of performing steps on each timer event
+        constexpr int pollInterval = 10;
+
         std::string_view operationToString(State value)
         {
             switch (value)
@@ -68,12 +75,21 @@ CSMDoc::Operation::Operation(State type, bool ordered, bool finalAlways)
     , mConnected(false)
     , mPrepared(false)
     , mDefaultSeverity(Message::Severity_Error)
+    , mThreadPool(nullptr)
+    , mNextTask(0)
+    , mAborted(false)
 {
     mTimer = new QTimer(this);
 }
 
 CSMDoc::Operation::~Operation()
 {
+    if (mThreadPool != nullptr)
+    {
+        mAborted = true;
+        mThreadPool->waitForDone();
+    }
+
     for (std::vector<std::pair<Stage*, int>>::iterator iter(mStages.begin()); iter != mStages.end(); ++iter)
         delete iter->first;
 }
@@ -104,6 +120,17 @@ void CSMDoc::Operation::setDefaultSeverity(Message::Severity severity)
     mDefaultSeverity = severity;
 }
 
+void CSMDoc::Operation::setParallel(bool parallel)
+{
+    if (parallel && mThreadPool == nullptr)
+        mThreadPool = new QThreadPool(this);
+    else if (!parallel && mThreadPool != nullptr)
+    {
+        delete mThreadPool;
+        mThreadPool = nullptr;
+    }
+}
+
 bool CSMDoc::Operation::hasError() const
 {
     return mError;
@@ -116,6 +143,12 @@ void CSMDoc::Operation::abort()
 
     mError = true;
 
+    if (mThreadPool != nullptr)
+    {
+        mAborted = true;
+        return;
+    }
+
     if (mFinalAlways)
     {
         if (mStages.begin() != mStages.end() && mCurrentStage != --mStages.end())
@@ -134,6 +167,19 @@ void CSMDoc::Operation::executeStage()
     {
         prepareStages();
         mPrepared = true;
+
+        if (mThreadPool != nullptr)
+        {
+            startTasks();
+            mTimer->setInterval(pollInterval);
+        }
+    }
+
+    if (mThreadPool != nullptr)
+    {
+        if (reportTasks())
+            complete();
+        return;
     }
 
     Messages messages(mDefaultSeverity);
@@ -169,17 +215,90 @@ void CSMDoc::Operation::executeStage()
         emit reportMessage(*iter, mType);
 
     if (mCurrentStage == mStages.end())
+        complete();
+}
+
+void CSMDoc::Operation::startTasks()
+{
+    mTasks.clear();
+    mNextTask = 0;
+    mAborted = false;
+
+    const int threads = std::max(mThreadPool->maxThreadCount(), 1);
+
+    for (const auto& [stage, steps] : mStages)
     {
-        if (mStart.has_value())
+        const int taskSteps = stage->isThreadSafe() ? std::max(steps / (threads * tasksPerThread), 1) : steps;
+        for (int begin = 0; begin < steps; begin += taskSteps)
+            mTasks.push_back(
+                std::make_unique<Task>(*stage, begin, std::min(begin + taskSteps, steps), mDefaultSeverity));
+    }
+
+    for (const std::unique_ptr<Task>& task : mTasks)
+        mThreadPool->start([this, task = task.get()] { performTask(*task); });
+}
+
+void CSMDoc::Operation::performTask(Task& task)
+{
+    // Same as in the sequential mode the last stage is performed completely even after an abort or an error
+    const bool final = mFinalAlways && &task.mStage == mStages.back().first;
+
+    try
+    {
+        for (int step = task.mBegin; step < task.mEnd && (final || !mAborted); ++step)
         {
-            const auto duration = std::chrono::steady_clock::now() - *mStart;
-            Log(Debug::Verbose) << operationToString(mType) << " operation is completed in "
-                                << std::chrono::duration_cast<std::chrono::duration<double>>(duration).count() << 's';
-            mStart.reset();
+            task.mStage.perform(step, task.mMessages);
+            ++task.mPerformed;
         }
+    }
+    catch (const std::exception& e)
+    {
+        task.mMessages.add(CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError);
+        task.mFailed = true;
+        mAborted = true;
+    }
+
+    task.mDone = true;
+}
+
+bool CSMDoc::Operation::reportTasks()
+{
+    int performed = 0;
+    for (const std::unique_ptr<Task>& task : mTasks)
+        performed += task->mPerformed;
+
+    emit progress(performed, mTotalSteps ? mTotalSteps : 1, mType);
+
+    // Messages of a task are reported only when all previous tasks are done to keep the order deterministic
+    for (; mNextTask < mTasks.size() && mTasks[mNextTask]->mDone; ++mNextTask)
+    {
+        const Task& task = *mTasks[mNextTask];
 
-        operationDone();
+        if (task.mFailed)
+            mError = true;
+
+        for (const Message& message : task.mMessages)
+            emit reportMessage(message, mType);
     }
+
+    if (mNextTask < mTasks.size())
+        return false;
+
+    mTasks.clear();
+    return true;
+}
+
+void CSMDoc::Operation::complete()
+{
+    if (mStart.has_value())
+    {
+        const auto duration = std::chrono::steady_clock::now() - *mStart;
+        Log(Debug::Verbose) << operationToString(mType) << " operation is completed in "
+                            << std::chrono::duration_cast<std::chrono::duration<double>>(duration).count() << 's';
+        mStart.reset();
+    }
+
+    operationDone();
 }
 
 void CSMDoc::Operation::operationDone()
@@ -1,7 +1,9 @@
 #ifndef CSM_DOC_OPERATION_H
 #define CSM_DOC_OPERATION_H
 
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -11,6 +13,7 @@
 #include "messages.hpp"
 #include "state.hpp"
 
+class QThreadPool;
 class QTimer;
 
 namespace CSMDoc
@@ -21,6 +24,25 @@ namespace CSMDoc
     {
         Q_OBJECT
 
+        struct Task
+        {
+            Stage& mStage;
+            const int mBegin;
+            const int mEnd;
+            Messages mMessages;
+            std::atomic_int mPerformed{ 0 };
+            std::atomic_bool mFailed{ false };
+            std::atomic_bool mDone{ false };
+
+            explicit Task(Stage& stage, int begin, int end, Message::Severity defaultSeverity)
+                : mStage(stage)
+                , mBegin(begin)
+                , mEnd(end)
+                , mMessages(defaultSeverity)
+            {
+            }
+        };
+
         State mType;
         std::vector<std::pair<Stage*, int>> mStages; // stage, number of steps
         std::vector<std::pair<Stage*, int>>::iterator mCurrentStage;
@@ -35,9 +57,22 @@ namespace CSMDoc
         bool mPrepared;
         Message::Severity mDefaultSeverity;
         std::optional<std::chrono::steady_clock::time_point> mStart;
+        QThreadPool* mThreadPool;
+        std::vector<std::unique_ptr<Task>> mTasks;
+        std::size_t mNextTask;
+        std::atomic_bool mAborted;
 
         void prepareStages();
 
+        void startTasks();
+
+        void performTask(Task& task);
+
+        bool reportTasks();
+        ///< \return All tasks are done.
+
+        void complete();
+
     public:
         Operation(State type, bool ordered, bool finalAlways = false);
         ///< \param ordered Stages must be executed in the given order.
@@ -53,6 +88,13 @@ namespace CSMDoc
         /// \attention Do no call this function while this Operation is running.
         void setDefaultSeverity(Message::Severity severity);
 
+        /// Perform stages concurrently on a thread pool. Steps of a thread safe stage are performed concurrently
+        /// too. Messages are reported in the same order as if stages were performed one after another.
+        ///
+        /// \attention Stages must not depend on each other. Do no call this function while this Operation is
+        /// running.
+        void setParallel(bool parallel);
+
         bool hasError() const;
 
     signals:
@@ -14,6 +14,12 @@ namespace CSMDoc
 
         virtual void perform(int stage, Messages& messages) = 0;
         ///< Messages resulting from this stage will be appended to \a messages.
+
+        virtual bool isThreadSafe() const { return false; }
+        ///< \return Different steps can be performed concurrently.
+        ///
+        /// \attention Return true only if perform does not modify the stage and only reads the document data
+        /// through const functions without lazily updated caches.
     };
 }
 
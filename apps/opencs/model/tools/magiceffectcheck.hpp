@@ -53,6 +53,8 @@ namespace CSMTools
         ///< \return number of steps
         void perform(int stage, CSMDoc::Messages& messages) override;
         ///< Messages resulting from this tage will be appended to \a messages.
+
+        bool isThreadSafe() const override { return true; }
     };
 }
 
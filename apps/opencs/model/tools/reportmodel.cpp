@@ -186,6 +186,11 @@ std::string CSMTools::ReportModel::getHint(int row) const
     return mRows.at(row).mHint;
 }
 
+const CSMDoc::Message& CSMTools::ReportModel::getMessage(int row) const
+{
+    return mRows.at(row);
+}
+
 void CSMTools::ReportModel::clear()
 {
     if (!mRows.empty())
@@ -0,0 +1,263 @@
+#include "searchindex.hpp"
+
+#include <algorithm>
+
+#include <QModelIndex>
+#include <QString>
+#include <QVariant>
+
+#include "../world/columnbase.hpp"
+#include "../world/idtablebase.hpp"
+
+namespace
+{
+    // Search is using Qt::CaseInsensitive which compares case folded characters, so a matching text contains all
+    // case folded trigrams of the searched text
+    void getTrigrams(const QString& text, std::vector<std::uint64_t>& trigrams)
+    {
+        const QString folded = text.toCaseFolded();
+
+        for (qsizetype i = 2; i < folded.size(); ++i)
+            trigrams.push_back(static_cast<std::uint64_t>(folded[i - 2].unicode()) << 32
+                | static_cast<std::uint64_t>(folded[i - 1].unicode()) << 16 | folded[i].unicode());
+    }
+}
+
+std::atomic<std::size_t> CSMTools::SearchIndex::sTotalEntries{ 0 };
+
+CSMTools::SearchIndex::SearchIndex(const CSMWorld::IdTableBase* model, std::size_t maxTotalEntries)
+    : mModel(model)
+    , mMaxTotalEntries(maxTotalEntries)
+    , mBuilt(false)
+    , mReleased(false)
+    , mEntries(0)
+{
+    connect(mModel, &CSMWorld::IdTableBase::dataChanged, this, &SearchIndex::dataChanged);
+    connect(mModel, &CSMWorld::IdTableBase::rowsAboutToBeRemoved, this, &SearchIndex::rowsAboutToBeRemoved);
+    connect(mModel, &CSMWorld::IdTableBase::rowsInserted, this, &SearchIndex::rowsInserted);
+    connect(mModel, &CSMWorld::IdTableBase::rowsMoved, this, &SearchIndex::invalidate);
+    connect(mModel, &CSMWorld::IdTableBase::layoutChanged, this, &SearchIndex::invalidate);
+    connect(mModel, &CSMWorld::IdTableBase::modelReset, this, &SearchIndex::invalidate);
+}
+
+CSMTools::SearchIndex::~SearchIndex()
+{
+    sTotalEntries.fetch_sub(mEntries, std::memory_order_relaxed);
+}
+
+void CSMTools::SearchIndex::build()
+{
+    invalidate();
+
+    const int columns = mModel->columnCount();
+
+    for (int i = 0; i < columns; ++i)
+    {
+        CSMWorld::ColumnBase::Display display = static_cast<CSMWorld::ColumnBase::Display>(
+            mModel->headerData(i, Qt::Horizontal, static_cast<int>(CSMWorld::ColumnBase::Role_Display)).toInt());
+
+        if (CSMWorld::ColumnBase::isText(display) || CSMWorld::ColumnBase::isId(display)
+            || CSMWorld::ColumnBase::isScript(display))
+            mColumns.push_back(i);
+    }
+
+    const int rows = mModel->rowCount();
+
+    mRowHandles.reserve(rows);
+
+    for (int i = 0; i < rows; ++i)
+    {
+        mRowHandles.push_back(addRow(i));
+
+        if (!checkLimit())
+            return;
+    }
+
+    mBuilt = true;
+}
+
+std::size_t CSMTools::SearchIndex::addRow(int row)
+{
+    std::size_t handle = mTrigrams.size();
+
+    if (mFreeHandles.empty())
+        mTrigrams.emplace_back();
+    else
+    {
+        handle = mFreeHandles.back();
+        mFreeHandles.pop_back();
+    }
+
+    std::vector<Trigram>& trigrams = mTrigrams[handle];
+
+    for (const int column : mColumns)
+        getTrigrams(mModel->data(mModel->index(row, column)).toString(), trigrams);
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    for (const Trigram trigram : trigrams)
+        mPostings[trigram].insert(handle);
+
+    mEntries += trigrams.size();
+    sTotalEntries.fetch_add(trigrams.size(), std::memory_order_relaxed);
+
+    return handle;
+}
+
+void CSMTools::SearchIndex::removeHandle(std::size_t handle)
+{
+    for (const Trigram trigram : mTrigrams[handle])
+    {
+        const auto iter = mPostings.find(trigram);
+        iter->second.erase(handle);
+        if (iter->second.empty())
+            mPostings.erase(iter);
+    }
+
+    mEntries -= mTrigrams[handle].size();
+    sTotalEntries.fetch_sub(mTrigrams[handle].size(), std::memory_order_relaxed);
+
+    mTrigrams[handle].clear();
+    mFreeHandles.push_back(handle);
+}
+
+bool CSMTools::SearchIndex::checkLimit()
+{
+    if (sTotalEntries.load(std::memory_order_relaxed) <= mMaxTotalEntries)
+        return true;
+
+    invalidate();
+
+    // Reduce memory usage, but keep the search working for this table
+    mColumns.shrink_to_fit();
+    mRowHandles.shrink_to_fit();
+    mTrigrams.shrink_to_fit();
+    mFreeHandles.shrink_to_fit();
+    mPostings.rehash(0);
+
+    mReleased = true;
+
+    return false;
+}
+
+std::optional<std::vector<int>> CSMTools::SearchIndex::findRows(const QString& text)
+{
+    std::vector<Trigram> trigrams;
+    getTrigrams(text, trigrams);
+
+    if (trigrams.empty() || mReleased)
+        return std::nullopt;
+
+    // Changes not reported by the model can't be tracked
+    if (!mBuilt || static_cast<int>(mRowHandles.size()) != mModel->rowCount())
+        build();
+
+    if (mReleased)
+        return std::nullopt;
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    std::vector<const std::unordered_set<std::size_t>*> postings;
+
+    for (const Trigram trigram : trigrams)
+    {
+        const auto iter = mPostings.find(trigram);
+        if (iter == mPostings.end())
+            return std::vector<int>();
+        postings.push_back(&iter->second);
+    }
+
+    // Start from the shortest posting list to check as few handles as possible
+    std::sort(
+        postings.begin(), postings.end(), [](const auto* lhs, const auto* rhs) { return lhs->size() < rhs->size(); });
+
+    std::vector<bool> candidates(mTrigrams.size(), false);
+
+    for (const std::size_t handle : *postings.front())
+        candidates[handle] = std::all_of(postings.begin() + 1, postings.end(),
+            [&](const std::unordered_set<std::size_t>* posting) { return posting->contains(handle); });
+
+    std::vector<int> rows;
+
+    for (std::size_t row = 0; row < mRowHandles.size(); ++row)
+        if (candidates[mRowHandles[row]])
+            rows.push_back(static_cast<int>(row));
+
+    return rows;
+}
+
+void CSMTools::SearchIndex::dataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    if (!mBuilt || topLeft.parent().isValid())
+        return;
+
+    if (bottomRight.row() >= static_cast<int>(mRowHandles.size()))
+    {
+        invalidate();
+        return;
+    }
+
+    if (std::none_of(mColumns.begin(), mColumns.end(),
+            [&](int column) { return column >= topLeft.column() && column <= bottomRight.column(); }))
+        return;
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row)
+    {
+        removeHandle(mRowHandles[row]);
+        mRowHandles[row] = addRow(row);
+    }
+
+    checkLimit();
+}
+
+void CSMTools::SearchIndex::rowsAboutToBeRemoved(const QModelIndex& parent, int start, int end)
+{
+    if (!mBuilt || parent.isValid())
+        return;
+
+    if (end >= static_cast<int>(mRowHandles.size()))
+    {
+        invalidate();
+        return;
+    }
+
+    for (int row = start; row <= end; ++row)
+        removeHandle(mRowHandles[row]);
+
+    mRowHandles.erase(mRowHandles.begin() + start, mRowHandles.begin() + end + 1);
+}
+
+void CSMTools::SearchIndex::rowsInserted(const QModelIndex& parent, int start, int end)
+{
+    if (!mBuilt || parent.isValid())
+        return;
+
+    if (start > static_cast<int>(mRowHandles.size()))
+    {
+        invalidate();
+        return;
+    }
+
+    std::vector<std::size_t> handles;
+
+    for (int row = start; row <= end; ++row)
+        handles.push_back(addRow(row));
+
+    mRowHandles.insert(mRowHandles.begin() + start, handles.begin(), handles.end());
+
+    checkLimit();
+}
+
+void CSMTools::SearchIndex::invalidate()
+{
+    sTotalEntries.fetch_sub(mEntries, std::memory_order_relaxed);
+    mEntries = 0;
+    mBuilt = false;
+    mColumns.clear();
+    mRowHandles.clear();
+    mTrigrams.clear();
+    mFreeHandles.clear();
+    mPostings.clear();
+}
@@ -0,0 +1,91 @@
+#ifndef CSM_TOOLS_SEARCHINDEX_H
+#define CSM_TOOLS_SEARCHINDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QObject>
+
+class QModelIndex;
+class QString;
+
+namespace CSMWorld
+{
+    class IdTableBase;
+}
+
+namespace CSMTools
+{
+    /// \brief Inverted index of case folded trigrams of text, ID and script columns of a table
+    ///
+    /// Provides rows which may contain a text, so a search has to look only at them. The index is built on first use
+    /// and then updated on changes of the model.
+    ///
+    /// All indices together store a limited number of trigram entries. An index exceeding the limit is released and
+    /// the table is always searched row by row.
+    class SearchIndex : public QObject
+    {
+        Q_OBJECT
+
+        using Trigram = std::uint64_t;
+
+        static std::atomic<std::size_t> sTotalEntries;
+
+        const CSMWorld::IdTableBase* mModel;
+        const std::size_t mMaxTotalEntries;
+        bool mBuilt;
+        bool mReleased;
+        std::size_t mEntries;
+        std::vector<int> mColumns;
+        std::vector<std::size_t> mRowHandles; // row -> handle
+        std::vector<std::vector<Trigram>> mTrigrams; // handle -> trigrams of the row
+        std::vector<std::size_t> mFreeHandles;
+        std::unordered_map<Trigram, std::unordered_set<std::size_t>> mPostings; // trigram -> handles
+
+        void build();
+
+        std::size_t addRow(int row);
+        ///< \return handle
+
+        void removeHandle(std::size_t handle);
+
+        bool checkLimit();
+        ///< Release the index if the limit of entries is exceeded.
+        ///
+        /// \return Is the index kept?
+
+    public:
+        /// Entry is a trigram of a row, it takes about 50 bytes
+        static constexpr std::size_t sDefaultMaxTotalEntries = 1 << 22;
+
+        explicit SearchIndex(const CSMWorld::IdTableBase* model, std::size_t maxTotalEntries = sDefaultMaxTotalEntries);
+
+        ~SearchIndex() override;
+
+        /// Number of trigram entries stored by all indices
+        static std::size_t getTotalEntries() { return sTotalEntries.load(std::memory_order_relaxed); }
+
+        /// Return rows in ascending order which may contain \a text ignoring case.
+        ///
+        /// \return std::nullopt, if \a text is too short to be looked up in the index or the index is released and all
+        /// rows have to be searched.
+        std::optional<std::vector<int>> findRows(const QString& text);
+
+    private slots:
+
+        void dataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+
+        void rowsAboutToBeRemoved(const QModelIndex& parent, int start, int end);
+
+        void rowsInserted(const QModelIndex& parent, int start, int end);
+
+        void invalidate();
+    };
+}
+
+#endif
@@ -25,6 +25,10 @@ CSMTools::SearchOperation::SearchOperation(CSMDoc::Document& document)
         appendStage(new SearchStage(&dynamic_cast<CSMWorld::IdTableBase&>(*document.getData().getTableModel(*iter))));
 
     setDefaultSeverity(CSMDoc::Message::Severity_Info);
+
+    // Document is locked while the operation is running, so tables can be searched from multiple threads. Each stage
+    // decides whether its model can be read concurrently.
+    setParallel(true);
 }
 
 void CSMTools::SearchOperation::configure(const Search& search)
@@ -1,6 +1,10 @@
 #include "searchstage.hpp"
 
+#include <QString>
+
+#include "../world/idtable.hpp"
 #include "../world/idtablebase.hpp"
+#include "../world/resourcetable.hpp"
 
 #include <apps/opencs/model/tools/search.hpp>
 
@@ -14,6 +18,10 @@ namespace CSMDoc
 CSMTools::SearchStage::SearchStage(const CSMWorld::IdTableBase* model)
     : mModel(model)
     , mOperation(nullptr)
+    // data and flags of these models only read records and resources, other models like proxies can update caches
+    , mThreadSafe(dynamic_cast<const CSMWorld::IdTable*>(model) != nullptr
+          || dynamic_cast<const CSMWorld::ResourceTable*>(model) != nullptr)
+    , mIndex(model)
 {
 }
 
@@ -24,12 +32,21 @@ int CSMTools::SearchStage::setup()
 
     mSearch.configure(mModel);
 
+    mRows.reset();
+
+    // Only rows containing all trigrams of the text may match, regular expressions need a full scan
+    if (mSearch.getType() == Search::Type_Text || mSearch.getType() == Search::Type_Id)
+        mRows = mIndex.findRows(QString::fromUtf8(mSearch.getText().c_str()));
+
+    if (mRows.has_value())
+        return static_cast<int>(mRows->size());
+
     return mModel->rowCount();
 }
 
 void CSMTools::SearchStage::perform(int stage, CSMDoc::Messages& messages)
 {
-    mSearch.searchRow(mModel, stage, messages);
+    mSearch.searchRow(mModel, mRows.has_value() ? (*mRows)[stage] : stage, messages);
 }
 
 void CSMTools::SearchStage::setOperation(const SearchOperation* operation)
@@ -1,9 +1,13 @@
 #ifndef CSM_TOOLS_SEARCHSTAGE_H
 #define CSM_TOOLS_SEARCHSTAGE_H
 
+#include <optional>
+#include <vector>
+
 #include "../doc/stage.hpp"
 
 #include "search.hpp"
+#include "searchindex.hpp"
 
 namespace CSMDoc
 {
@@ -24,6 +28,9 @@ namespace CSMTools
         const CSMWorld::IdTableBase* mModel;
         Search mSearch;
         const SearchOperation* mOperation;
+        const bool mThreadSafe;
+        SearchIndex mIndex;
+        std::optional<std::vector<int>> mRows; // rows found in mIndex, all rows if not set
 
     public:
         SearchStage(const CSMWorld::IdTableBase* model);
@@ -34,6 +41,8 @@ namespace CSMTools
         void perform(int stage, CSMDoc::Messages& messages) override;
         ///< Messages resulting from this stage will be appended to \a messages.
 
+        bool isThreadSafe() const override { return mThreadSafe; }
+
         void setOperation(const SearchOperation* operation);
     };
 }
@@ -32,6 +32,8 @@ namespace CSMTools
 
         void perform(int stage, CSMDoc::Messages& messages) override;
         int setup() override;
+
+        bool isThreadSafe() const override { return true; }
     };
 }
 
@@ -135,6 +135,9 @@ CSMDoc::OperationHolder* CSMTools::Tools::getVerifier()
 
         mVerifierOperation->appendStage(new EnchantmentCheckStage(mData.getEnchantments()));
 
+        // Document is locked while the operation is running, so stages can read the data from multiple threads
+        mVerifierOperation->setParallel(true);
+
         mVerifier.setOperation(mVerifierOperation);
     }
 
@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -100,12 +101,19 @@ namespace CSMWorld
 
     private:
         std::vector<std::unique_ptr<Record<ESXRecordT>>> mRecords;
-        std::map<ESM::RefId, int> mIndex;
+        std::unordered_map<ESM::RefId, int> mIndex;
         std::vector<Column<ESXRecordT>*> mColumns;
 
     protected:
         const std::vector<std::unique_ptr<Record<ESXRecordT>>>& getRecords() const;
 
+        virtual void eraseIndex(int begin, int end);
+        ///< Remove records in rows [begin, end) from the index. Called before the records are removed.
+
+        virtual void updateIndex(int begin, int end);
+        ///< Map records in rows [begin, end) to their rows. Called after records are inserted or moved, so
+        /// modifying a collection costs a single pass over the moved rows.
+
         void reorderRowsImp(const std::vector<int>& indexOrder);
 
         bool reorderRowsImp(int baseIndex, const std::vector<int>& newOrder);
@@ -148,7 +156,7 @@ namespace CSMWorld
         ///< Merge modified into base.
 
         void purge();
-        ///< Remove records that are flagged as erased.
+        ///< Remove records that are flagged as erased. The remaining records are reindexed once.
 
         void removeRows(int index, int count) override;
 
@@ -223,11 +231,9 @@ namespace CSMWorld
         assert(std::unordered_set(indexOrder.begin(), indexOrder.end()).size() == indexOrder.size());
         std::vector<std::unique_ptr<Record<ESXRecordT>>> orderedRecords;
         for (const int index : indexOrder)
-        {
-            mIndex.at(mRecords[index]->get().mId) = static_cast<int>(orderedRecords.size());
             orderedRecords.push_back(std::move(mRecords[index]));
-        }
         mRecords = std::move(orderedRecords);
+        updateIndex(0, static_cast<int>(mRecords.size()));
     }
 
     template <typename ESXRecordT>
@@ -255,15 +261,30 @@ namespace CSMWorld
 
             std::move(buffer.begin(), buffer.end(), mRecords.begin() + baseIndex);
 
-            // adjust index
-            for (auto& [id, index] : mIndex)
-                if (index >= baseIndex && index < baseIndex + size)
-                    index = newOrder.at(index - baseIndex) + baseIndex;
+            updateIndex(baseIndex, baseIndex + size);
         }
 
         return true;
     }
 
+    template <typename ESXRecordT>
+    void Collection<ESXRecordT>::eraseIndex(int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            // Erased records can't be accessed via get() but still have the ID
+            const Record<ESXRecordT>& record = *mRecords[i];
+            mIndex.erase(getRecordId(record.isErased() ? record.mBase : record.get()));
+        }
+    }
+
+    template <typename ESXRecordT>
+    void Collection<ESXRecordT>::updateIndex(int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+            mIndex.insert_or_assign(getRecordId(mRecords[i]->get()), i);
+    }
+
     template <typename ESXRecordT>
     int Collection<ESXRecordT>::cloneRecordImp(
         const ESM::RefId& origin, const ESM::RefId& destination, UniversalId::Type type)
@@ -441,41 +462,32 @@ namespace CSMWorld
     template <typename ESXRecordT>
     void Collection<ESXRecordT>::purge()
     {
-        int i = 0;
+        const auto isErased = [](const std::unique_ptr<Record<ESXRecordT>>& record) { return record->isErased(); };
 
-        while (i < static_cast<int>(mRecords.size()))
-        {
+        const auto first = std::find_if(mRecords.begin(), mRecords.end(), isErased);
+
+        if (first == mRecords.end())
+            return;
+
+        const int begin = static_cast<int>(first - mRecords.begin());
+
+        for (int i = begin; i < static_cast<int>(mRecords.size()); ++i)
             if (mRecords[i]->isErased())
-                removeRows(i, 1);
-            else
-                ++i;
-        }
+                eraseIndex(i, i + 1);
+
+        mRecords.erase(std::remove_if(first, mRecords.end(), isErased), mRecords.end());
+
+        updateIndex(begin, static_cast<int>(mRecords.size()));
     }
 
     template <typename ESXRecordT>
     void Collection<ESXRecordT>::removeRows(int index, int count)
     {
-        mRecords.erase(mRecords.begin() + index, mRecords.begin() + index + count);
+        eraseIndex(index, index + count);
 
-        auto iter = mIndex.begin();
+        mRecords.erase(mRecords.begin() + index, mRecords.begin() + index + count);
 
-        while (iter != mIndex.end())
-        {
-            if (iter->second >= index)
-            {
-                if (iter->second >= index + count)
-                {
-                    iter->second -= count;
-                    ++iter;
-                }
-                else
-                {
-                    iter = mIndex.erase(iter);
-                }
-            }
-            else
-                ++iter;
-        }
+        updateIndex(index, static_cast<int>(mRecords.size()));
     }
 
     template <typename ESXRecordT>
@@ -533,12 +545,14 @@ namespace CSMWorld
     {
         std::vector<ESM::RefId> ids;
 
-        for (auto iter = mIndex.begin(); iter != mIndex.end(); ++iter)
+        for (const auto& record : mRecords)
         {
-            if (listDeleted || !mRecords[iter->second]->isDeleted())
-                ids.push_back(getRecordId(mRecords[iter->second]->get()));
+            if (listDeleted || !record->isDeleted())
+                ids.push_back(getRecordId(record->get()));
         }
 
+        std::sort(ids.begin(), ids.end());
+
         return ids;
     }
 
@@ -563,23 +577,13 @@ namespace CSMWorld
             throw std::runtime_error("index out of range");
 
         std::unique_ptr<Record<ESXRecordT>> record2(static_cast<Record<ESXRecordT>*>(record.release()));
-        ESM::RefId id = getRecordId(record2->get());
 
         if (index == size)
             mRecords.push_back(std::move(record2));
         else
             mRecords.insert(mRecords.begin() + index, std::move(record2));
 
-        if (index < size - 1)
-        {
-            for (auto& [key, value] : mIndex)
-            {
-                if (value >= index)
-                    ++value;
-            }
-        }
-
-        mIndex.insert(std::make_pair(id, index));
+        updateIndex(index, static_cast<int>(mRecords.size()));
     }
 
     template <typename ESXRecordT>
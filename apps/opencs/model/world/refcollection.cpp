@@ -19,34 +19,6 @@
 
 #include "../doc/messages.hpp"
 
-namespace CSMWorld
-{
-    template <>
-    void Collection<CellRef>::removeRows(int index, int count)
-    {
-        mRecords.erase(mRecords.begin() + index, mRecords.begin() + index + count);
-
-        // index map is updated in RefCollection::removeRows()
-    }
-
-    template <>
-    void Collection<CellRef>::insertRecord(std::unique_ptr<RecordBase> record, int index, UniversalId::Type type)
-    {
-        int size = static_cast<int>(mRecords.size());
-        if (index < 0 || index > size)
-            throw std::runtime_error("index out of range");
-
-        std::unique_ptr<Record<CellRef>> record2(static_cast<Record<CellRef>*>(record.release()));
-
-        if (index == size)
-            mRecords.push_back(std::move(record2));
-        else
-            mRecords.insert(mRecords.begin() + index, std::move(record2));
-
-        // index map is updated in RefCollection::insertRecord()
-    }
-}
-
 void CSMWorld::RefCollection::load(ESM::ESMReader& reader, int cellIndex, bool base,
     std::map<ESM::RefNum, unsigned int>& cache, CSMDoc::Messages& messages)
 {
@@ -252,7 +224,7 @@ int CSMWorld::RefCollection::getIntIndex(unsigned int id) const
 
 int CSMWorld::RefCollection::searchId(unsigned int id) const
 {
-    std::map<unsigned int, int>::const_iterator iter = mRefIndex.find(id);
+    const auto iter = mRefIndex.find(id);
 
     if (iter == mRefIndex.end())
         return -1;
@@ -260,28 +232,21 @@ int CSMWorld::RefCollection::searchId(unsigned int id) const
     return iter->second;
 }
 
-void CSMWorld::RefCollection::removeRows(int index, int count)
+void CSMWorld::RefCollection::eraseIndex(int begin, int end)
 {
-    Collection<CellRef>::removeRows(index, count); // erase records only
-
-    std::map<unsigned int, int>::iterator iter = mRefIndex.begin();
-    while (iter != mRefIndex.end())
+    for (int i = begin; i < end; ++i)
     {
-        if (iter->second >= index)
-        {
-            if (iter->second >= index + count)
-            {
-                iter->second -= count;
-                ++iter;
-            }
-            else
-                mRefIndex.erase(iter++);
-        }
-        else
-            ++iter;
+        const Record<CellRef>& record = getRecord(i);
+        mRefIndex.erase((record.isErased() ? record.mBase : record.get()).mIdNum);
     }
 }
 
+void CSMWorld::RefCollection::updateIndex(int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+        mRefIndex.insert_or_assign(getRecord(i).get().mIdNum, i);
+}
+
 void CSMWorld::RefCollection::appendBlankRecord(const ESM::RefId& id, UniversalId::Type type)
 {
     auto record = std::make_unique<Record<CellRef>>();
@@ -300,7 +265,6 @@ void CSMWorld::RefCollection::cloneRecord(
     const ESM::RefId& origin, const ESM::RefId& destination, const UniversalId::Type type)
 {
     auto copy = std::make_unique<Record<CellRef>>();
-    int index = getAppendIndex(ESM::RefId(), type);
 
     copy->mModified = getRecord(origin).get();
     copy->mState = RecordBase::State_ModifiedOnly;
@@ -309,13 +273,9 @@ void CSMWorld::RefCollection::cloneRecord(
     copy->get().mIdNum = extractIdNum(destination.getRefIdString());
     copy->get().mRefNum.mIndex = getNextRefNum();
 
-    if (copy->get().mRefNum.hasContentFile())
-    {
-        mRefIndex.insert(std::make_pair(static_cast<Record<CellRef>*>(copy.get())->get().mIdNum, index));
-        copy->get().mRefNum.mContentFile = -1;
-    }
+    copy->get().mRefNum.mContentFile = -1;
 
-    insertRecord(std::move(copy), getAppendIndex(destination, type)); // call RefCollection::insertRecord()
+    insertRecord(std::move(copy), getAppendIndex(destination, type));
 }
 
 int CSMWorld::RefCollection::searchId(const ESM::RefId& id) const
@@ -327,26 +287,5 @@ void CSMWorld::RefCollection::appendRecord(std::unique_ptr<RecordBase> record, U
 {
     int index = getAppendIndex(/*id*/ ESM::RefId(), type); // for CellRef records id is ignored
 
-    mRefIndex.insert(std::make_pair(static_cast<Record<CellRef>*>(record.get())->get().mIdNum, index));
-
-    Collection<CellRef>::insertRecord(std::move(record), index, type); // add records only
-}
-
-void CSMWorld::RefCollection::insertRecord(std::unique_ptr<RecordBase> record, int index, UniversalId::Type type)
-{
-    int size = getAppendIndex(/*id*/ ESM::RefId(), type); // for CellRef records id is ignored
-    unsigned int idNum = static_cast<Record<CellRef>*>(record.get())->get().mIdNum;
-
-    Collection<CellRef>::insertRecord(std::move(record), index, type); // add records only
-
-    if (index < size - 1)
-    {
-        for (std::map<unsigned int, int>::iterator iter(mRefIndex.begin()); iter != mRefIndex.end(); ++iter)
-        {
-            if (iter->second >= index)
-                ++(iter->second);
-        }
-    }
-
-    mRefIndex.insert(std::make_pair(idNum, index));
+    insertRecord(std::move(record), index, type);
 }
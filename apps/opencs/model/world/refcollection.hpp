@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <apps/opencs/model/world/universalid.hpp>
@@ -28,17 +29,11 @@ namespace CSMWorld
 {
     struct Cell;
 
-    template <>
-    void Collection<CellRef>::removeRows(int index, int count);
-
-    template <>
-    void Collection<CellRef>::insertRecord(std::unique_ptr<RecordBase> record, int index, UniversalId::Type type);
-
     /// \brief References in cells
     class RefCollection final : public Collection<CellRef>
     {
         Collection<Cell>& mCells;
-        std::map<unsigned int, int> mRefIndex; // CellRef index keyed by CSMWorld::CellRef::mIdNum
+        std::unordered_map<unsigned int, int> mRefIndex; // CellRef index keyed by CSMWorld::CellRef::mIdNum
 
         int mNextId;
         uint32_t mHighestUsedRefNum = 0;
@@ -51,6 +46,10 @@ namespace CSMWorld
 
         int searchId(unsigned int id) const;
 
+        void eraseIndex(int begin, int end) override;
+
+        void updateIndex(int begin, int end) override;
+
     public:
         // MSVC needs the constructor for a class inheriting a template to be defined in header
         RefCollection(Collection<Cell>& cells)
@@ -65,8 +64,6 @@ namespace CSMWorld
 
         std::string getNewId();
 
-        void removeRows(int index, int count) override;
-
         void appendBlankRecord(const ESM::RefId& id, UniversalId::Type type = UniversalId::Type_None) override;
 
         void cloneRecord(
@@ -75,9 +72,6 @@ namespace CSMWorld
         int searchId(const ESM::RefId& id) const override;
 
         void appendRecord(std::unique_ptr<RecordBase> record, UniversalId::Type type = UniversalId::Type_None) override;
-
-        void insertRecord(
-            std::unique_ptr<RecordBase> record, int index, UniversalId::Type type = UniversalId::Type_None) override;
     };
 }
 
@@ -3,10 +3,15 @@
 
 #include <gtest/gtest.h>
 
+#include <QCoreApplication>
+
 int main(int argc, char* argv[])
 {
     Log::sMinDebugLevel = Debug::getDebugLevel();
 
+    // Operations are driven by timers and thread pools which need an application instance
+    QCoreApplication application(argc, argv);
+
     testing::InitGoogleTest(&argc, argv);
 
     const int result = RUN_ALL_TESTS();
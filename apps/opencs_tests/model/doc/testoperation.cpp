@@ -0,0 +1,181 @@
+#include "apps/opencs/model/doc/messages.hpp"
+#include "apps/opencs/model/doc/operation.hpp"
+#include "apps/opencs/model/doc/stage.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <QEventLoop>
+#include <QTimer>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace CSMDoc
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct StubStage final : Stage
+        {
+            const std::string mName;
+            const int mSteps;
+            const bool mThreadSafe;
+            std::optional<int> mThrowAt;
+            std::chrono::microseconds mDelay{ 0 };
+            std::atomic_int mPerformed{ 0 };
+
+            explicit StubStage(std::string name, int steps, bool threadSafe)
+                : mName(std::move(name))
+                , mSteps(steps)
+                , mThreadSafe(threadSafe)
+            {
+            }
+
+            int setup() override { return mSteps; }
+
+            void perform(int step, Messages& messages) override
+            {
+                if (step == mThrowAt)
+                    throw std::runtime_error(mName + " has failed");
+                // Later steps are faster, so tasks are likely to be done out of order
+                std::this_thread::sleep_for(mDelay * (mSteps - step));
+                messages.add(CSMWorld::UniversalId(), mName + " " + std::to_string(step));
+                ++mPerformed;
+            }
+
+            bool isThreadSafe() const override { return mThreadSafe; }
+        };
+
+        struct Result
+        {
+            std::vector<Message> mMessages;
+            std::optional<bool> mFailed;
+        };
+
+        struct CSMDocOperationTest : Test
+        {
+            Operation mOperation;
+
+            explicit CSMDocOperationTest(bool finalAlways = false)
+                : mOperation(State_Verifying, true, finalAlways)
+            {
+                mOperation.setParallel(true);
+            }
+
+            StubStage& addStage(const std::string& name, int steps, bool threadSafe)
+            {
+                auto* const stage = new StubStage(name, steps, threadSafe);
+                mOperation.appendStage(stage);
+                return *stage;
+            }
+
+            Result run()
+            {
+                Result result;
+                QEventLoop loop;
+                QObject::connect(&mOperation, &Operation::reportMessage,
+                    [&](const Message& message, int /*type*/) { result.mMessages.push_back(message); });
+                QObject::connect(&mOperation, &Operation::done, &loop, [&](int /*type*/, bool failed) {
+                    result.mFailed = failed;
+                    loop.quit();
+                });
+                QTimer::singleShot(std::chrono::seconds(10), &loop, &QEventLoop::quit);
+                mOperation.run();
+                loop.exec();
+                return result;
+            }
+        };
+
+        struct CSMDocOperationFinalAlwaysTest : CSMDocOperationTest
+        {
+            CSMDocOperationFinalAlwaysTest()
+                : CSMDocOperationTest(true)
+            {
+            }
+        };
+
+        std::vector<std::string> getTexts(const std::vector<Message>& messages)
+        {
+            std::vector<std::string> result;
+            for (const Message& message : messages)
+                result.push_back(message.mMessage);
+            return result;
+        }
+
+        TEST_F(CSMDocOperationTest, parallelShouldReportMessagesInSequentialOrder)
+        {
+            addStage("a", 64, true).mDelay = std::chrono::microseconds(10);
+            addStage("b", 3, false);
+            addStage("c", 64, true).mDelay = std::chrono::microseconds(10);
+
+            std::vector<std::string> expected;
+            for (int i = 0; i < 64; ++i)
+                expected.push_back("a " + std::to_string(i));
+            for (int i = 0; i < 3; ++i)
+                expected.push_back("b " + std::to_string(i));
+            for (int i = 0; i < 64; ++i)
+                expected.push_back("c " + std::to_string(i));
+
+            const Result result = run();
+            EXPECT_EQ(result.mFailed, false);
+            EXPECT_THAT(getTexts(result.mMessages), ElementsAreArray(expected));
+            EXPECT_FALSE(mOperation.hasError());
+        }
+
+        TEST_F(CSMDocOperationTest, parallelShouldStopTasksOnAbortAndComplete)
+        {
+            StubStage& stage = addStage("a", 1000, false);
+            stage.mDelay = std::chrono::microseconds(1);
+            QObject::connect(&mOperation, &Operation::progress, &mOperation, &Operation::abort);
+
+            const Result result = run();
+            EXPECT_EQ(result.mFailed, true);
+            EXPECT_LT(stage.mPerformed, 1000);
+            EXPECT_TRUE(mOperation.hasError());
+        }
+
+        TEST_F(CSMDocOperationTest, parallelShouldSetErrorWhenTaskThrows)
+        {
+            addStage("a", 100, true).mThrowAt = 50;
+
+            const Result result = run();
+            EXPECT_EQ(result.mFailed, true);
+            EXPECT_TRUE(mOperation.hasError());
+            EXPECT_THAT(result.mMessages,
+                Contains(AllOf(Field(&Message::mMessage, "a has failed"),
+                    Field(&Message::mSeverity, Message::Severity_SeriousError))));
+        }
+
+        TEST_F(CSMDocOperationFinalAlwaysTest, parallelShouldPerformLastStageAfterAbort)
+        {
+            StubStage& first = addStage("a", 1000, false);
+            first.mDelay = std::chrono::microseconds(1);
+            StubStage& last = addStage("b", 1000, true);
+            last.mDelay = std::chrono::microseconds(1);
+            QObject::connect(&mOperation, &Operation::progress, &mOperation, &Operation::abort);
+
+            const Result result = run();
+            EXPECT_EQ(result.mFailed, true);
+            EXPECT_LT(first.mPerformed, 1000);
+            EXPECT_EQ(last.mPerformed, 1000);
+        }
+
+        TEST_F(CSMDocOperationFinalAlwaysTest, parallelShouldPerformLastStageWhenTaskThrows)
+        {
+            addStage("a", 100, true).mThrowAt = 0;
+            StubStage& last = addStage("b", 100, true);
+
+            const Result result = run();
+            EXPECT_EQ(result.mFailed, true);
+            EXPECT_EQ(last.mPerformed, 100);
+        }
+    }
+}
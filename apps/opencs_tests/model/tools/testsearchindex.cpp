@@ -0,0 +1,248 @@
+#include "apps/opencs/model/tools/searchindex.hpp"
+#include "apps/opencs/model/world/columnbase.hpp"
+#include "apps/opencs/model/world/idtablebase.hpp"
+#include "apps/opencs/model/world/universalid.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <QVariant>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CSMTools
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        using Row = std::array<QString, 3>;
+
+        // ID and text columns are indexed, the last one is not
+        class StubTable final : public CSMWorld::IdTableBase
+        {
+        public:
+            std::vector<Row> mRows;
+
+            StubTable()
+                : IdTableBase(0)
+            {
+            }
+
+            QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override
+            {
+                if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+                    return QModelIndex();
+                return createIndex(row, column);
+            }
+
+            QModelIndex parent(const QModelIndex& /*index*/) const override { return QModelIndex(); }
+
+            int rowCount(const QModelIndex& parent = QModelIndex()) const override
+            {
+                return parent.isValid() ? 0 : static_cast<int>(mRows.size());
+            }
+
+            int columnCount(const QModelIndex& parent = QModelIndex()) const override
+            {
+                return parent.isValid() ? 0 : static_cast<int>(std::tuple_size_v<Row>);
+            }
+
+            QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+            {
+                if (!index.isValid() || role != Qt::DisplayRole)
+                    return QVariant();
+                return mRows[index.row()][index.column()];
+            }
+
+            QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+            {
+                if (orientation != Qt::Horizontal || role != CSMWorld::ColumnBase::Role_Display)
+                    return QVariant();
+                constexpr std::array displays{ CSMWorld::ColumnBase::Display_Id, CSMWorld::ColumnBase::Display_String,
+                    CSMWorld::ColumnBase::Display_Integer };
+                return static_cast<int>(displays.at(section));
+            }
+
+            QModelIndex getModelIndex(const std::string& /*id*/, int /*column*/) const override
+            {
+                return QModelIndex();
+            }
+
+            int searchColumnIndex(CSMWorld::Columns::ColumnId /*id*/) const override { return -1; }
+
+            int findColumnIndex(CSMWorld::Columns::ColumnId /*id*/) const override
+            {
+                throw std::logic_error("Not implemented");
+            }
+
+            std::pair<CSMWorld::UniversalId, std::string> view(int /*row*/) const override
+            {
+                return std::make_pair(CSMWorld::UniversalId::Type_None, "");
+            }
+
+            bool isDeleted(const std::string& /*id*/) const override { return false; }
+
+            int getColumnId(int /*column*/) const override { return -1; }
+
+            void setText(int row, int column, const QString& value)
+            {
+                mRows[row][column] = value;
+                emit dataChanged(index(row, column), index(row, column));
+            }
+
+            void addRows(int row, const std::vector<Row>& rows)
+            {
+                beginInsertRows(QModelIndex(), row, row + static_cast<int>(rows.size()) - 1);
+                mRows.insert(mRows.begin() + row, rows.begin(), rows.end());
+                endInsertRows();
+            }
+
+            void eraseRows(int row, int count)
+            {
+                beginRemoveRows(QModelIndex(), row, row + count - 1);
+                mRows.erase(mRows.begin() + row, mRows.begin() + row + count);
+                endRemoveRows();
+            }
+        };
+
+        std::vector<int> scan(const StubTable& table, const QString& text)
+        {
+            std::vector<int> result;
+            for (std::size_t row = 0; row < table.mRows.size(); ++row)
+                if (table.mRows[row][0].contains(text, Qt::CaseInsensitive)
+                    || table.mRows[row][1].contains(text, Qt::CaseInsensitive))
+                    result.push_back(static_cast<int>(row));
+            return result;
+        }
+
+        // A text of 3 characters consists of a single trigram, so the index has to provide exactly the matching rows.
+        // Values of the not indexed column must not be found.
+        const std::array queries{ "swo", "SWO", "ron", "dag", "arm", "_01", "eel", "xyz", "399" };
+
+        struct CSMToolsSearchIndexTest : Test
+        {
+            StubTable mTable;
+            SearchIndex mIndex{ &mTable };
+
+            CSMToolsSearchIndexTest()
+            {
+                mTable.mRows = {
+                    Row{ "iron_sword_01", "Iron Sword", "199" },
+                    Row{ "steel_dagger_01", "Steel Dagger", "299" },
+                    Row{ "glass_armor", "Glass Armor", "399" },
+                    Row{ "iron_dagger", "Iron Dagger", "499" },
+                };
+            }
+
+            void expectMatchesFullScan()
+            {
+                for (const char* query : queries)
+                {
+                    SCOPED_TRACE(query);
+                    const std::optional<std::vector<int>> rows = mIndex.findRows(query);
+                    ASSERT_TRUE(rows.has_value());
+                    EXPECT_EQ(*rows, scan(mTable, query));
+                }
+            }
+        };
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldMatchFullScan)
+        {
+            expectMatchesFullScan();
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldProvideAllRowsContainingLongerText)
+        {
+            const std::optional<std::vector<int>> rows = mIndex.findRows("Iron D");
+            ASSERT_TRUE(rows.has_value());
+            EXPECT_THAT(scan(mTable, "Iron D"), IsSubsetOf(*rows));
+            EXPECT_THAT(*rows, Not(Contains(0)));
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldReturnNulloptForTextShorterThanTrigram)
+        {
+            EXPECT_EQ(mIndex.findRows(""), std::nullopt);
+            EXPECT_EQ(mIndex.findRows("i"), std::nullopt);
+            EXPECT_EQ(mIndex.findRows("ir"), std::nullopt);
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldMatchFullScanAfterEdit)
+        {
+            expectMatchesFullScan();
+            mTable.setText(2, 1, "Glass Sword");
+            mTable.setText(0, 0, "steel_axe");
+            expectMatchesFullScan();
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldIgnoreEditOfNotIndexedColumn)
+        {
+            expectMatchesFullScan();
+            mTable.setText(1, 2, "sword");
+            EXPECT_EQ(mIndex.findRows("swo"), std::vector<int>{ 0 });
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldMatchFullScanAfterRemoval)
+        {
+            expectMatchesFullScan();
+            mTable.eraseRows(1, 2);
+            expectMatchesFullScan();
+            mTable.eraseRows(0, 1);
+            expectMatchesFullScan();
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldMatchFullScanAfterInsertion)
+        {
+            expectMatchesFullScan();
+            mTable.addRows(1, { Row{ "ebony_sword", "Ebony Sword", "599" }, Row{ "bonemold_armor", "Armor", "" } });
+            mTable.addRows(static_cast<int>(mTable.mRows.size()), { Row{ "xyz", "Unknown", "" } });
+            expectMatchesFullScan();
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldMatchFullScanWhenHandlesOfRemovedRowsAreReused)
+        {
+            expectMatchesFullScan();
+            mTable.eraseRows(0, 3);
+            mTable.addRows(1, { Row{ "steel_sword", "Steel Sword", "" }, Row{ "glass_dagger", "Glass Dagger", "" } });
+            expectMatchesFullScan();
+            mTable.addRows(0, { Row{ "daedric_armor", "Daedric Armor", "" }, Row{ "ir", "on", "" } });
+            expectMatchesFullScan();
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldRebuildIndexWhenRowCountChangesWithoutSignals)
+        {
+            expectMatchesFullScan();
+            mTable.mRows.push_back(Row{ "silver_sword", "Silver Sword", "" });
+            expectMatchesFullScan();
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, findRowsShouldReturnNulloptWhenLimitOfEntriesIsExceeded)
+        {
+            const std::size_t totalEntries = SearchIndex::getTotalEntries();
+            SearchIndex index(&mTable, totalEntries + 10);
+            EXPECT_EQ(index.findRows("swo"), std::nullopt);
+            EXPECT_EQ(SearchIndex::getTotalEntries(), totalEntries);
+            mTable.addRows(0, { Row{ "steel_sword", "Steel Sword", "" } });
+            EXPECT_EQ(index.findRows("swo"), std::nullopt);
+            EXPECT_EQ(SearchIndex::getTotalEntries(), totalEntries);
+        }
+
+        TEST_F(CSMToolsSearchIndexTest, destructorShouldReleaseEntries)
+        {
+            const std::size_t totalEntries = SearchIndex::getTotalEntries();
+            {
+                SearchIndex index(&mTable);
+                ASSERT_TRUE(index.findRows("swo").has_value());
+                EXPECT_GT(SearchIndex::getTotalEntries(), totalEntries);
+            }
+            EXPECT_EQ(SearchIndex::getTotalEntries(), totalEntries);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include "apps/opencs/model/world/collection.hpp"
+
+#include "components/esm3/loadglob.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CSMWorld
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        std::unique_ptr<Record<ESM::Global>> makeRecord(
+            std::string_view id, RecordBase::State state = RecordBase::State_ModifiedOnly)
+        {
+            auto record = std::make_unique<Record<ESM::Global>>();
+            record->mState = state;
+            record->mModified.blank();
+            record->mModified.mId = ESM::RefId::stringRefId(id);
+            record->mBase = record->mModified;
+            return record;
+        }
+
+        std::vector<std::string> getIdsByRow(const Collection<ESM::Global>& collection)
+        {
+            std::vector<std::string> result;
+            for (int i = 0; i < collection.getSize(); ++i)
+                result.push_back(collection.getId(i).getRefIdString());
+            return result;
+        }
+
+        void expectIndexMatchesRows(const Collection<ESM::Global>& collection)
+        {
+            for (int i = 0; i < collection.getSize(); ++i)
+                EXPECT_EQ(collection.searchId(collection.getId(i)), i) << collection.getId(i);
+        }
+
+        struct CSMWorldCollectionTest : Test
+        {
+            Collection<ESM::Global> mCollection;
+
+            CSMWorldCollectionTest()
+            {
+                for (const std::string_view id : { "a", "b", "c", "d" })
+                    mCollection.appendRecord(makeRecord(id));
+            }
+        };
+
+        TEST_F(CSMWorldCollectionTest, insertRecordShouldUpdateIndexOfFollowingRecords)
+        {
+            mCollection.insertRecord(makeRecord("e"), 1);
+            EXPECT_THAT(getIdsByRow(mCollection), ElementsAre("a", "e", "b", "c", "d"));
+            expectIndexMatchesRows(mCollection);
+        }
+
+        TEST_F(CSMWorldCollectionTest, insertRecordBeforeLastShouldUpdateIndexOfLastRecord)
+        {
+            mCollection.insertRecord(makeRecord("e"), 3);
+            EXPECT_THAT(getIdsByRow(mCollection), ElementsAre("a", "b", "c", "e", "d"));
+            expectIndexMatchesRows(mCollection);
+        }
+
+        TEST_F(CSMWorldCollectionTest, removeRowsShouldRemoveRecordsFromIndex)
+        {
+            mCollection.removeRows(1, 2);
+            EXPECT_THAT(getIdsByRow(mCollection), ElementsAre("a", "d"));
+            EXPECT_EQ(mCollection.searchId(ESM::RefId::stringRefId("b")), -1);
+            EXPECT_EQ(mCollection.searchId(ESM::RefId::stringRefId("c")), -1);
+            expectIndexMatchesRows(mCollection);
+        }
+
+        TEST_F(CSMWorldCollectionTest, mergeShouldRemoveDeletedRecords)
+        {
+            mCollection.replace(0, makeRecord("a", RecordBase::State_Deleted));
+            mCollection.replace(2, makeRecord("c", RecordBase::State_Deleted));
+            mCollection.merge();
+            EXPECT_THAT(getIdsByRow(mCollection), ElementsAre("b", "d"));
+            EXPECT_EQ(mCollection.searchId(ESM::RefId::stringRefId("a")), -1);
+            EXPECT_EQ(mCollection.searchId(ESM::RefId::stringRefId("c")), -1);
+            expectIndexMatchesRows(mCollection);
+        }
+
+        TEST_F(CSMWorldCollectionTest, getIdsShouldReturnSortedIds)
+        {
+            mCollection.insertRecord(makeRecord("0"), 2);
+            mCollection.replace(1, makeRecord("b", RecordBase::State_Deleted));
+            const auto id = [](std::string_view value) { return ESM::RefId::stringRefId(value); };
+            EXPECT_THAT(mCollection.getIds(), ElementsAre(id("0"), id("a"), id("b"), id("c"), id("d")));
+            EXPECT_THAT(mCollection.getIds(false), ElementsAre(id("0"), id("a"), id("c"), id("d")));
+        }
+    }
+}
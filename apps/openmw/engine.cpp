@@ -2,7 +2,9 @@
 
 #include <cerrno>
 #include <chrono>
+#include <fstream>
 #include <future>
+#include <optional>
 #include <system_error>
 
 #include <osgDB/ReaderWriter>
@@ -13,6 +15,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/trace.hpp>
 
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/format.hpp>
@@ -21,6 +24,8 @@
 #include <components/vfs/registerarchives.hpp>
 
 #include <components/sdlutil/imagetosurface.hpp>
+#include <components/sdlutil/inputrecord.hpp>
+#include <components/sdlutil/sdlinputwrapper.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
 #include <components/resource/resourcesystem.hpp>
@@ -44,6 +49,7 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 
 #include <components/misc/frameratelimiter.hpp>
+#include <components/misc/hash.hpp>
 
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -62,6 +68,8 @@
 #include "mwlua/worker.hpp"
 
 #include "mwscript/interpretercontext.hpp"
+#include "mwscript/localscriptscheduler.hpp"
+#include "mwscript/locals.hpp"
 #include "mwscript/scriptmanagerimp.hpp"
 
 #include "mwsound/constants.hpp"
@@ -83,6 +91,7 @@
 
 #include "mwstate/statemanagerimp.hpp"
 
+#include "frametimings.hpp"
 #include "profile.hpp"
 
 namespace
@@ -164,6 +173,30 @@ namespace
         int mMaxTextureImageUnits = 0;
     };
 
+    MWScript::LocalScriptSchedulerSettings makeLocalScriptSchedulerSettings()
+    {
+        MWScript::LocalScriptSchedulerSettings result;
+        result.mEnabled = Settings::game().mScheduleLocalScripts;
+        result.mFullRateDistance = Settings::game().mLocalScriptsFullRateDistance;
+        result.mThrottleIdle = Settings::game().mThrottleIdleLocalScripts;
+        result.mFrameBudget = Settings::game().mLocalScriptsFrameBudget / 1000;
+        for (const std::string& script : Settings::game().mUnscheduledLocalScripts.get())
+            result.mUnscheduled.insert(ESM::RefId::stringRefId(script));
+        return result;
+    }
+
+    std::size_t hashLocals(const MWScript::Locals& locals)
+    {
+        std::size_t result = 0;
+        for (Interpreter::Type_Short value : locals.mShorts)
+            Misc::hashCombine(result, value);
+        for (Interpreter::Type_Integer value : locals.mLongs)
+            Misc::hashCombine(result, value);
+        for (Interpreter::Type_Float value : locals.mFloats)
+            Misc::hashCombine(result, value);
+        return result;
+    }
+
     void reportStats(unsigned frameNumber, osgViewer::Viewer& viewer, std::ostream& stream)
     {
         viewer.getViewerStats()->report(stream, frameNumber);
@@ -172,23 +205,100 @@ namespace
         for (osg::Camera* camera : cameras)
             camera->getStats()->report(stream, frameNumber);
     }
+
+    // Runs event and update traversals as usual but never culls or draws, so nothing is submitted to the GPU.
+    // Applies to every caller including loading screen, message boxes and videos. Anything done by cull callbacks,
+    // such as terrain view building and object paging, is skipped too.
+    class HeadlessViewer final : public osgViewer::Viewer
+    {
+    public:
+        void renderingTraversals() override {}
+    };
+
+    // Offscreen driver does not need a display server and creates OpenGL contexts via EGL. A driver explicitly
+    // requested through SDL_VIDEODRIVER environment variable is respected.
+    void initHeadlessVideo()
+    {
+        if (SDL_getenv("SDL_VIDEODRIVER") != nullptr)
+            return;
+        SDL_VideoQuit();
+        if (SDL_VideoInit("offscreen") == 0)
+            return;
+        Log(Debug::Warning) << "Failed to initialize offscreen video driver: " << SDL_GetError()
+                            << ". Using default one.";
+        if (SDL_VideoInit(nullptr) != 0)
+            throw std::runtime_error("Could not initialize SDL video! " + std::string(SDL_GetError()));
+    }
 }
 
-void OMW::Engine::executeLocalScripts()
+void OMW::Engine::executeLocalScripts(float frametime)
 {
     MWWorld::LocalScripts& localScripts = mWorld->getLocalScripts();
+    MWScript::LocalScriptScheduler& scheduler = mScriptManager->getLocalScriptScheduler();
+    const MWScript::LocalScriptSchedulerSettings& settings = scheduler.getSettings();
+    const bool collectStats = scheduler.getCollectStats() || mViewer->getViewerStats()->collectStats("resource");
+    std::pair<ESM::RefId, MWWorld::Ptr> script;
 
     localScripts.startIteration();
-    std::pair<ESM::RefId, MWWorld::Ptr> script;
+
+    if (!settings.mEnabled && !collectStats)
+    {
+        scheduler.clearInstances();
+
+        while (localScripts.getNext(script))
+        {
+            MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
+            mScriptManager->run(script.first, interpreterContext);
+        }
+
+        return;
+    }
+
+    const bool detectIdle = settings.mEnabled && settings.mThrottleIdle;
+    const bool measureTime = collectStats || settings.mFrameBudget > 0;
+    const osg::Vec3f playerPosition = mWorld->getPlayerPtr().getRefData().getPosition().asVec3();
+
+    scheduler.beginFrame(frametime);
+
     while (localScripts.getNext(script))
     {
-        MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
+        const MWWorld::Ptr& ptr = script.second;
+        const float distance = ptr.getContainerStore() != nullptr
+            ? 0
+            : (ptr.getRefData().getPosition().asVec3() - playerPosition).length();
+        const std::optional<float> secondsPassed
+            = scheduler.schedule(script.first, ptr.mRef, distance, ptr.getRefData().isActivationPending());
+        if (!secondsPassed.has_value())
+            continue;
+
+        MWScript::Locals& locals = ptr.getRefData().getLocals();
+        const std::size_t localsHash = detectIdle ? hashLocals(locals) : 0;
+
+        // Scripts use the frame duration for timers and movement
+        mEnvironment.setFrameDuration(*secondsPassed);
+
+        std::chrono::steady_clock::time_point start;
+        if (measureTime)
+            start = std::chrono::steady_clock::now();
+
+        MWScript::InterpreterContext interpreterContext(&locals, ptr);
         mScriptManager->run(script.first, interpreterContext);
+
+        std::chrono::duration<double> time{ 0 };
+        if (measureTime)
+            time = std::chrono::steady_clock::now() - start;
+
+        scheduler.finish(script.first, ptr.mRef, time.count(), detectIdle && hashLocals(locals) != localsHash);
     }
+
+    mEnvironment.setFrameDuration(frametime);
+
+    scheduler.endFrame();
 }
 
 bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 {
+    const Debug::Trace::Scope trace("Engine::frame");
     const osg::Timer_t frameStart = mViewer->getStartTick();
     const osg::Timer* const timer = osg::Timer::instance();
     osg::Stats* const stats = mViewer->getViewerStats();
@@ -248,7 +358,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
                     if (mWorld->getScriptsEnabled())
                     {
                         // local scripts
-                        executeLocalScripts();
+                        executeLocalScripts(frametime);
 
                         // global scripts
                         mScriptManager->getGlobalScripts().run();
@@ -334,6 +444,12 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
 
+        const MWScript::LocalScriptScheduler::FrameStats& localScriptStats
+            = mScriptManager->getLocalScriptScheduler().getFrameStats();
+        stats->setAttribute(frameNumber, "Local Scripts Run", static_cast<double>(localScriptStats.mRuns));
+        stats->setAttribute(frameNumber, "Local Scripts Skipped", static_cast<double>(localScriptStats.mSkips));
+        stats->setAttribute(frameNumber, "Local Scripts Deferred", static_cast<double>(localScriptStats.mDeferred));
+
         stats->setAttribute(frameNumber, "StringRefId Count", static_cast<double>(ESM::StringRefId::totalCount()));
     }
 
@@ -367,11 +483,13 @@ OMW::Engine::Engine(Files::ConfigurationManager& configurationManager)
     , mStereoManager(nullptr)
     , mSkipMenu(false)
     , mUseSound(true)
+    , mHeadless(false)
     , mCompileAll(false)
     , mCompileAllDialogue(false)
     , mWarningsMode(1)
     , mScriptConsoleMode(false)
     , mActivationDistanceOverride(-1)
+    , mReplayFixedStep(0)
     , mGrab(true)
     , mExportFonts(false)
     , mRandomSeed(0)
@@ -507,7 +625,13 @@ void OMW::Engine::createWindow()
     }
 
     Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
-    if (windowMode == Settings::WindowMode::Fullscreen)
+    if (mHeadless)
+    {
+        // OpenGL context is still required to query capabilities the scene setup depends on
+        initHeadlessVideo();
+        flags = SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
+    }
+    else if (windowMode == Settings::WindowMode::Fullscreen)
         flags |= SDL_WINDOW_FULLSCREEN;
     else if (windowMode == Settings::WindowMode::WindowedFullscreen)
         flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
@@ -765,7 +889,8 @@ void OMW::Engine::prepareEngine()
     mL10nManager->setPreferredLocales(Settings::general().mPreferredLocales, Settings::general().mGmstOverridesL10n);
     mEnvironment.setL10nManager(*mL10nManager);
 
-    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
+    mLuaManager = std::make_unique<MWLua::LuaManager>(
+        mVFS.get(), mResDir / "lua_libs", mCfgMgr.getCachePath(), mWorkQueue.get());
     mEnvironment.setLuaManager(*mLuaManager);
 
     // Create input and UI first to set up a bootstrapping environment for
@@ -863,6 +988,12 @@ void OMW::Engine::prepareEngine()
     listener->loadingOff();
 
     mWorld->init(mMaxRecastLogLevel, mViewer, std::move(rootNode), mWorkQueue.get(), *mUnrefQueue);
+    if (mHeadless)
+    {
+        // Objects queued for compilation would never be compiled and released without draw traversal
+        mViewer->setIncrementalCompileOperation(nullptr);
+        mResourceSystem->getSceneManager()->setIncrementalCompileOperation(nullptr);
+    }
     mEnvironment.setWorldScene(mWorld->getWorldScene());
     mWorld->setupPlayer();
     mWorld->setRandomSeed(mRandomSeed);
@@ -894,6 +1025,7 @@ void OMW::Engine::prepareEngine()
 
     mScriptManager = std::make_unique<MWScript::ScriptManager>(mWorld->getStore(), *mScriptContext, mWarningsMode);
     mEnvironment.setScriptManager(*mScriptManager);
+    mScriptManager->getLocalScriptScheduler().setSettings(makeLocalScriptSchedulerSettings());
 
     // Create game mechanics system
     mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>();
@@ -940,6 +1072,21 @@ void OMW::Engine::go()
     Log(Debug::Info) << "SDL version: " << (int)sdlVersion.major << "." << (int)sdlVersion.minor << "."
                      << (int)sdlVersion.patch;
 
+    std::optional<SDLUtil::InputRecordReader> inputReplay;
+    if (!mInputReplayFile.empty())
+    {
+        inputReplay.emplace(mInputReplayFile);
+        mRandomSeed = inputReplay->getSeed();
+        Log(Debug::Info) << "Input will be replayed from: " << mInputReplayFile;
+    }
+
+    std::optional<SDLUtil::InputRecordWriter> inputRecord;
+    if (!mInputRecordFile.empty())
+    {
+        inputRecord.emplace(mInputRecordFile, mRandomSeed);
+        Log(Debug::Info) << "Input will be recorded to: " << mInputRecordFile;
+    }
+
     Misc::Rng::init(mRandomSeed);
 
     Settings::ShaderManager::get().load(mCfgMgr.getUserConfigPath() / "shaders.yaml");
@@ -950,7 +1097,10 @@ void OMW::Engine::go()
     mEncoder = std::make_unique<ToUTF8::Utf8Encoder>(mEncoding);
 
     // Setup viewer
-    mViewer = new osgViewer::Viewer;
+    if (mHeadless)
+        mViewer = new HeadlessViewer;
+    else
+        mViewer = new osgViewer::Viewer;
     mViewer->setReleaseContextAtEndOfFrameHint(false);
 
     // Do not try to outsmart the OS thread scheduler (see bug #4785).
@@ -960,6 +1110,10 @@ void OMW::Engine::go()
 
     prepareEngine();
 
+    SDLUtil::InputWrapper& inputWrapper = mInputManager->getInputWrapper();
+    inputWrapper.setRecord(inputRecord.has_value());
+    inputWrapper.setReplay(inputReplay.has_value());
+
 #ifdef _WIN32
     const auto* statsFile = _wgetenv(L"OPENMW_OSG_STATS_FILE");
 #else
@@ -991,9 +1145,27 @@ void OMW::Engine::go()
     osg::ref_ptr<Resource::StatsHandler> resourcesHandler = new Resource::StatsHandler(stats.is_open(), *mVFS);
     mViewer->addEventHandler(resourcesHandler);
 
-    if (stats.is_open())
+    std::optional<FrameTimings> timings;
+    if (!mTimingsSummaryFile.empty())
+        timings.emplace();
+
+    if (stats.is_open() || timings.has_value())
         Resource::collectStatistics(*mViewer);
 
+#ifdef _WIN32
+    const auto* traceFile = _wgetenv(L"OPENMW_TRACE_FILE");
+#else
+    const auto* traceFile = std::getenv("OPENMW_TRACE_FILE");
+#endif
+
+    if (traceFile != nullptr)
+    {
+        Debug::Trace::setFile(traceFile);
+        Debug::Trace::setThreadName("Main");
+        Debug::Trace::setEnabled(true);
+        Log(Debug::Info) << "Trace will be written to: " << Debug::Trace::getFile();
+    }
+
     // Start the game
     if (!mSaveGameFile.empty())
     {
@@ -1027,18 +1199,38 @@ void OMW::Engine::go()
     MWWorld::DateTimeManager& timeManager = *mWorld->getTimeManager();
     Misc::FrameRateLimiter frameRateLimiter = Misc::makeFrameRateLimiter(mEnvironment.getFrameRateLimit());
     const std::chrono::steady_clock::duration maxSimulationInterval(std::chrono::milliseconds(200));
+    SDLUtil::InputRecordFrame replayedFrame;
     while (!mViewer->done() && !mStateManager->hasQuitRequest())
     {
-        const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(
-                              std::min(frameRateLimiter.getLastFrameDuration(), maxSimulationInterval))
-                              .count()
-            * timeManager.getSimulationTimeScale();
+        const std::chrono::steady_clock::duration lastFrameDuration
+            = std::min(frameRateLimiter.getLastFrameDuration(), maxSimulationInterval);
+        float frameDuration = std::chrono::duration<float>(lastFrameDuration).count();
+
+        if (inputReplay.has_value())
+        {
+            if (!inputReplay->read(replayedFrame))
+            {
+                Log(Debug::Info) << "Input replay is finished";
+                break;
+            }
+            // Recorded or fixed duration makes the simulation independent from the time frames actually take
+            frameDuration = mReplayFixedStep > 0 ? mReplayFixedStep : replayedFrame.mDuration;
+            inputWrapper.addReplayedEvents(replayedFrame.mEvents);
+            inputWrapper.setReplayedPolls(replayedFrame.mPolls);
+        }
+
+        const double dt = frameDuration * timeManager.getSimulationTimeScale();
 
         mViewer->advance(timeManager.getRenderingSimulationTime());
 
         const unsigned frameNumber = mViewer->getFrameStamp()->getFrameNumber();
 
-        if (!frame(frameNumber, static_cast<float>(dt)))
+        const bool frameDone = frame(frameNumber, static_cast<float>(dt));
+
+        if (inputRecord.has_value())
+            inputRecord->write(frameDuration, inputWrapper.takeRecordedEvents(), inputWrapper.takeRecordedPolls());
+
+        if (!frameDone)
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
             continue;
@@ -1050,7 +1242,7 @@ void OMW::Engine::go()
             timeManager.setRenderingSimulationTime(timeManager.getRenderingSimulationTime() + dt);
         }
 
-        if (stats)
+        if (stats || timings.has_value())
         {
             // The delay is required because rendering happens in parallel to the main thread and stats from there is
             // available with delay.
@@ -1061,7 +1253,12 @@ void OMW::Engine::go()
                 // frames inside a simulation frame.
                 const unsigned currentFrameNumber = mViewer->getFrameStamp()->getFrameNumber();
                 for (unsigned i = frameNumber; i <= currentFrameNumber; ++i)
-                    reportStats(i - statsReportDelay, *mViewer, stats);
+                {
+                    if (stats)
+                        reportStats(i - statsReportDelay, *mViewer, stats);
+                    if (timings.has_value())
+                        timings->add(*mViewer->getViewerStats(), i - statsReportDelay);
+                }
             }
         }
 
@@ -1070,6 +1267,24 @@ void OMW::Engine::go()
 
     mLuaWorker->join();
 
+    if (timings.has_value())
+    {
+        std::ofstream summary(mTimingsSummaryFile, std::ios_base::out);
+        if (summary.is_open())
+            timings->write(summary);
+        else
+            Log(Debug::Warning) << "Failed to open file to write timings summary \"" << mTimingsSummaryFile
+                                << "\": " << std::generic_category().message(errno);
+    }
+
+    if (!Debug::Trace::getFile().empty())
+    {
+        Debug::Trace::setEnabled(false);
+        if (!Debug::Trace::writeFile())
+            Log(Debug::Warning) << "Failed to open file to write trace \"" << Debug::Trace::getFile()
+                                << "\": " << std::generic_category().message(errno);
+    }
+
     // Save user settings
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
     Settings::ShaderManager::get().save();
@@ -1091,6 +1306,11 @@ void OMW::Engine::setSoundUsage(bool soundUsage)
     mUseSound = soundUsage;
 }
 
+void OMW::Engine::setHeadless(bool headless)
+{
+    mHeadless = headless;
+}
+
 void OMW::Engine::setEncoding(const ToUTF8::FromType& encoding)
 {
     mEncoding = encoding;
@@ -1130,3 +1350,23 @@ void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
 }
+
+void OMW::Engine::setInputRecordFile(const std::filesystem::path& path)
+{
+    mInputRecordFile = path;
+}
+
+void OMW::Engine::setInputReplayFile(const std::filesystem::path& path)
+{
+    mInputReplayFile = path;
+}
+
+void OMW::Engine::setReplayFixedStep(float value)
+{
+    mReplayFixedStep = value;
+}
+
+void OMW::Engine::setTimingsSummaryFile(const std::filesystem::path& path)
+{
+    mTimingsSummaryFile = path;
+}
@@ -161,6 +161,7 @@ namespace OMW
 
         bool mSkipMenu;
         bool mUseSound;
+        bool mHeadless;
         bool mCompileAll;
         bool mCompileAllDialogue;
         int mWarningsMode;
@@ -169,6 +170,10 @@ namespace OMW
         std::filesystem::path mStartupScript;
         int mActivationDistanceOverride;
         std::filesystem::path mSaveGameFile;
+        std::filesystem::path mInputRecordFile;
+        std::filesystem::path mInputReplayFile;
+        float mReplayFixedStep;
+        std::filesystem::path mTimingsSummaryFile;
         // Grab mouse?
         bool mGrab;
 
@@ -190,7 +195,7 @@ namespace OMW
         Engine(const Engine&);
         Engine& operator=(const Engine&);
 
-        void executeLocalScripts();
+        void executeLocalScripts(float frametime);
 
         bool frame(unsigned frameNumber, float dt);
 
@@ -226,6 +231,9 @@ namespace OMW
         /// Disable or enable all sounds
         void setSoundUsage(bool soundUsage);
 
+        /// Run the frame loop without culling and drawing anything, window is created hidden
+        void setHeadless(bool headless);
+
         /// Skip main menu and go directly into the game
         ///
         /// \param newGame Start a new game instead off dumping the player into the game
@@ -264,6 +272,19 @@ namespace OMW
 
         void setRandomSeed(unsigned int seed);
 
+        /// Write random seed, frame durations and input events into a file to be replayed later.
+        void setInputRecordFile(const std::filesystem::path& path);
+
+        /// Replay a file written with setInputRecordFile instead of handling input from the user. The engine quits
+        /// when the record ends.
+        void setInputReplayFile(const std::filesystem::path& path);
+
+        /// Use the given frame duration in seconds instead of the recorded ones when replaying input, 0 to disable.
+        void setReplayFixedStep(float value);
+
+        /// Write percentiles of each frame profiling stats on exit.
+        void setTimingsSummaryFile(const std::filesystem::path& path);
+
         void setRecastMaxLogLevel(Debug::Level value) { mMaxRecastLogLevel = value; }
     };
 }
@@ -0,0 +1,46 @@
+#include "frametimings.hpp"
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace OMW
+{
+    namespace
+    {
+        // Nearest-rank percentile, values are expected to be sorted
+        double getPercentile(const std::vector<double>& values, std::size_t percent)
+        {
+            if (values.empty())
+                return 0;
+            const std::size_t rank = (percent * values.size() + 99) / 100;
+            return values[std::max<std::size_t>(rank, 1) - 1];
+        }
+    }
+
+    void FrameTimings::add(const osg::Stats& stats, unsigned frameNumber)
+    {
+        std::size_t index = 0;
+        forEachUserStatsValue([&](const UserStats& v) {
+            double value = 0;
+            if (stats.getAttribute(frameNumber, v.mTaken, value))
+                mValues[index].push_back(value);
+            ++index;
+        });
+    }
+
+    void FrameTimings::write(std::ostream& stream) const
+    {
+        constexpr double multiplier = 1000;
+        std::size_t index = 0;
+        std::vector<double> sorted;
+        stream << std::fixed << std::setprecision(3);
+        forEachUserStatsValue([&](const UserStats& v) {
+            sorted = mValues[index++];
+            std::sort(sorted.begin(), sorted.end());
+            stream << v.mTaken << ' ' << sorted.size() << ' ' << getPercentile(sorted, 50) * multiplier << ' '
+                   << getPercentile(sorted, 95) * multiplier << ' ' << getPercentile(sorted, 99) * multiplier << '\n';
+        });
+    }
+}
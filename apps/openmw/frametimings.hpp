@@ -0,0 +1,33 @@
+#ifndef OPENMW_FRAMETIMINGS_H
+#define OPENMW_FRAMETIMINGS_H
+
+#include "profile.hpp"
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace OMW
+{
+    /// Collects time taken by each UserStatsType over frames to report percentiles. Output is meant to be compared
+    /// between runs replaying the same input record.
+    class FrameTimings
+    {
+    public:
+        void add(const osg::Stats& stats, unsigned frameNumber);
+
+        /// Writes a line per UserStatsType: stats name, number of frames, p50, p95 and p99 in milliseconds
+        void write(std::ostream& stream) const;
+
+    private:
+        std::array<std::vector<double>, static_cast<std::size_t>(UserStatsType::Number)> mValues;
+    };
+}
+
+#endif
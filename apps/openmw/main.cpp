@@ -72,7 +72,9 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
 
     MWGui::DebugWindow::startLogRecording();
 
-    engine.setGrabMouse(!variables["no-grab"].as<bool>());
+    const bool headless = variables["headless"].as<bool>();
+    engine.setHeadless(headless);
+    engine.setGrabMouse(!headless && !variables["no-grab"].as<bool>());
 
     // Font encoding settings
     std::string encoding(variables["encoding"].as<std::string>());
@@ -139,8 +141,9 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
 
     // startup-settings
     engine.setCell(variables["start"].as<std::string>());
-    engine.setSkipMenu(variables["skip-menu"].as<bool>(), variables["new-game"].as<bool>());
-    if (!variables["skip-menu"].as<bool>() && variables["new-game"].as<bool>())
+    const bool skipMenu = headless || variables["skip-menu"].as<bool>();
+    engine.setSkipMenu(skipMenu, variables["new-game"].as<bool>());
+    if (!skipMenu && variables["new-game"].as<bool>())
         Log(Debug::Warning) << "Warning: new-game used without skip-menu -> ignoring it";
 
     // scripts
@@ -153,10 +156,14 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
 
     // other settings
     Fallback::Map::init(variables["fallback"].as<Fallback::FallbackMap>().mMap);
-    engine.setSoundUsage(!variables["no-sound"].as<bool>());
+    engine.setSoundUsage(!headless && !variables["no-sound"].as<bool>());
     engine.setActivationDistanceOverride(variables["activate-dist"].as<int>());
     engine.enableFontExport(variables["export-fonts"].as<bool>());
     engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
+    engine.setInputRecordFile(variables["record-input"].as<Files::MaybeQuotedPath>().u8string());
+    engine.setInputReplayFile(variables["replay-input"].as<Files::MaybeQuotedPath>().u8string());
+    engine.setReplayFixedStep(variables["replay-fixed-step"].as<float>());
+    engine.setTimingsSummaryFile(variables["timings-summary"].as<Files::MaybeQuotedPath>().u8string());
 
     return true;
 }
@@ -22,6 +22,7 @@ namespace Compiler
 namespace MWScript
 {
     class GlobalScripts;
+    class LocalScriptScheduler;
 }
 
 namespace MWBase
@@ -58,6 +59,11 @@ namespace MWBase
 
         virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
 
+        virtual MWScript::LocalScriptScheduler& getLocalScriptScheduler() = 0;
+
+        virtual void removeLocalScriptInstance(const void* instance) = 0;
+        ///< Forget scheduling state of the object identified by \a instance, e.g. because it is being removed.
+
         virtual const Compiler::Extensions& getExtensions() const = 0;
     };
 }
@@ -82,6 +82,7 @@ namespace DetourNavigator
 {
     struct Navigator;
     struct AgentBounds;
+    class PathQueryService;
 }
 
 namespace MWWorld
@@ -579,6 +580,9 @@ namespace MWBase
 
         virtual DetourNavigator::Navigator* getNavigator() const = 0;
 
+        /// Returns nullptr when paths are found in the main thread.
+        virtual DetourNavigator::PathQueryService* getPathQueryService() const = 0;
+
         virtual void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
             const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const = 0;
 
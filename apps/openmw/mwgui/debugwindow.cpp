@@ -10,6 +10,9 @@
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/luamanager.hpp"
+#include "../mwbase/scriptmanager.hpp"
+
+#include "../mwscript/localscriptscheduler.hpp"
 
 #include <mutex>
 
@@ -115,6 +118,12 @@ namespace MWGui
             "LogEdit", MyGUI::FloatCoord(0, 0, 1, 1), MyGUI::Align::Stretch);
         mLuaProfiler->setEditReadOnly(true);
 
+        MyGUI::TabItem* itemMWScriptProfiler = mTabControl->addItem("MWScript Profiler");
+        itemMWScriptProfiler->setCaptionWithReplacing(" #{OMWEngine:MWScriptProfiler} ");
+        mMWScriptProfiler = itemMWScriptProfiler->createWidgetReal<MyGUI::EditBox>(
+            "LogEdit", MyGUI::FloatCoord(0, 0, 1, 1), MyGUI::Align::Stretch);
+        mMWScriptProfiler->setEditReadOnly(true);
+
 #ifndef BT_NO_PROFILE
         MyGUI::TabItem* item = mTabControl->addItem("Physics Profiler");
         item->setCaptionWithReplacing(" #{OMWEngine:PhysicsProfiler} ");
@@ -232,6 +241,17 @@ namespace MWGui
         mLuaProfiler->setVScrollPosition(std::min(previousPos, mLuaProfiler->getVScrollRange() - 1));
     }
 
+    void DebugWindow::updateMWScriptProfile()
+    {
+        if (mMWScriptProfiler->isTextSelection())
+            return;
+
+        size_t previousPos = mMWScriptProfiler->getVScrollPosition();
+        mMWScriptProfiler->setCaption(
+            MWBase::Environment::get().getScriptManager()->getLocalScriptScheduler().formatStats());
+        mMWScriptProfiler->setVScrollPosition(std::min(previousPos, mMWScriptProfiler->getVScrollRange() - 1));
+    }
+
     void DebugWindow::updateBulletProfile()
     {
 #ifndef BT_NO_PROFILE
@@ -247,26 +267,31 @@ namespace MWGui
 #endif
     }
 
+    bool DebugWindow::isTabSelected(const MyGUI::Widget* content) const
+    {
+        // Tabs are identified by their content since the number of tabs depends on the build
+        return content != nullptr && mTabControl->getItemSelected() == content->getParent();
+    }
+
     void DebugWindow::onFrame(float dt)
     {
+        // Local scripts are timed only while their profile is shown
+        MWBase::Environment::get().getScriptManager()->getLocalScriptScheduler().setCollectStats(
+            isVisible() && isTabSelected(mMWScriptProfiler));
+
         static float timer = 0;
         timer -= dt;
         if (timer > 0 || !isVisible())
             return;
         timer = 0.25;
 
-        switch (mTabControl->getIndexSelected())
-        {
-            case 0:
-                updateLogView();
-                break;
-            case 1:
-                updateLuaProfile();
-                break;
-            case 2:
-                updateBulletProfile();
-                break;
-            default:;
-        }
+        if (isTabSelected(mLogView))
+            updateLogView();
+        else if (isTabSelected(mLuaProfiler))
+            updateLuaProfile();
+        else if (isTabSelected(mMWScriptProfiler))
+            updateMWScriptProfile();
+        else if (isTabSelected(mBulletProfilerEdit))
+            updateBulletProfile();
     }
 }
@@ -18,11 +18,15 @@ namespace MWGui
     private:
         void updateLogView();
         void updateLuaProfile();
+        void updateMWScriptProfile();
         void updateBulletProfile();
 
+        bool isTabSelected(const MyGUI::Widget* content) const;
+
         MyGUI::TabControl* mTabControl;
         MyGUI::EditBox* mLogView;
         MyGUI::EditBox* mLuaProfiler;
+        MyGUI::EditBox* mMWScriptProfiler;
         MyGUI::EditBox* mBulletProfilerEdit;
     };
 
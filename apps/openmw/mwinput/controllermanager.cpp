@@ -8,6 +8,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm/refid.hpp>
 #include <components/files/conversion.hpp>
+#include <components/sdlutil/sdlinputwrapper.hpp>
 #include <components/sdlutil/sdlmappings.hpp>
 #include <components/settings/values.hpp>
 
@@ -25,9 +26,11 @@
 namespace MWInput
 {
     ControllerManager::ControllerManager(BindingsManager* bindingsManager, MouseManager* mouseManager,
-        const std::filesystem::path& userControllerBindingsFile, const std::filesystem::path& controllerBindingsFile)
+        SDLUtil::InputWrapper* inputWrapper, const std::filesystem::path& userControllerBindingsFile,
+        const std::filesystem::path& controllerBindingsFile)
         : mBindingsManager(bindingsManager)
         , mMouseManager(mouseManager)
+        , mInputWrapper(inputWrapper)
         , mGyroAvailable(false)
         , mGamepadGuiCursorEnabled(true)
         , mGuiCursorEnabled(true)
@@ -502,20 +505,14 @@ namespace MWInput
 
     float ControllerManager::getAxisValue(SDL_GameControllerAxis axis) const
     {
-        SDL_GameController* cntrl = mBindingsManager->getControllerOrNull();
         constexpr float axisMaxAbsoluteValue = 32768;
-        if (cntrl != nullptr)
-            return SDL_GameControllerGetAxis(cntrl, axis) / axisMaxAbsoluteValue;
-        return 0;
+        // Queried even without a controller to keep the order of replayed results
+        return mInputWrapper->getControllerAxis(mBindingsManager->getControllerOrNull(), axis) / axisMaxAbsoluteValue;
     }
 
     bool ControllerManager::isButtonPressed(SDL_GameControllerButton button) const
     {
-        SDL_GameController* cntrl = mBindingsManager->getControllerOrNull();
-        if (cntrl)
-            return SDL_GameControllerGetButton(cntrl, button) > 0;
-        else
-            return false;
+        return mInputWrapper->isControllerButtonDown(mBindingsManager->getControllerOrNull(), button);
     }
 
     void ControllerManager::enableGyroSensor()
@@ -8,6 +8,11 @@
 #include <components/sdlutil/events.hpp>
 #include <components/settings/settings.hpp>
 
+namespace SDLUtil
+{
+    class InputWrapper;
+}
+
 namespace MWInput
 {
     class BindingsManager;
@@ -17,7 +22,7 @@ namespace MWInput
     {
     public:
         ControllerManager(BindingsManager* bindingsManager, MouseManager* mouseManager,
-            const std::filesystem::path& userControllerBindingsFile,
+            SDLUtil::InputWrapper* inputWrapper, const std::filesystem::path& userControllerBindingsFile,
             const std::filesystem::path& controllerBindingsFile);
 
         virtual ~ControllerManager() = default;
@@ -64,6 +69,7 @@ namespace MWInput
 
         BindingsManager* mBindingsManager;
         MouseManager* mMouseManager;
+        SDLUtil::InputWrapper* mInputWrapper;
 
         bool mGyroAvailable;
         bool mGamepadGuiCursorEnabled;
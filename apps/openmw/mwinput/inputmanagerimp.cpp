@@ -35,8 +35,8 @@ namespace MWInput
         , mActionManager(std::make_unique<ActionManager>(mBindingsManager.get(), viewer, screenCaptureHandler))
         , mKeyboardManager(std::make_unique<KeyboardManager>(mBindingsManager.get()))
         , mMouseManager(std::make_unique<MouseManager>(mBindingsManager.get(), mInputWrapper.get(), window))
-        , mControllerManager(std::make_unique<ControllerManager>(
-              mBindingsManager.get(), mMouseManager.get(), userControllerBindingsFile, controllerBindingsFile))
+        , mControllerManager(std::make_unique<ControllerManager>(mBindingsManager.get(), mMouseManager.get(),
+              mInputWrapper.get(), userControllerBindingsFile, controllerBindingsFile))
         , mSensorManager(std::make_unique<SensorManager>())
         , mGyroManager(std::make_unique<GyroManager>())
     {
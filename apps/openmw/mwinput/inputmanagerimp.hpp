@@ -106,6 +106,9 @@ namespace MWInput
 
         bool controlsDisabled() override { return mControlsDisabled; }
 
+        /// Used to record and replay input events
+        SDLUtil::InputWrapper& getInputWrapper() { return *mInputWrapper; }
+
     private:
         bool mControlsDisabled;
 
@@ -218,7 +218,7 @@ namespace MWInput
 
     void MouseManager::update(float dt)
     {
-        SDL_GetRelativeMouseState(&mMouseMoveX, &mMouseMoveY);
+        mInputWrapper->getRelativeMouseState(mMouseMoveX, mMouseMoveY);
 
         if (!mMouseLookEnabled)
             return;
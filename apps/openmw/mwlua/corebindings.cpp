@@ -6,7 +6,6 @@
 #include <components/debug/debuglog.hpp>
 #include <components/lua/l10n.hpp>
 #include <components/lua/luastate.hpp>
-#include <components/lua/serialization.hpp>
 #include <components/lua/util.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/lower.hpp>
@@ -145,8 +144,7 @@ namespace MWLua
         if (context.mType != Context::Menu)
         {
             api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData) {
-                context.mLuaEvents->addGlobalEvent(
-                    { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addGlobalEvent(std::move(eventName), eventData);
             };
             api["sound"]
                 = context.cachePackage("openmw_core_sound", [context]() { return initCoreSoundBindings(context); });
@@ -158,8 +156,7 @@ namespace MWLua
                 {
                     throw std::logic_error("Can't send global events when no game is loaded");
                 }
-                context.mLuaEvents->addGlobalEvent(
-                    { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addGlobalEvent(std::move(eventName), eventData);
             };
         }
 
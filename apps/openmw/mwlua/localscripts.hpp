@@ -63,6 +63,7 @@ namespace MWLua
         static void initializeSelfPackage(const Context&);
         LocalScripts(LuaUtil::LuaState* lua, const LObject& obj, LuaUtil::ScriptTracker* tracker = nullptr);
 
+        LuaUtil::LuaState& getLua() const { return mLua; }
         MWBase::LuaManager::ActorControls* getActorControls() { return &mData.mControls; }
         const MWWorld::Ptr& getPtrOrEmpty() const { return mData.ptrOrEmpty(); }
 
@@ -0,0 +1,113 @@
+#include "localshard.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/settings/values.hpp>
+
+#include <osg/Timer>
+
+#include <algorithm>
+#include <exception>
+
+#include "localscripts.hpp"
+
+namespace MWLua
+{
+    namespace
+    {
+        thread_local LocalShard* currentShard = nullptr;
+
+        std::mutex worldMutex;
+    }
+
+    LocalShard::LocalShard(std::size_t index, const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+        const LuaUtil::LuaStateSettings& settings, const std::filesystem::path& libsDir)
+        : mIndex(index)
+        , mLua(vfs, conf, settings)
+    {
+        mLua.addInternalLibSearchPath(libsDir);
+        mThread = std::thread([this] { run(); });
+    }
+
+    LocalShard::~LocalShard()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mMutex);
+            mJoinRequest = true;
+        }
+        mCV.notify_all();
+        mThread.join();
+    }
+
+    void LocalShard::startUpdate(std::vector<LocalScripts*>&& scripts, float frameDuration, double gcBudget)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mMutex);
+            mScripts = std::move(scripts);
+            mFrameDuration = frameDuration;
+            mGcBudget = gcBudget;
+            mHasUpdate = true;
+        }
+        mCV.notify_all();
+    }
+
+    void LocalShard::waitUpdate()
+    {
+        std::unique_lock<std::mutex> lk(mMutex);
+        mCV.wait(lk, [&] { return !mHasUpdate; });
+    }
+
+    LocalShard* LocalShard::getCurrent()
+    {
+        return currentShard;
+    }
+
+    std::unique_lock<std::mutex> LocalShard::lockWorld()
+    {
+        return std::unique_lock(worldMutex);
+    }
+
+    void LocalShard::update()
+    {
+        const osg::Timer* const timer = osg::Timer::instance();
+        const osg::Timer_t start = timer->tick();
+
+        mGcScheduler.update(mLua.unsafeState(), mGcBudget, Settings::lua().mGcStepsPerFrame);
+
+        mLua.protectedCall([&](LuaUtil::LuaView& view) {
+            for (LocalScripts* scripts : mScripts)
+                scripts->update(mFrameDuration);
+            mScriptTracker.unloadInactiveScripts(view);
+        });
+
+        mStats.mScripts = mScripts.size();
+        mStats.mTime = timer->delta_s(start, timer->tick());
+        mStats.mMaxTime = std::max(mStats.mMaxTime, mStats.mTime);
+        mScripts.clear();
+    }
+
+    void LocalShard::run() noexcept
+    {
+        currentShard = this;
+
+        while (true)
+        {
+            std::unique_lock<std::mutex> lk(mMutex);
+            mCV.wait(lk, [&] { return mHasUpdate || mJoinRequest; });
+            if (mJoinRequest)
+                break;
+
+            try
+            {
+                update();
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to update Lua shard " << mIndex << ": " << e.what();
+            }
+
+            mHasUpdate = false;
+            lk.unlock();
+            mCV.notify_all();
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef MWLUA_LOCALSHARD_H
+#define MWLUA_LOCALSHARD_H
+
+#include <components/lua/gcscheduler.hpp>
+#include <components/lua/luastate.hpp>
+#include <components/lua/scripttracker.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MWLua
+{
+    class LocalScripts;
+
+    struct LocalShardStats
+    {
+        std::size_t mScripts = 0;
+        double mTime = 0;
+        double mMaxTime = 0;
+    };
+
+    // \brief Separate Lua state with its own thread for a part of local scripts.
+    //
+    // Scripts of a single object always belong to the same shard. Objects in different shards don't share any Lua
+    // data, they interact only through serialized events and storage. Only `onUpdate` handlers and GC steps run in
+    // parallel with other shards; all other handlers are called sequentially from the Lua thread as for the scripts
+    // in the main Lua state.
+    class LocalShard
+    {
+    public:
+        LocalShard(std::size_t index, const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+            const LuaUtil::LuaStateSettings& settings, const std::filesystem::path& libsDir);
+
+        ~LocalShard();
+
+        std::size_t getIndex() const { return mIndex; }
+
+        LuaUtil::LuaState& getLua() { return mLua; }
+
+        const LuaUtil::LuaState& getLua() const { return mLua; }
+
+        LuaUtil::ScriptTracker& getScriptTracker() { return mScriptTracker; }
+
+        std::map<std::string, sol::object>& getPackages() { return mPackages; }
+
+        // Passes scripts to the shard thread and returns immediately
+        void startUpdate(std::vector<LocalScripts*>&& scripts, float frameDuration, double gcBudget);
+
+        void waitUpdate();
+
+        const LocalShardStats& getStats() const { return mStats; }
+
+        // Returns the shard which thread is calling this function or nullptr
+        static LocalShard* getCurrent();
+
+        // Serializes bindings which lazily modify the game world (initialize container stores, register Ptrs and
+        // assign RefNums) when they are called from `onUpdate` of different shards at the same time.
+        [[nodiscard]] static std::unique_lock<std::mutex> lockWorld();
+
+    private:
+        const std::size_t mIndex;
+        LuaUtil::LuaState mLua;
+        std::map<std::string, sol::object> mPackages;
+        LuaUtil::ScriptTracker mScriptTracker;
+        std::vector<LocalScripts*> mScripts;
+        float mFrameDuration = 0;
+        double mGcBudget = 0;
+        LuaUtil::GcScheduler mGcScheduler;
+        LocalShardStats mStats;
+        std::mutex mMutex;
+        std::condition_variable mCV;
+        bool mHasUpdate = false;
+        bool mJoinRequest = false;
+        std::thread mThread;
+
+        void update();
+
+        void run() noexcept;
+    };
+}
+
+#endif // MWLUA_LOCALSHARD_H
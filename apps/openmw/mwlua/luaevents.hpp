@@ -2,11 +2,13 @@
 #define MWLUA_LUAEVENTS_H
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <variant>
+#include <vector>
 
 #include <components/esm3/cellref.hpp> // defines RefNum that is used as a unique id
-
-struct lua_State;
+#include <components/lua/serialization.hpp>
 
 namespace ESM
 {
@@ -14,11 +16,6 @@ namespace ESM
     class ESMWriter;
 }
 
-namespace LuaUtil
-{
-    class UserdataSerializer;
-}
-
 namespace MWLua
 {
 
@@ -34,21 +31,50 @@ namespace MWLua
         {
         }
 
+        // Serialized data or a copy of the Lua value made by LuaUtil::copy in the sender's Lua state. The copy is
+        // serialized only if the receiver uses another Lua state or when the game is saved.
+        using EventData = std::variant<LuaUtil::BinaryData, sol::main_object>;
+
         struct Global
         {
             std::string mEventName;
-            std::string mEventData;
+            EventData mEventData;
         };
         struct Local
         {
             ESM::RefNum mDest;
             std::string mEventName;
-            std::string mEventData;
+            EventData mEventData;
         };
 
-        void addGlobalEvent(Global event) { mNewGlobalEventBatch.push_back(std::move(event)); }
-        void addMenuEvent(Global event) { mMenuEvents.push_back(std::move(event)); }
-        void addLocalEvent(Local event) { mNewLocalEventBatch.push_back(std::move(event)); }
+        // Serializers are used to copy and save event data of global and local scripts
+        void setSerializers(
+            const LuaUtil::UserdataSerializer* globalSerializer, const LuaUtil::UserdataSerializer* localSerializer)
+        {
+            mGlobalSerializer = globalSerializer;
+            mLocalSerializer = localSerializer;
+        }
+
+        // Can be called concurrently by local scripts in different Lua states
+        void addGlobalEvent(Global event)
+        {
+            const std::lock_guard lock(mMutex);
+            mNewGlobalEventBatch.push_back(std::move(event));
+        }
+        void addMenuEvent(Global event)
+        {
+            const std::lock_guard lock(mMutex);
+            mMenuEvents.push_back(std::move(event));
+        }
+        void addLocalEvent(Local event)
+        {
+            const std::lock_guard lock(mMutex);
+            mNewLocalEventBatch.push_back(std::move(event));
+        }
+
+        // Copy the event data within the sender's Lua state instead of serializing it
+        void addGlobalEvent(std::string eventName, const sol::object& eventData);
+        void addLocalEvent(ESM::RefNum dest, std::string eventName, const sol::object& eventData);
 
         void clear();
         void finalizeEventBatch();
@@ -62,6 +88,9 @@ namespace MWLua
     private:
         GlobalScripts& mGlobalScripts;
         MenuScripts& mMenuScripts;
+        const LuaUtil::UserdataSerializer* mGlobalSerializer = nullptr;
+        const LuaUtil::UserdataSerializer* mLocalSerializer = nullptr;
+        std::mutex mMutex;
         std::vector<Global> mNewGlobalEventBatch;
         std::vector<Local> mNewLocalEventBatch;
         std::vector<Global> mGlobalEventBatch;
@@ -1,26 +1,35 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 
 #include <MyGUI_InputManager.h>
 #include <osg/Stats>
+#include <osg/Timer>
 
 #include <sol/object.hpp>
 #include <sol/table.hpp>
 #include <sol/types.hpp>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 
 #include <components/esm/luascripts.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 
+#include <components/files/conversion.hpp>
+
 #include <components/settings/values.hpp>
 
 #include <components/l10n/manager.hpp>
 
+#include <components/lua/bytecodecache.hpp>
 #include <components/lua_ui/registerscriptsettings.hpp>
 #include <components/lua_ui/util.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwbase/windowmanager.hpp"
 #include "../mwbase/world.hpp"
@@ -55,35 +64,128 @@ namespace MWLua
 
             ~BoolScopeGuard() { mValue = false; }
         };
+
+        struct FrameTimeScope
+        {
+            LuaUtil::FrameTimeStats& mStats;
+            const osg::Timer_t mStart = osg::Timer::instance()->tick();
+
+            ~FrameTimeScope() { mStats.add(osg::Timer::instance()->delta_s(mStart, osg::Timer::instance()->tick())); }
+        };
+
+        // Frame time hitches are not noticeable when the game is paused, so the garbage collector can do more work
+        constexpr double pausedGcBudgetScale = 4;
+
+        double getGcBudget(bool paused)
+        {
+            const double budget = Settings::lua().mGcBudgetPerFrame * 1e-6;
+            return paused ? budget * pausedGcBudgetScale : budget;
+        }
+
+        void printFrameTimeStats(std::ostream& out, const LuaUtil::FrameTimeStats& stats)
+        {
+            out << "p50 " << stats.getPercentile(0.5) * 1000 << " ms, p95 " << stats.getPercentile(0.95) * 1000
+                << " ms, p99 " << stats.getPercentile(0.99) * 1000 << " ms, max " << stats.getPercentile(1) * 1000
+                << " ms";
+        }
+
+        std::size_t getLocalShardIndex(ObjectId id, std::size_t shards)
+        {
+            return (static_cast<std::size_t>(id.mIndex) + static_cast<std::uint32_t>(id.mContentFile)) % shards;
+        }
+
+        // Compares loading of cached scripts (warm start) with compilation of new or changed scripts (cold start)
+        void printBytecodeCacheStats(std::ostream& out, const LuaUtil::BytecodeCache::Stats& stats)
+        {
+            out << stats.mHits << " scripts loaded from cache in " << stats.mHitLoadTime * 1000 << " ms, "
+                << stats.mMisses << " scripts compiled in " << stats.mMissLoadTime * 1000 << " ms";
+        }
+
+        // Writing a large profile takes a while, so it is done outside of the Lua thread
+        class WriteCollapsedStacksItem final : public SceneUtil::WorkItem
+        {
+        public:
+            explicit WriteCollapsedStacksItem(std::filesystem::path path, std::map<std::string, std::uint64_t> stacks)
+                : mPath(std::move(path))
+                , mStacks(std::move(stacks))
+            {
+            }
+
+            void doWork() override
+            {
+                std::ofstream stream(mPath);
+                if (!stream)
+                {
+                    Log(Debug::Error) << "Failed to open Lua profiler output file: " << mPath;
+                    return;
+                }
+                LuaUtil::writeCollapsedStacks(mStacks, stream);
+            }
+
+        private:
+            const std::filesystem::path mPath;
+            const std::map<std::string, std::uint64_t> mStacks;
+        };
     }
 
-    static LuaUtil::LuaStateSettings createLuaStateSettings()
+    static LuaUtil::LuaStateSettings createLuaStateSettings(const std::filesystem::path& cacheDir)
     {
         if (!Settings::lua().mLuaProfiler)
             LuaUtil::LuaState::disableProfiler();
+        std::shared_ptr<LuaUtil::BytecodeCache> bytecodeCache;
+        if (Settings::lua().mBytecodeCache)
+            bytecodeCache = std::make_shared<LuaUtil::BytecodeCache>(cacheDir / "lua");
         return { .mInstructionLimit = Settings::lua().mInstructionLimitPerCall,
             .mMemoryLimit = Settings::lua().mMemoryLimit,
             .mSmallAllocMaxSize = Settings::lua().mSmallAllocMaxSize,
-            .mLogMemoryUsage = Settings::lua().mLogMemoryUsage };
+            .mLogMemoryUsage = Settings::lua().mLogMemoryUsage,
+            .mBytecodeCache = std::move(bytecodeCache) };
     }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
-        : mLua(vfs, &mConfiguration, createLuaStateSettings())
+    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir,
+        const std::filesystem::path& cacheDir, SceneUtil::WorkQueue* workQueue)
+        : mWorkQueue(workQueue)
+        , mLua(vfs, &mConfiguration, createLuaStateSettings(cacheDir))
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
 
+        if (const int shards = Settings::lua().mLocalScriptShards; shards > 0)
+        {
+            Log(Debug::Warning) << "Using " << shards << " Lua states for local scripts, this mode is experimental";
+            // All states share the bytecode cache
+            const LuaUtil::LuaStateSettings& settings = mLua.getSettings();
+            for (int i = 0; i < shards; ++i)
+                mLocalShards.push_back(std::make_unique<LocalShard>(
+                    static_cast<std::size_t>(i), vfs, &mConfiguration, settings, libsDir));
+        }
+
         mGlobalSerializer = createUserdataSerializer(false);
         mLocalSerializer = createUserdataSerializer(true);
         mGlobalLoader = createUserdataSerializer(false, &mContentFileMapping);
         mLocalLoader = createUserdataSerializer(true, &mContentFileMapping);
 
         mGlobalScripts.setSerializer(mGlobalSerializer.get());
+        mLuaEvents.setSerializers(mGlobalSerializer.get(), mLocalSerializer.get());
+
+        if (LuaUtil::LuaState::isProfilerEnabled() && Settings::lua().mLuaProfilerSampling)
+        {
+            Log(Debug::Info) << "Lua profiler sampling is enabled";
+            mLua.getProfiler().setActive(true);
+            for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+                shard->getLua().getProfiler().setActive(true);
+        }
     }
 
     LuaManager::~LuaManager()
     {
         LuaUi::clearSettings();
+        if (const LuaUtil::BytecodeCache* cache = mLua.getSettings().mBytecodeCache.get())
+        {
+            std::ostringstream stats;
+            printBytecodeCacheStats(stats, cache->getStats());
+            Log(Debug::Info) << "Lua bytecode cache: " << stats.str();
+        }
     }
 
     void LuaManager::initConfiguration()
@@ -137,6 +239,20 @@ namespace MWLua
             mPlayerStorage.setActive(true);
             mGlobalStorage.setActive(false);
 
+            for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            {
+                Context shardContext = localContext;
+                shardContext.mLua = &shard->getLua();
+                shard->getLua().protectedCall([&](LuaUtil::LuaView& shardView) {
+                    for (const auto& [name, package] : initCommonPackages(shardContext))
+                        shard->getLua().addCommonPackage(name, package);
+                    std::map<std::string, sol::object>& packages = shard->getPackages();
+                    packages = initLocalPackages(shardContext);
+                    LuaUtil::LuaStorage::initLuaBindings(shardView);
+                    packages["openmw.storage"] = LuaUtil::LuaStorage::initLocalPackage(shardView, &mGlobalStorage);
+                });
+            }
+
             initConfiguration();
             mInitialized = true;
             mMenuScripts.addAutoStartedScripts();
@@ -170,18 +286,22 @@ namespace MWLua
     void LuaManager::sendLocalEvent(
         const MWWorld::Ptr& target, const std::string& name, const std::optional<sol::table>& data)
     {
-        LuaUtil::BinaryData binary = {};
         if (data)
-        {
-            binary = LuaUtil::serialize(*data, mLocalSerializer.get());
-        }
-        mLuaEvents.addLocalEvent({ getId(target), name, std::move(binary) });
+            mLuaEvents.addLocalEvent(getId(target), name, *data);
+        else
+            mLuaEvents.addLocalEvent({ getId(target), name, {} });
     }
 
     void LuaManager::update()
     {
-        if (const int steps = Settings::lua().mGcStepsPerFrame; steps > 0)
-            lua_gc(mLua.unsafeState(), LUA_GCSTEP, steps);
+        const Debug::Trace::Scope trace("LuaManager::update");
+        const FrameTimeScope frameTimeScope{ .mStats = mUpdateTimeStats };
+        MWWorld::DateTimeManager& timeManager = *MWBase::Environment::get().getWorld()->getTimeManager();
+        const double gcBudget = getGcBudget(mPlayer.isEmpty() || timeManager.isPaused());
+        mGcScheduler.update(mLua.unsafeState(), gcBudget, Settings::lua().mGcStepsPerFrame);
+
+        if (mLua.getProfiler().isActive())
+            updateProfiler(MWBase::Environment::get().getFrameDuration());
 
         if (mPlayer.isEmpty())
             return; // The game is not started yet.
@@ -210,7 +330,6 @@ namespace MWLua
 
         mLuaEvents.finalizeEventBatch();
 
-        MWWorld::DateTimeManager& timeManager = *MWBase::Environment::get().getWorld()->getTimeManager();
         if (!timeManager.isPaused())
         {
             mMenuScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
@@ -233,14 +352,99 @@ namespace MWLua
             bool isPaused = timeManager.isPaused();
 
             float frameDuration = MWBase::Environment::get().getFrameDuration();
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(isPaused ? 0 : frameDuration);
+            updateLocalScripts(isPaused ? 0 : frameDuration, gcBudget);
             mGlobalScripts.update(isPaused ? 0 : frameDuration);
 
             mScriptTracker.unloadInactiveScripts(lua);
         });
     }
 
+    void LuaManager::updateLocalScripts(float frameDuration, double gcBudget)
+    {
+        if (mLocalShards.empty())
+        {
+            for (LocalScripts* scripts : mActiveLocalScripts)
+                scripts->update(frameDuration);
+            return;
+        }
+
+        std::vector<std::vector<LocalScripts*>> shardScripts(mLocalShards.size());
+        std::vector<LocalScripts*> mainStateScripts;
+        for (LocalScripts* scripts : mActiveLocalScripts)
+        {
+            if (const LocalShard* shard = findLocalShard(*scripts))
+                shardScripts[shard->getIndex()].push_back(scripts);
+            else
+                mainStateScripts.push_back(scripts);
+        }
+
+        for (std::size_t i = 0; i < mLocalShards.size(); ++i)
+            mLocalShards[i]->startUpdate(std::move(shardScripts[i]), frameDuration, gcBudget);
+
+        for (LocalScripts* scripts : mainStateScripts)
+            scripts->update(frameDuration);
+
+        for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            shard->waitUpdate();
+    }
+
+    LocalShard* LuaManager::findLocalShard(const LocalScripts& scripts) const
+    {
+        for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            if (&shard->getLua() == &scripts.getLua())
+                return shard.get();
+        return nullptr;
+    }
+
+    void LuaManager::updateProfiler(float frameDuration)
+    {
+        mProfilerWindowTime += frameDuration;
+        if (mProfilerWindowTime < Settings::lua().mLuaProfilerWindow)
+            return;
+
+        std::vector<LuaUtil::Profiler*> profilers{ &mLua.getProfiler() };
+        for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            profilers.push_back(&shard->getLua().getProfiler());
+
+        // Stats are aggregated here, so the GUI thread never reads profilers while they are being updated
+        std::map<std::pair<int, std::string>, LuaUtil::Profiler::HandlerStats> handlers;
+        for (LuaUtil::Profiler* profiler : profilers)
+        {
+            profiler->nextWindow(mProfilerWindowTime);
+            for (const auto& [scriptIndex, scriptHandlers] : profiler->getLastWindowStats())
+                for (const auto& [name, handlerStats] : scriptHandlers)
+                {
+                    LuaUtil::Profiler::HandlerStats& total = handlers[{ scriptIndex, name }];
+                    total.mTime += handlerStats.mTime;
+                    total.mCalls += handlerStats.mCalls;
+                    total.mAllocations += handlerStats.mAllocations;
+                }
+        }
+
+        {
+            const std::lock_guard lock(mProfilerStatsMutex);
+            std::swap(mProfilerStats, handlers);
+            mProfilerStatsDuration = mProfilerWindowTime;
+        }
+
+        mProfilerWindowTime = 0;
+
+        const std::string& output = Settings::lua().mLuaProfilerOutput;
+        if (output.empty())
+            return;
+
+        // Skip the window if the previous one is still being written
+        if (mProfilerOutput != nullptr && !mProfilerOutput->isDone())
+            return;
+
+        std::map<std::string, std::uint64_t> stacks;
+        for (const LuaUtil::Profiler* profiler : profilers)
+            profiler->collectStacks(stacks);
+
+        mProfilerOutput = new WriteCollapsedStacksItem(Files::pathFromUnicodeString(output), std::move(stacks));
+        mWorkQueue->addWorkItem(mProfilerOutput);
+    }
+
     void LuaManager::objectTeleported(const MWWorld::Ptr& ptr)
     {
         if (ptr == mPlayer)
@@ -334,7 +538,11 @@ namespace MWLua
 
     void LuaManager::applyDelayedActions()
     {
-        BoolScopeGuard applyingGuard(mApplyingDelayedActions);
+        // addAction can be called from the threads of local script shards, so the flag is changed under the lock
+        {
+            const std::lock_guard lock(mActionQueueMutex);
+            mApplyingDelayedActions = true;
+        }
         for (DelayedAction& action : mActionQueue)
             action.apply();
         mActionQueue.clear();
@@ -342,6 +550,9 @@ namespace MWLua
         if (mTeleportPlayerAction)
             mTeleportPlayerAction->apply();
         mTeleportPlayerAction.reset();
+
+        const std::lock_guard lock(mActionQueueMutex);
+        mApplyingDelayedActions = false;
     }
 
     void LuaManager::clear()
@@ -373,7 +584,11 @@ namespace MWLua
         mInputTriggers.clear();
         mQueuedAutoStartedScripts.clear();
         for (int i = 0; i < 5; ++i)
+        {
             lua_gc(mLua.unsafeState(), LUA_GCCOLLECT, 0);
+            for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+                lua_gc(shard->getLua().unsafeState(), LUA_GCCOLLECT, 0);
+        }
     }
 
     void LuaManager::setupPlayer(const MWWorld::Ptr& ptr)
@@ -466,7 +681,11 @@ namespace MWLua
         const MWRender::AnimPriority& priority, int blendMask, bool autodisable, float speedmult,
         std::string_view start, std::string_view stop, float startpoint, uint32_t loops, bool loopfallback)
     {
-        mLua.protectedCall([&](LuaUtil::LuaView& view) {
+        auto* scripts = actor.getRefData().getLuaScripts();
+        if (scripts == nullptr)
+            return;
+        // The options are passed to the scripts of the actor, so they are created in the state of these scripts
+        scripts->getLua().protectedCall([&](LuaUtil::LuaView& view) {
             sol::table options = view.newTable();
             options["blendMask"] = blendMask;
             options["autoDisable"] = autodisable;
@@ -494,8 +713,7 @@ namespace MWLua
             // mEngineEvents.addToQueue(event);
             //  Has to be called immediately, otherwise engine details that depend on animations playing immediately
             //  break.
-            if (auto* scripts = actor.getRefData().getLuaScripts())
-                scripts->onPlayAnimation(groupname, options);
+            scripts->onPlayAnimation(groupname, options);
         });
     }
 
@@ -639,6 +857,18 @@ namespace MWLua
             for (const auto& [name, package] : mPlayerPackages)
                 scripts->addPackage(name, package);
         }
+        else if (!mLocalShards.empty())
+        {
+            // Scripts of an object always go to the same shard, generated RefNums are spread evenly
+            const ObjectId id = getId(ptr);
+            LocalShard& shard = *mLocalShards[getLocalShardIndex(id, mLocalShards.size())];
+            scripts = std::make_shared<LocalScripts>(&shard.getLua(), LObject(id), &shard.getScriptTracker());
+            if (!autoStartConf.has_value())
+                autoStartConf = mConfiguration.getLocalConf(type, ptr.getCellRef().getRefId(), id);
+            scripts->setAutoStartConf(std::move(*autoStartConf));
+            for (const auto& [name, package] : shard.getPackages())
+                scripts->addPackage(name, package);
+        }
         else
         {
             scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)), &mScriptTracker);
@@ -733,6 +963,8 @@ namespace MWLua
         MWBase::Environment::get().getL10nManager()->dropCache();
         mUiResourceManager.clear();
         mLua.dropScriptCache();
+        for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            shard->getLua().dropScriptCache();
         mInputActions.clear(true);
         mInputTriggers.clear(true);
         initConfiguration();
@@ -831,9 +1063,11 @@ namespace MWLua
 
     void LuaManager::addAction(std::function<void()> action, std::string_view name)
     {
+        LocalShard* const shard = LocalShard::getCurrent();
+        const std::lock_guard lock(mActionQueueMutex);
         if (mApplyingDelayedActions)
             throw std::runtime_error("DelayedAction is not allowed to create another DelayedAction");
-        mActionQueue.emplace_back(&mLua, std::move(action), name);
+        mActionQueue.emplace_back(shard == nullptr ? &mLua : &shard->getLua(), std::move(action), name);
     }
 
     void LuaManager::addTeleportPlayerAction(std::function<void()> action)
@@ -843,7 +1077,10 @@ namespace MWLua
 
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        stats.setAttribute(frameNumber, "Lua UsedMemory", static_cast<double>(mLua.getTotalMemoryUsage()));
+        std::uint64_t usedMemory = mLua.getTotalMemoryUsage();
+        for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            usedMemory += shard->getLua().getTotalMemoryUsage();
+        stats.setAttribute(frameNumber, "Lua UsedMemory", static_cast<double>(usedMemory));
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -869,21 +1106,116 @@ namespace MWLua
                 out << (bytes / (1024 * 1024 * 1024)) << " GB";
         };
 
+        std::vector<const LuaUtil::LuaState*> states{ &mLua };
+        for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            states.push_back(&shard->getLua());
+
+        uint64_t totalMemoryUsage = 0;
+        uint64_t smallAllocMemoryUsage = 0;
+        for (const LuaUtil::LuaState* state : states)
+        {
+            totalMemoryUsage += state->getTotalMemoryUsage();
+            smallAllocMemoryUsage += state->getSmallAllocMemoryUsage();
+        }
+
         const uint64_t smallAllocSize = Settings::lua().mSmallAllocMaxSize;
         out << "Total memory usage:";
-        outMemSize(mLua.getTotalMemoryUsage());
+        outMemSize(totalMemoryUsage);
         out << "\n";
         out << "LuaUtil::ScriptsContainer count: " << LuaUtil::ScriptsContainer::getInstanceCount() << "\n";
+        if (const LuaUtil::BytecodeCache* cache = mLua.getSettings().mBytecodeCache.get())
+        {
+            out << "Bytecode cache: ";
+            printBytecodeCacheStats(out, cache->getStats());
+            out << "\n";
+        }
+        out << "Lua update time per frame (last " << mUpdateTimeStats.size() << " frames): ";
+        printFrameTimeStats(out, mUpdateTimeStats);
+        out << "\n";
+        out << "Lua GC time per frame: ";
+        printFrameTimeStats(out, mGcScheduler.getFrameTimeStats());
+        if (Settings::lua().mGcBudgetPerFrame > 0)
+            out << ", " << mGcScheduler.getCycles() << " cycles";
+        out << "\n";
         out << "\n";
         out << "small alloc max size = " << smallAllocSize << " (section [Lua] in settings.cfg)\n";
         out << "Smaller values give more information for the profiler, but increase performance overhead.\n";
         out << "  Memory allocations <= " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getSmallAllocMemoryUsage());
+        outMemSize(smallAllocMemoryUsage);
         out << " (not tracked)\n";
         out << "  Memory allocations >  " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getTotalMemoryUsage() - mLua.getSmallAllocMemoryUsage());
+        outMemSize(totalMemoryUsage - smallAllocMemoryUsage);
         out << " (see the table below)\n\n";
 
+        if (!mLocalShards.empty())
+        {
+            out << "Local scripts of non-player objects use " << mLocalShards.size()
+                << " Lua states (section [Lua] in settings.cfg)\n";
+            out << std::left << " " << std::setw(nameW + 2) << "*** Lua state" << std::right;
+            out << std::setw(valueW) << "objects";
+            out << std::setw(valueW) << "memory";
+            out << std::setw(valueW) << "update ms";
+            out << std::setw(valueW) << "max ms";
+            out << "\n";
+            for (const std::unique_ptr<LocalShard>& shard : mLocalShards)
+            {
+                const LocalShardStats& shardStats = shard->getStats();
+                out << std::left << " " << std::setw(nameW + 2) << ("shard " + std::to_string(shard->getIndex()))
+                    << std::right;
+                out << std::setw(valueW) << shardStats.mScripts;
+                outMemSize(shard->getLua().getTotalMemoryUsage());
+                out << std::fixed << std::setprecision(3);
+                out << std::setw(valueW) << shardStats.mTime * 1000;
+                out << std::setw(valueW) << shardStats.mMaxTime * 1000;
+                out << std::defaultfloat << "\n";
+            }
+            out << "\n";
+        }
+
+        if (mLua.getProfiler().isActive())
+        {
+            constexpr std::size_t maxHandlers = 15;
+
+            using HandlerStats = LuaUtil::Profiler::HandlerStats;
+            std::vector<std::pair<std::pair<int, std::string>, HandlerStats>> top;
+            double duration = 0;
+            {
+                const std::lock_guard lock(mProfilerStatsMutex);
+                top.assign(mProfilerStats.begin(), mProfilerStats.end());
+                duration = mProfilerStatsDuration;
+            }
+            const std::size_t topSize = std::min(top.size(), maxHandlers);
+            std::partial_sort(top.begin(), top.begin() + topSize, top.end(),
+                [](const auto& l, const auto& r) { return l.second.mTime > r.second.mTime; });
+            top.resize(topSize);
+
+            out << "Handlers using the most time during the last " << duration
+                << " s (lua profiler sampling in settings.cfg)\n";
+            out << std::left << " " << std::setw(nameW + 2) << "*** [script] handler" << std::right;
+            out << std::setw(valueW) << "time ms";
+            out << std::setw(valueW) << "calls";
+            out << std::setw(valueW) << "allocations";
+            out << "\n";
+            for (const auto& [key, handlerStats] : top)
+            {
+                std::string name = "[";
+                if (static_cast<std::size_t>(key.first) < mConfiguration.size())
+                    name += mConfiguration[key.first].mScriptPath.value();
+                name += "] ";
+                name += key.second;
+                out << std::left << " " << std::setw(nameW) << name;
+                if (name.size() > nameW)
+                    out << "\n " << std::setw(nameW) << ""; // if name is too long, break line
+                out << std::right << std::fixed << std::setprecision(3);
+                out << std::setw(valueW) << handlerStats.mTime * 1000;
+                out << std::defaultfloat;
+                out << std::setw(valueW) << handlerStats.mCalls;
+                out << std::setw(valueW) << handlerStats.mAllocations;
+                out << "\n";
+            }
+            out << "\n";
+        }
+
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
 
         std::vector<Stats> activeStats;
@@ -942,8 +1274,10 @@ namespace MWLua
             out << std::right;
             out << std::setw(valueW) << static_cast<int64_t>(activeStats[i].mAvgInstructionCount);
             outMemSize(static_cast<size_t>(activeStats[i].mMemoryUsage));
-            outMemSize(mLua.getMemoryUsageByScriptIndex(static_cast<unsigned>(i))
-                - static_cast<uint64_t>(activeStats[i].mMemoryUsage));
+            uint64_t memoryUsage = 0;
+            for (const LuaUtil::LuaState* state : states)
+                memoryUsage += state->getMemoryUsageByScriptIndex(static_cast<unsigned>(i));
+            outMemSize(memoryUsage - static_cast<uint64_t>(activeStats[i].mMemoryUsage));
 
             if (isGlobal)
                 out << std::setw(valueW * 2) << "NA (global script)";
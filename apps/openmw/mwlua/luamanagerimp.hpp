@@ -3,10 +3,15 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <vector>
 
 #include <osg/Stats>
+#include <osg/ref_ptr>
 
+#include <components/lua/gcscheduler.hpp>
 #include <components/lua/inputactions.hpp>
 #include <components/lua/luastate.hpp>
 #include <components/lua/scripttracker.hpp>
@@ -20,11 +25,18 @@
 #include "engineevents.hpp"
 #include "globalscripts.hpp"
 #include "localscripts.hpp"
+#include "localshard.hpp"
 #include "luaevents.hpp"
 #include "menuscripts.hpp"
 #include "object.hpp"
 #include "objectlists.hpp"
 
+namespace SceneUtil
+{
+    class WorkItem;
+    class WorkQueue;
+}
+
 namespace MWLua
 {
     // \brief LuaManager is the central interface through which the engine invokes lua scripts.
@@ -35,7 +47,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir);
+        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& cacheDir,
+            SceneUtil::WorkQueue* workQueue);
         LuaManager(const LuaManager&) = delete;
         LuaManager(LuaManager&&) = delete;
         ~LuaManager();
@@ -182,6 +195,9 @@ namespace MWLua
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
         void reloadAllScriptsImpl();
         void synchronizedUpdateUnsafe();
+        void updateLocalScripts(float frameDuration, double gcBudget);
+        LocalShard* findLocalShard(const LocalScripts& scripts) const;
+        void updateProfiler(float frameDuration);
 
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
@@ -190,8 +206,20 @@ namespace MWLua
         bool mNewGameStarted = false;
         bool mReloadAllScriptsRequested = false;
         bool mRunningSynchronizedUpdates = false;
+        float mProfilerWindowTime = 0;
+        SceneUtil::WorkQueue* mWorkQueue;
+        osg::ref_ptr<SceneUtil::WorkItem> mProfilerOutput;
+        // Handler stats of all states for the last profiler window, updated by the Lua thread and shown by the GUI
+        mutable std::mutex mProfilerStatsMutex;
+        std::map<std::pair<int, std::string>, LuaUtil::Profiler::HandlerStats> mProfilerStats;
+        double mProfilerStatsDuration = 0;
+        LuaUtil::GcScheduler mGcScheduler;
+        LuaUtil::FrameTimeStats mUpdateTimeStats;
         LuaUtil::ScriptsConfiguration mConfiguration;
         LuaUtil::LuaState mLua;
+        // Optional additional Lua states for local scripts of non-player objects. Declared right after mLua to
+        // outlive all Lua objects referring to them.
+        std::vector<std::unique_ptr<LocalShard>> mLocalShards;
         LuaUi::ResourceManager mUiResourceManager;
         std::map<std::string, sol::object> mLocalPackages;
         std::map<std::string, sol::object> mPlayerPackages;
@@ -235,6 +263,8 @@ namespace MWLua
             std::function<void()> mFn;
             std::string mName;
         };
+        // Local scripts in different shards can add actions concurrently
+        std::mutex mActionQueueMutex;
         std::vector<DelayedAction> mActionQueue;
         std::optional<DelayedAction> mTeleportPlayerAction;
         std::vector<std::pair<std::string, MWGui::ShowInDialogueMode>> mUIMessages;
@@ -2,6 +2,7 @@
 
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
+#include <components/detournavigator/pathqueryservice.hpp>
 #include <components/lua/luastate.hpp>
 #include <components/misc/constants.hpp>
 #include <components/settings/values.hpp>
@@ -17,6 +18,8 @@
 #include "luamanagerimp.hpp"
 #include "objectlists.hpp"
 
+#include <limits>
+#include <optional>
 #include <vector>
 
 namespace
@@ -51,6 +54,43 @@ namespace
 
         return ignore;
     }
+
+    std::optional<MWLua::ObjectLists::Group> parseObjectGroup(const sol::optional<sol::table>& options)
+    {
+        if (!options)
+            return std::nullopt;
+        if (const auto group = options->get<sol::optional<MWLua::ObjectLists::Group>>("group"))
+            return *group;
+        return std::nullopt;
+    }
+
+    struct CastRayOptions
+    {
+        std::vector<MWWorld::ConstPtr> mIgnore;
+        int mCollisionType = MWPhysics::CollisionType_Default;
+        float mRadius = 0;
+    };
+
+    CastRayOptions parseCastRayOptions(const sol::optional<sol::table>& options)
+    {
+        CastRayOptions result;
+        if (options)
+        {
+            result.mIgnore = parseIgnoreList<MWWorld::ConstPtr>(*options);
+            result.mCollisionType
+                = options->get<sol::optional<int>>("collisionType").value_or(result.mCollisionType);
+            result.mRadius = options->get<sol::optional<float>>("radius").value_or(0);
+        }
+        if (result.mRadius > 0)
+        {
+            for (const auto& ptr : result.mIgnore)
+            {
+                if (!ptr.isEmpty())
+                    throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
+            }
+        }
+        return result;
+    }
 }
 
 namespace sol
@@ -109,47 +149,30 @@ namespace MWLua
                     { "VisualOnly", MWPhysics::CollisionType_VisualOnly },
                 }));
 
-        api["castRay"] = [](const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table> options) {
-            std::vector<MWWorld::ConstPtr> ignore;
-            int collisionType = MWPhysics::CollisionType_Default;
-            float radius = 0;
-            if (options)
-            {
-                ignore = parseIgnoreList<MWWorld::ConstPtr>(*options);
-                collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
-                radius = options->get<sol::optional<float>>("radius").value_or(0);
-            }
+        api["castRay"] = [](const osg::Vec3f& from, const osg::Vec3f& to, const sol::optional<sol::table>& options) {
+            const CastRayOptions castOptions = parseCastRayOptions(options);
             const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-            if (radius <= 0)
-            {
-                return rayCasting->castRay(from, to, ignore, {}, collisionType);
-            }
+            if (castOptions.mRadius <= 0)
+                return rayCasting->castRay(from, to, castOptions.mIgnore, {}, castOptions.mCollisionType);
             else
-            {
-                for (const auto& ptr : ignore)
-                {
-                    if (!ptr.isEmpty())
-                        throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
-                }
-                return rayCasting->castSphere(from, to, radius, collisionType);
-            }
+                return rayCasting->castSphere(from, to, castOptions.mRadius, castOptions.mCollisionType);
+        };
+        api["asyncCastRay"] = [context](const sol::table& callback, const osg::Vec3f& from, const osg::Vec3f& to,
+                                  const sol::optional<sol::table>& options) {
+            context.mLuaManager->addAction(
+                [context, castOptions = parseCastRayOptions(options), callback = LuaUtil::Callback::fromLua(callback),
+                    from, to] {
+                    // Physics threads cast the ray with the next simulation, the result is passed to the callback
+                    // on the main thread one frame later.
+                    MWBase::Environment::get().getWorld()->getRayCasting()->asyncCastRay(from, to,
+                        castOptions.mRadius, castOptions.mIgnore, castOptions.mCollisionType, 0xff,
+                        [context, callback](const MWPhysics::RayCastingResult& result) {
+                            context.mLuaManager->queueCallback(
+                                callback, sol::main_object(context.mLua->unsafeState(), sol::in_place, result));
+                        });
+                },
+                "asyncCastRayAction");
         };
-        // TODO: async raycasting
-        /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
-            const Callback& luaCallback, const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table>
-        options)
-        {
-            std::function<void(MWPhysics::RayCastingResult)> callback =
-                luaManager->wrapLuaCallback<MWPhysics::RayCastingResult>(luaCallback);
-            MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-
-            // Handle options the same way as in `castRay`.
-
-            // NOTE: `callback` is not thread safe. If MWPhysics works in separate thread, it must put results to a
-        queue
-            //       and use this callback from the main thread at the beginning of the next frame processing.
-            rayCasting->asyncCastRay(callback, from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
-        };*/
         api["castRenderingRay"] = [manager = context.mLuaManager](const osg::Vec3f& from, const osg::Vec3f& to,
                                       const sol::optional<sol::table>& options) {
             if (!manager->isProcessingInputEvents())
@@ -200,6 +223,32 @@ namespace MWLua
         api["items"] = LObjectList{ objectLists->getItemsInScene() };
         api["players"] = LObjectList{ objectLists->getPlayers() };
 
+        api["OBJECT_GROUP"]
+            = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, ObjectLists::Group>(lua,
+                {
+                    { "Activators", ObjectLists::Group::Activators },
+                    { "Actors", ObjectLists::Group::Actors },
+                    { "Containers", ObjectLists::Group::Containers },
+                    { "Doors", ObjectLists::Group::Doors },
+                    { "Items", ObjectLists::Group::Items },
+                }));
+
+        api["getObjectsInRadius"] = [objectLists](const osg::Vec3f& center, float radius,
+                                        const sol::optional<sol::table>& options) {
+            return LObjectList{ objectLists->findInRadius(center, radius, parseObjectGroup(options)) };
+        };
+        api["getObjectsInBox"] = [objectLists](const osg::Vec3f& min, const osg::Vec3f& max,
+                                     const sol::optional<sol::table>& options) {
+            return LObjectList{ objectLists->findInBox(min, max, parseObjectGroup(options)) };
+        };
+        api["getNearestObjects"] = [objectLists](const osg::Vec3f& center, std::size_t count,
+                                       const sol::optional<sol::table>& options) {
+            float maxDistance = std::numeric_limits<float>::infinity();
+            if (options)
+                maxDistance = options->get<sol::optional<float>>("maxDistance").value_or(maxDistance);
+            return LObjectList{ objectLists->findNearest(center, count, maxDistance, parseObjectGroup(options)) };
+        };
+
         api["NAVIGATOR_FLAGS"]
             = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, DetourNavigator::Flag>(lua,
                 {
@@ -239,62 +288,102 @@ namespace MWLua
         static constexpr DetourNavigator::Flags defaultIncludeFlags = DetourNavigator::Flag_walk
             | DetourNavigator::Flag_swim | DetourNavigator::Flag_openDoor | DetourNavigator::Flag_usePathgrid;
 
-        api["findPath"]
-            = [lua](const osg::Vec3f& source, const osg::Vec3f& destination, const sol::optional<sol::table>& options) {
-                  DetourNavigator::AgentBounds agentBounds = defaultAgentBounds;
-                  DetourNavigator::Flags includeFlags = defaultIncludeFlags;
-                  DetourNavigator::AreaCosts areaCosts{};
-                  float destinationTolerance = 1;
-                  std::vector<osg::Vec3f> checkpoints;
+        static constexpr auto makePathQuery = [](const osg::Vec3f& source, const osg::Vec3f& destination,
+                                                  const sol::optional<sol::table>& options) {
+            DetourNavigator::PathQuery query{
+                .mAgentBounds = defaultAgentBounds,
+                .mStart = source,
+                .mEnd = destination,
+                .mIncludeFlags = defaultIncludeFlags,
+                .mAreaCosts = {},
+                .mEndTolerance = 1,
+                .mCheckpoints = {},
+            };
 
-                  if (options.has_value())
-                  {
-                      if (const auto& t = options->get<sol::optional<sol::table>>("agentBounds"))
-                      {
-                          if (const auto& v = t->get<sol::optional<DetourNavigator::CollisionShapeType>>("shapeType"))
-                              agentBounds.mShapeType = *v;
-                          if (const auto& v = t->get<sol::optional<osg::Vec3f>>("halfExtents"))
-                              agentBounds.mHalfExtents = *v;
-                      }
-                      if (const auto& v = options->get<sol::optional<DetourNavigator::Flags>>("includeFlags"))
-                          includeFlags = *v;
-                      if (const auto& t = options->get<sol::optional<sol::table>>("areaCosts"))
-                      {
-                          if (const auto& v = t->get<sol::optional<float>>("water"))
-                              areaCosts.mWater = *v;
-                          if (const auto& v = t->get<sol::optional<float>>("door"))
-                              areaCosts.mDoor = *v;
-                          if (const auto& v = t->get<sol::optional<float>>("pathgrid"))
-                              areaCosts.mPathgrid = *v;
-                          if (const auto& v = t->get<sol::optional<float>>("ground"))
-                              areaCosts.mGround = *v;
-                      }
-                      if (const auto& v = options->get<sol::optional<float>>("destinationTolerance"))
-                          destinationTolerance = *v;
-                      if (const auto& t = options->get<sol::optional<sol::table>>("checkpoints"))
-                      {
-                          for (const auto& [k, v] : *t)
-                          {
-                              const int index = k.as<int>();
-                              const osg::Vec3f position = v.as<osg::Vec3f>();
-                              if (index != static_cast<int>(checkpoints.size() + 1))
-                                  throw std::runtime_error("checkpoints is not an array");
-                              checkpoints.push_back(position);
-                          }
-                      }
-                  }
+            if (options.has_value())
+            {
+                if (const auto& t = options->get<sol::optional<sol::table>>("agentBounds"))
+                {
+                    if (const auto& v = t->get<sol::optional<DetourNavigator::CollisionShapeType>>("shapeType"))
+                        query.mAgentBounds.mShapeType = *v;
+                    if (const auto& v = t->get<sol::optional<osg::Vec3f>>("halfExtents"))
+                        query.mAgentBounds.mHalfExtents = *v;
+                }
+                if (const auto& v = options->get<sol::optional<DetourNavigator::Flags>>("includeFlags"))
+                    query.mIncludeFlags = *v;
+                if (const auto& t = options->get<sol::optional<sol::table>>("areaCosts"))
+                {
+                    if (const auto& v = t->get<sol::optional<float>>("water"))
+                        query.mAreaCosts.mWater = *v;
+                    if (const auto& v = t->get<sol::optional<float>>("door"))
+                        query.mAreaCosts.mDoor = *v;
+                    if (const auto& v = t->get<sol::optional<float>>("pathgrid"))
+                        query.mAreaCosts.mPathgrid = *v;
+                    if (const auto& v = t->get<sol::optional<float>>("ground"))
+                        query.mAreaCosts.mGround = *v;
+                }
+                if (const auto& v = options->get<sol::optional<float>>("destinationTolerance"))
+                    query.mEndTolerance = *v;
+                if (const auto& t = options->get<sol::optional<sol::table>>("checkpoints"))
+                {
+                    for (const auto& [k, v] : *t)
+                    {
+                        const int index = k.as<int>();
+                        const osg::Vec3f position = v.as<osg::Vec3f>();
+                        if (index != static_cast<int>(query.mCheckpoints.size() + 1))
+                            throw std::runtime_error("checkpoints is not an array");
+                        query.mCheckpoints.push_back(position);
+                    }
+                }
+            }
 
-                  std::vector<osg::Vec3f> path;
+            return query;
+        };
 
-                  const DetourNavigator::Status status = DetourNavigator::findPath(
-                      *MWBase::Environment::get().getWorld()->getNavigator(), agentBounds, source, destination,
-                      includeFlags, areaCosts, destinationTolerance, checkpoints, std::back_inserter(path));
+        static constexpr auto runPathQuery = [](const DetourNavigator::PathQuery& query) {
+            DetourNavigator::PathQueryResult result;
+            result.mStatus = DetourNavigator::findPath(*MWBase::Environment::get().getWorld()->getNavigator(),
+                query.mAgentBounds, query.mStart, query.mEnd, query.mIncludeFlags, query.mAreaCosts,
+                query.mEndTolerance, query.mCheckpoints, std::back_inserter(result.mPath));
+            return result;
+        };
 
-                  sol::table result(lua, sol::create);
-                  LuaUtil::copyVectorToTable(path, result);
-                  return std::make_tuple(status, result);
+        api["findPath"]
+            = [lua](const osg::Vec3f& source, const osg::Vec3f& destination, const sol::optional<sol::table>& options) {
+                  const DetourNavigator::PathQueryResult result
+                      = runPathQuery(makePathQuery(source, destination, options));
+                  sol::table path(lua, sol::create);
+                  LuaUtil::copyVectorToTable(result.mPath, path);
+                  return std::make_tuple(result.mStatus, path);
               };
 
+        api["asyncFindPath"] = [context](const sol::table& callback, const osg::Vec3f& source,
+                                   const osg::Vec3f& destination, const sol::optional<sol::table>& options) {
+            const auto deliver = [context, callback = LuaUtil::Callback::fromLua(callback)](
+                                     const DetourNavigator::PathQueryResult& result) {
+                sol::state_view lua = context.mLua->unsafeState();
+                sol::table path(lua, sol::create);
+                LuaUtil::copyVectorToTable(result.mPath, path);
+                sol::table value(lua, sol::create);
+                value["status"] = result.mStatus;
+                value["path"] = path;
+                context.mLuaManager->queueCallback(
+                    callback, sol::main_object(context.mLua->unsafeState(), sol::in_place, value));
+            };
+
+            // Path query service is used only by the main thread while the scripting thread is not running
+            context.mLuaManager->addAction(
+                [deliver, query = makePathQuery(source, destination, options)]() mutable {
+                    DetourNavigator::PathQueryService* const service
+                        = MWBase::Environment::get().getWorld()->getPathQueryService();
+                    if (service == nullptr)
+                        return deliver(runPathQuery(query));
+                    service->enqueue(std::move(query),
+                        [deliver](DetourNavigator::PathQueryResult&& result) { deliver(result); });
+                },
+                "asyncFindPathAction");
+        };
+
         api["findRandomPointAroundCircle"] = [](const osg::Vec3f& position, float maxRadius,
                                                  const sol::optional<sol::table>& options) {
             DetourNavigator::AgentBounds agentBounds = defaultAgentBounds;
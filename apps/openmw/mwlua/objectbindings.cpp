@@ -24,6 +24,7 @@
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
+#include "localshard.hpp"
 #include "luaevents.hpp"
 #include "luamanagerimp.hpp"
 #include "types/types.hpp"
@@ -339,8 +340,7 @@ namespace MWLua
             objectT[sol::meta_function::equal_to] = [](const ObjectT& a, const ObjectT& b) { return a.id() == b.id(); };
             objectT[sol::meta_function::to_string] = &ObjectT::toString;
             objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData) {
-                context.mLuaEvents->addLocalEvent(
-                    { dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addLocalEvent(dest.id(), std::move(eventName), eventData);
             };
 
             objectT["activateBy"] = [](const ObjectT& object, const ObjectT& actor) {
@@ -617,6 +617,7 @@ namespace MWLua
                     throw std::runtime_error(
                         std::string("Incorrect type argument in inventory:getAll: " + LuaUtil::toString(*type)));
 
+                const auto lock = LocalShard::lockWorld();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 ObjectIdList list = std::make_shared<std::vector<ObjectId>>();
@@ -631,6 +632,7 @@ namespace MWLua
             };
 
             inventoryT["countOf"] = [](const InventoryT& inventory, std::string_view recordId) {
+                const auto lock = LocalShard::lockWorld();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 return store.count(ESM::RefId::deserializeText(recordId));
@@ -644,6 +646,7 @@ namespace MWLua
                 };
             }
             inventoryT["isResolved"] = [](const InventoryT& inventory) -> bool {
+                const auto lock = LocalShard::lockWorld();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 // Avoid initializing custom data
                 if (!ptr.getRefData().getCustomData())
@@ -652,6 +655,7 @@ namespace MWLua
                 return store.isResolved();
             };
             inventoryT["find"] = [](const InventoryT& inventory, std::string_view recordId) -> sol::optional<ObjectT> {
+                const auto lock = LocalShard::lockWorld();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 auto itemId = ESM::RefId::deserializeText(recordId);
@@ -666,6 +670,7 @@ namespace MWLua
                 return sol::nullopt;
             };
             inventoryT["findAll"] = [](const InventoryT& inventory, std::string_view recordId) {
+                const auto lock = LocalShard::lockWorld();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 auto itemId = ESM::RefId::deserializeText(recordId);
@@ -1,5 +1,9 @@
 #include "objectlists.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
 #include <components/misc/resourcehelpers.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -14,11 +18,12 @@ namespace MWLua
 
     void ObjectLists::update()
     {
-        mActivatorsInScene.updateList();
-        mActorsInScene.updateList();
-        mContainersInScene.updateList();
-        mDoorsInScene.updateList();
-        mItemsInScene.updateList();
+        for (ObjectGroup* group :
+            { &mActivatorsInScene, &mActorsInScene, &mContainersInScene, &mDoorsInScene, &mItemsInScene })
+        {
+            group->updateList();
+            group->updatePositions();
+        }
     }
 
     void ObjectLists::clear()
@@ -50,6 +55,70 @@ namespace MWLua
         return nullptr;
     }
 
+    const ObjectLists::ObjectGroup& ObjectLists::getGroup(Group group) const
+    {
+        switch (group)
+        {
+            case Group::Activators:
+                return mActivatorsInScene;
+            case Group::Actors:
+                return mActorsInScene;
+            case Group::Containers:
+                return mContainersInScene;
+            case Group::Doors:
+                return mDoorsInScene;
+            case Group::Items:
+                return mItemsInScene;
+        }
+        throw std::logic_error("Unknown object group: " + std::to_string(static_cast<int>(group)));
+    }
+
+    template <class F>
+    void ObjectLists::forEachGroup(std::optional<Group> group, F&& f) const
+    {
+        if (group.has_value())
+            return f(getGroup(*group));
+        for (const ObjectGroup* v :
+            { &mActivatorsInScene, &mActorsInScene, &mContainersInScene, &mDoorsInScene, &mItemsInScene })
+            f(*v);
+    }
+
+    ObjectIdList ObjectLists::findInRadius(const osg::Vec3f& center, float radius, std::optional<Group> group) const
+    {
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        forEachGroup(group, [&](const ObjectGroup& v) {
+            v.mGrid.findInRadius(center, radius, [&](ObjectId id, const osg::Vec3f&) { result->push_back(id); });
+        });
+        return result;
+    }
+
+    ObjectIdList ObjectLists::findInBox(const osg::Vec3f& min, const osg::Vec3f& max, std::optional<Group> group) const
+    {
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        forEachGroup(group, [&](const ObjectGroup& v) {
+            v.mGrid.findInBox(min, max, [&](ObjectId id, const osg::Vec3f&) { result->push_back(id); });
+        });
+        return result;
+    }
+
+    ObjectIdList ObjectLists::findNearest(
+        const osg::Vec3f& center, std::size_t count, float maxDistance, std::optional<Group> group) const
+    {
+        std::vector<std::pair<ObjectId, float>> nearest;
+        forEachGroup(group, [&](const ObjectGroup& v) {
+            const auto groupNearest = v.mGrid.findNearest(center, count, maxDistance);
+            nearest.insert(nearest.end(), groupNearest.begin(), groupNearest.end());
+        });
+        const std::size_t size = std::min(count, nearest.size());
+        std::partial_sort(nearest.begin(), nearest.begin() + size, nearest.end(),
+            [](const auto& l, const auto& r) { return l.second < r.second; });
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        result->reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result->push_back(nearest[i].first);
+        return result;
+    }
+
     void ObjectLists::objectAddedToScene(const MWWorld::Ptr& ptr)
     {
         MWBase::Environment::get().getWorldModel()->registerPtr(ptr);
@@ -70,28 +139,41 @@ namespace MWLua
         if (mChanged)
         {
             mList->clear();
-            for (ObjectId id : mSet)
+            for (const auto& [id, ptr] : mObjects)
                 mList->push_back(id);
             mChanged = false;
         }
     }
 
+    void ObjectLists::ObjectGroup::updatePositions()
+    {
+        // Objects can be moved by physics, AI, animations and mwscripts. Bucket of an object in the grid is changed
+        // only if the object crosses a cell border, so updating everything is cheap.
+        for (const auto& [id, ptr] : mObjects)
+            mGrid.update(id, ptr.getRefData().getPosition().asVec3());
+    }
+
     void ObjectLists::ObjectGroup::clear()
     {
         mChanged = false;
         mList->clear();
-        mSet.clear();
+        mObjects.clear();
+        mGrid.clear();
     }
 
     void ObjectLists::addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
     {
-        group.mSet.insert(getId(ptr));
+        const ObjectId id = getId(ptr);
+        group.mObjects.insert_or_assign(id, ptr);
+        group.mGrid.insert(id, ptr.getRefData().getPosition().asVec3());
         group.mChanged = true;
     }
 
     void ObjectLists::removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
     {
-        group.mSet.erase(getId(ptr));
+        const ObjectId id = getId(ptr);
+        group.mObjects.erase(id);
+        group.mGrid.erase(id);
         group.mChanged = true;
     }
 }
@@ -1,7 +1,12 @@
 #ifndef MWLUA_OBJECTLISTS_H
 #define MWLUA_OBJECTLISTS_H
 
-#include <set>
+#include <map>
+#include <optional>
+
+#include <osg/Vec3f>
+
+#include <components/misc/spatialgrid.hpp>
 
 #include "object.hpp"
 
@@ -9,9 +14,19 @@ namespace MWLua
 {
 
     // ObjectLists is used to track lists of game objects like nearby.items, nearby.actors, etc.
+    // Positions of the objects are indexed by spatial grids to find nearby objects without checking every object.
     class ObjectLists
     {
     public:
+        enum class Group
+        {
+            Activators,
+            Actors,
+            Containers,
+            Doors,
+            Items,
+        };
+
         void update(); // Should be called every frame.
         void clear(); // Should be called every time before starting or loading a new game.
 
@@ -22,23 +37,41 @@ namespace MWLua
         ObjectIdList getItemsInScene() const { return mItemsInScene.mList; }
         ObjectIdList getPlayers() const { return mPlayers; }
 
+        // Spatial queries use positions from the last call of `update`. If `group` is not set, all groups are
+        // searched.
+        ObjectIdList findInRadius(const osg::Vec3f& center, float radius, std::optional<Group> group) const;
+        ObjectIdList findInBox(const osg::Vec3f& min, const osg::Vec3f& max, std::optional<Group> group) const;
+        // Result is ordered by distance.
+        ObjectIdList findNearest(
+            const osg::Vec3f& center, std::size_t count, float maxDistance, std::optional<Group> group) const;
+
         void objectAddedToScene(const MWWorld::Ptr& ptr);
         void objectRemovedFromScene(const MWWorld::Ptr& ptr);
 
         void setPlayer(const MWWorld::Ptr& player) { *mPlayers = { getId(player) }; }
 
     private:
+        // Roughly the size of a room, a typical radius of nearby queries covers only a few grid cells
+        static constexpr float sGridCellSize = 1024;
+
         struct ObjectGroup
         {
             void updateList();
+            void updatePositions();
             void clear();
 
             bool mChanged = false;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
-            std::set<ObjectId> mSet;
+            std::map<ObjectId, MWWorld::Ptr> mObjects;
+            Misc::SpatialGrid<ObjectId> mGrid{ sGridCellSize };
         };
 
         ObjectGroup* chooseGroup(const MWWorld::Ptr& ptr);
+        const ObjectGroup& getGroup(Group group) const;
+
+        template <class F>
+        void forEachGroup(std::optional<Group> group, F&& f) const;
+
         void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
@@ -19,6 +19,7 @@
 #include "apps/openmw/mwworld/worldmodel.hpp"
 
 #include "../localscripts.hpp"
+#include "../localshard.hpp"
 #include "../luamanagerimp.hpp"
 #include "../magicbindings.hpp"
 #include "../stats.hpp"
@@ -250,6 +251,7 @@ namespace MWLua
         };
 
         actor["getSelectedEnchantedItem"] = [](sol::this_state thisState, const Object& o) -> sol::object {
+            const auto lock = LocalShard::lockWorld();
             const MWWorld::Ptr& ptr = o.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return sol::nil;
@@ -312,6 +314,7 @@ namespace MWLua
         actor["inventory"] = sol::overload([](const LObject& o) { return Inventory<LObject>{ o }; },
             [](const GObject& o) { return Inventory<GObject>{ o }; });
         auto getAllEquipment = [](sol::this_state thisState, const Object& o) {
+            const auto lock = LocalShard::lockWorld();
             const MWWorld::Ptr& ptr = o.ptr();
             sol::table equipment(thisState, sol::create);
             if (!ptr.getClass().hasInventoryStore(ptr))
@@ -332,6 +335,7 @@ namespace MWLua
             return equipment;
         };
         auto getEquipmentFromSlot = [](sol::this_state thisState, const Object& o, int slot) -> sol::object {
+            const auto lock = LocalShard::lockWorld();
             const MWWorld::Ptr& ptr = o.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return sol::nil;
@@ -348,6 +352,7 @@ namespace MWLua
         actor["getEquipment"] = sol::overload(getAllEquipment, getEquipmentFromSlot);
         actor["equipment"] = actor["getEquipment"]; // for compatibility; should be removed later
         actor["hasEquipped"] = [](const Object& o, const Object& item) {
+            const auto lock = LocalShard::lockWorld();
             const MWWorld::Ptr& ptr = o.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return false;
@@ -76,10 +76,7 @@ namespace MWLua
             {
                 ObjectId id = loadRefNum(binaryData);
                 adjustRefNum(id);
-                if (mLocalSerializer)
-                    sol::stack::push<LObject>(lua, LObject(id));
-                else
-                    sol::stack::push<GObject>(lua, GObject(id));
+                pushObject(lua, id);
                 return true;
             }
             if (typeName == sObjListTypeName)
@@ -95,15 +92,46 @@ namespace MWLua
                     id.mContentFile = Misc::fromLittleEndian(id.mContentFile);
                     adjustRefNum(id);
                 }
-                if (mLocalSerializer)
-                    sol::stack::push<LObjectList>(lua, LObjectList{ std::move(objList) });
-                else
-                    sol::stack::push<GObjectList>(lua, GObjectList{ std::move(objList) });
+                pushObjectList(lua, std::move(objList));
                 return true;
             }
             return false;
         }
 
+        // Pushes on stack the same value as deserialize(serialize(data)), but without the binary round trip.
+        bool copy(const sol::userdata& data, lua_State* lua) const override
+        {
+            if (data.is<GObject>() || data.is<LObject>())
+            {
+                pushObject(lua, data.as<Object>().id());
+                return true;
+            }
+            if (data.is<GObjectList>() || data.is<LObjectList>())
+            {
+                const ObjectIdList& ids = data.is<GObjectList>() ? data.as<GObjectList>().mIds
+                                                                 : data.as<LObjectList>().mIds;
+                pushObjectList(lua, std::make_shared<std::vector<ESM::RefNum>>(*ids));
+                return true;
+            }
+            return false;
+        }
+
+        void pushObject(lua_State* lua, ObjectId id) const
+        {
+            if (mLocalSerializer)
+                sol::stack::push<LObject>(lua, LObject(id));
+            else
+                sol::stack::push<GObject>(lua, GObject(id));
+        }
+
+        void pushObjectList(lua_State* lua, ObjectIdList&& objList) const
+        {
+            if (mLocalSerializer)
+                sol::stack::push<LObjectList>(lua, LObjectList{ std::move(objList) });
+            else
+                sol::stack::push<GObjectList>(lua, GObjectList{ std::move(objList) });
+        }
+
         bool mLocalSerializer;
         std::map<int, int>* mContentFileMapping;
     };
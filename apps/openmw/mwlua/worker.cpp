@@ -5,6 +5,7 @@
 #include "apps/openmw/profile.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/settings/values.hpp>
 
 #include <cassert>
@@ -73,6 +74,7 @@ namespace MWLua
 
     void Worker::run() noexcept
     {
+        Debug::Trace::setThreadName("Lua worker");
         while (true)
         {
             std::unique_lock<std::mutex> lk(mMutex);
@@ -141,6 +141,8 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
     MWBase::World* world = MWBase::Environment::get().getWorld();
     const DetourNavigator::AgentBounds agentBounds = world->getPathfindingAgentBounds(actor);
 
+    mPathFinder.collectAsyncPath();
+
     /// Stops the actor when it gets too close to a unloaded cell or when the actor is playing a scripted animation
     //... At current time, the first test is unnecessary. AI shuts down when actor is more than
     //... "actors processing range" setting value units from player, and exterior cells are 8192 units long and wide.
@@ -180,7 +182,7 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
                     = world->getStore().get<ESM::Pathgrid>().search(*actor.getCell()->getCell());
                 const DetourNavigator::Flags navigatorFlags = getNavigatorFlags(actor);
                 const DetourNavigator::AreaCosts areaCosts = getAreaCosts(actor, navigatorFlags);
-                mPathFinder.buildLimitedPath(actor, position, dest, getPathGridGraph(pathgrid), agentBounds,
+                mPathFinder.buildLimitedPathAsync(actor, position, dest, getPathGridGraph(pathgrid), agentBounds,
                     navigatorFlags, areaCosts, endTolerance, pathType);
                 mRotateOnTheRunChecks = 3;
 
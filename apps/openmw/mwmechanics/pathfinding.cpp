@@ -2,12 +2,15 @@
 
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <utility>
 
 #include <osg/io_utils>
 
 #include <components/debug/debuglog.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
+#include <components/detournavigator/pathqueryservice.hpp>
 #include <components/misc/coordinateconverter.hpp>
 #include <components/misc/math.hpp>
 #include <components/misc/pathgridutils.hpp>
@@ -115,6 +118,18 @@ namespace
                 && std::abs((position.value() - start).length2() - (end - start).length2()) <= 1;
         }
     };
+
+    osg::Vec3f getLimitedEndPoint(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint)
+    {
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        const auto maxDistance
+            = std::min(navigator->getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
 }
 
 namespace MWMechanics
@@ -314,8 +329,12 @@ namespace MWMechanics
         while (mPath.size() > 1 && sqrDistanceIgnoreZ(mPath.front(), position) < pointTolerance * pointTolerance)
             mPath.pop_front();
 
-        const IsValidShortcut isValidShortcut{ MWBase::Environment::get().getWorld()->getNavigator(), agentBounds,
-            pathFlags };
+        const DetourNavigator::Navigator* const navigator
+            = (updateFlags & (UpdateFlag_ShortenIfAlmostStraight | UpdateFlag_RemoveLoops)) != 0
+            ? MWBase::Environment::get().getWorld()->getNavigator()
+            : nullptr;
+
+        const IsValidShortcut isValidShortcut{ navigator, agentBounds, pathFlags };
 
         if ((updateFlags & UpdateFlag_ShortenIfAlmostStraight) != 0)
         {
@@ -352,11 +371,20 @@ namespace MWMechanics
         }
     }
 
+    struct PathFinder::AsyncPath
+    {
+        bool mReady = false;
+        DetourNavigator::PathQueryResult mResult;
+        PathType mPathType = PathType::Full;
+        const MWWorld::CellStore* mCell = nullptr;
+    };
+
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
+        mAsyncPath = nullptr;
     }
 
     void PathFinder::buildPathByNavMesh(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
@@ -365,6 +393,7 @@ namespace MWMechanics
         std::span<const osg::Vec3f> checkpoints)
     {
         mPath.clear();
+        mAsyncPath = nullptr;
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
         DetourNavigator::Status status = buildPathByNavigatorImpl(actor, startPoint, endPoint, agentBounds, flags,
@@ -386,6 +415,7 @@ namespace MWMechanics
     {
         mPath.clear();
         mCell = actor.getCell();
+        mAsyncPath = nullptr;
 
         DetourNavigator::Status status = DetourNavigator::Status::NavMeshNotFound;
 
@@ -446,15 +476,80 @@ namespace MWMechanics
         const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
         PathType pathType)
     {
-        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance
-            = std::min(navigator->getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(
+        buildPath(actor, startPoint, getLimitedEndPoint(startPoint, endPoint), pathgridGraph, agentBounds, flags,
+            areaCosts, endTolerance, pathType);
+    }
+
+    void PathFinder::buildLimitedPathAsync(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType)
+    {
+        DetourNavigator::PathQueryService* const service
+            = MWBase::Environment::get().getWorld()->getPathQueryService();
+
+        if (service == nullptr || mAsyncPathFailed || actor.getClass().isPureWaterCreature(actor)
+            || actor.getClass().isPureFlyingCreature(actor))
+        {
+            mAsyncPathFailed = false;
+            return buildLimitedPath(
                 actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+        }
+
+        // Wait for the previous request, it's going to be collected next frame
+        if (mAsyncPath != nullptr)
+            return;
+
+        enqueueAsyncPath(*service,
+            DetourNavigator::PathQuery{
+                .mAgentBounds = agentBounds,
+                .mStart = startPoint,
+                .mEnd = getLimitedEndPoint(startPoint, endPoint),
+                .mIncludeFlags = flags,
+                .mAreaCosts = areaCosts,
+                .mEndTolerance = endTolerance,
+                .mCheckpoints = {},
+            },
+            pathType, actor.getCell());
+    }
+
+    void PathFinder::enqueueAsyncPath(DetourNavigator::PathQueryService& service, DetourNavigator::PathQuery&& query,
+        PathType pathType, const MWWorld::CellStore* cell)
+    {
+        auto asyncPath = std::make_shared<AsyncPath>();
+        asyncPath->mPathType = pathType;
+        asyncPath->mCell = cell;
+
+        service.enqueue(std::move(query),
+            [weak = std::weak_ptr<AsyncPath>(asyncPath)](DetourNavigator::PathQueryResult&& result) {
+                if (const std::shared_ptr<AsyncPath> asyncPath = weak.lock())
+                {
+                    asyncPath->mResult = std::move(result);
+                    asyncPath->mReady = true;
+                }
+            });
+
+        mAsyncPath = std::move(asyncPath);
+    }
+
+    void PathFinder::collectAsyncPath()
+    {
+        if (mAsyncPath == nullptr || !mAsyncPath->mReady)
+            return;
+
+        const std::shared_ptr<AsyncPath> asyncPath = std::exchange(mAsyncPath, nullptr);
+        const DetourNavigator::PathQueryResult& result = asyncPath->mResult;
+
+        if (result.mStatus == DetourNavigator::Status::Success
+            || (asyncPath->mPathType == PathType::Partial && result.mStatus == DetourNavigator::Status::PartialPath))
+        {
+            mPath.assign(result.mPath.begin(), result.mPath.end());
+            mCell = asyncPath->mCell;
+            mConstructed = !mPath.empty();
+            return;
+        }
+
+        // Keep the current path, the next one is built in the main thread trying pathgrid and straight path as well
+        mAsyncPathFailed = true;
     }
 }
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <deque>
 #include <iterator>
+#include <memory>
 #include <span>
 
 #include <osg/Vec3f>
@@ -22,6 +23,8 @@ namespace MWWorld
 namespace DetourNavigator
 {
     struct AgentBounds;
+    struct PathQuery;
+    class PathQueryService;
 }
 
 namespace MWMechanics
@@ -99,6 +102,7 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            mAsyncPath = nullptr;
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -118,11 +122,26 @@ namespace MWMechanics
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
             PathType pathType);
 
+        /// Same as buildLimitedPath but the path over navmesh is found in background when it's possible. The current
+        /// path is kept until collectAsyncPath replaces it. Falls back to buildLimitedPath when the path is not found.
+        void buildLimitedPathAsync(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
+
+        /// Find the path by the service in background. The current path is kept until collectAsyncPath replaces it.
+        void enqueueAsyncPath(DetourNavigator::PathQueryService& service, DetourNavigator::PathQuery&& query,
+            PathType pathType, const MWWorld::CellStore* cell);
+
+        /// Use the path found in background if it's ready
+        void collectAsyncPath();
+
         /// Remove front point if exist and within tolerance
         void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
             UpdateFlags updateFlags, const DetourNavigator::AgentBounds& agentBounds, DetourNavigator::Flags pathFlags);
 
-        bool checkPathCompleted() const { return mConstructed && mPath.empty(); }
+        /// Path is not completed while the next one is being found in background
+        bool checkPathCompleted() const { return mConstructed && mPath.empty() && mAsyncPath == nullptr; }
 
         /// In radians
         float getZAngleToNext(float x, float y) const;
@@ -144,9 +163,13 @@ namespace MWMechanics
         }
 
     private:
+        struct AsyncPath;
+
         bool mConstructed = false;
         std::deque<osg::Vec3f> mPath;
         const MWWorld::CellStore* mCell = nullptr;
+        std::shared_ptr<AsyncPath> mAsyncPath;
+        bool mAsyncPathFailed = false;
 
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
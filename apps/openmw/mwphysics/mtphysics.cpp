@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <functional>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
@@ -10,11 +11,13 @@
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <LinearMath/btThreads.h>
 
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/trace.hpp"
 #include "components/misc/convert.hpp"
 #include <components/misc/barrier.hpp>
 #include <components/settings/values.hpp>
@@ -30,6 +33,7 @@
 #include "../mwbase/world.hpp"
 
 #include "actor.hpp"
+#include "closestnotmerayresultcallback.hpp"
 #include "contacttestwrapper.h"
 #include "movementsolver.hpp"
 #include "object.hpp"
@@ -414,6 +418,7 @@ namespace MWPhysics
         , mAdvanceSimulation(false)
         , mNextJob(0)
         , mNextLOS(0)
+        , mNextRayCast(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -513,6 +518,7 @@ namespace MWPhysics
         prepareWork(timeAccum, simulations, frameStart, frameNumber, stats);
         if (mWorkersSync != nullptr)
             mWorkersSync->wakeUpWorkers();
+        callRayCastCallbacks();
     }
 
     void PhysicsTaskScheduler::prepareWork(float& timeAccum, std::vector<Simulation>& simulations,
@@ -520,6 +526,7 @@ namespace MWPhysics
     {
         // This function run in the main thread.
         // While the mSimulationMutex is held, background physics threads can't run.
+        const Debug::Trace::Scope trace("PhysicsTaskScheduler::prepareWork");
 
         MaybeExclusiveLock lock(mSimulationMutex, mLockingPolicy);
 
@@ -535,6 +542,15 @@ namespace MWPhysics
             updateStats(frameStart, frameNumber, stats);
         }
 
+        // Ray casts done with the previous simulation are delivered after workers are started again
+        std::move(mRayCasts.begin(), mRayCasts.end(), std::back_inserter(mFinishedRayCasts));
+        mRayCasts.clear();
+        {
+            const std::lock_guard lock(mQueuedRayCastsMutex);
+            mRayCasts.swap(mQueuedRayCasts);
+        }
+        mRayCastsCount = mRayCasts.size();
+
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
 
@@ -552,6 +568,7 @@ namespace MWPhysics
         mAdvanceSimulation = (mRemainingSteps != 0);
         mNumJobs = static_cast<int>(mSimulations->size());
         mNextLOS.store(0, std::memory_order_relaxed);
+        mNextRayCast.store(0, std::memory_order_relaxed);
         mNextJob.store(0, std::memory_order_release);
 
         if (mAdvanceSimulation)
@@ -654,7 +671,7 @@ namespace MWPhysics
         btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
-        mCollisionObjects.insert(collisionObject);
+        mCollisionObjects.emplace(collisionObject, ++mLastCollisionObjectId);
         mCollisionWorld->addCollisionObject(collisionObject, collisionFilterGroup, collisionFilterMask);
     }
 
@@ -713,6 +730,116 @@ namespace MWPhysics
         }
     }
 
+    void PhysicsTaskScheduler::queueRayCast(AsyncRayCast&& rayCast)
+    {
+        {
+            MaybeSharedLock lock(mCollisionWorldMutex, mLockingPolicy);
+            rayCast.mIgnoreIds.clear();
+            for (const btCollisionObject* object : rayCast.mIgnore)
+                rayCast.mIgnoreIds.push_back(getCollisionObjectId(object));
+        }
+
+        const std::lock_guard lock(mQueuedRayCastsMutex);
+        mQueuedRayCasts.push_back(std::move(rayCast));
+    }
+
+    AsyncRayCastStats PhysicsTaskScheduler::getAsyncRayCastStats() const
+    {
+        const std::lock_guard lock(mQueuedRayCastsMutex);
+        return AsyncRayCastStats{ .mQueued = mQueuedRayCasts.size(), .mCast = mRayCastsCount };
+    }
+
+    void PhysicsTaskScheduler::castQueuedRays()
+    {
+        int job = 0;
+        const int numRayCasts = static_cast<int>(mRayCasts.size());
+        while ((job = mNextRayCast.fetch_add(1, std::memory_order_relaxed)) < numRayCasts)
+            castRay(mRayCasts[job]);
+    }
+
+    std::uint64_t PhysicsTaskScheduler::getCollisionObjectId(const btCollisionObject* object) const
+    {
+        const auto it = mCollisionObjects.find(object);
+        if (it == mCollisionObjects.end())
+            return 0;
+        return it->second;
+    }
+
+    void PhysicsTaskScheduler::castRay(AsyncRayCast& rayCast) const
+    {
+        // Hit object id has to be taken with the same lock as the cast is done
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+
+        if (rayCast.mRadius <= 0)
+        {
+            if (rayCast.mFrom == rayCast.mTo)
+                return;
+
+            // Don't ignore objects added after the ignored ones are removed
+            for (std::size_t i = 0; i < rayCast.mIgnore.size(); ++i)
+                if (getCollisionObjectId(rayCast.mIgnore[i]) != rayCast.mIgnoreIds[i])
+                    rayCast.mIgnore[i] = nullptr;
+
+            ClosestNotMeRayResultCallback callback(rayCast.mIgnore, {}, rayCast.mFrom, rayCast.mTo);
+            callback.m_collisionFilterGroup = rayCast.mGroup;
+            callback.m_collisionFilterMask = rayCast.mMask;
+
+            mCollisionWorld->rayTest(rayCast.mFrom, rayCast.mTo, callback);
+
+            rayCast.mResult.mHit = callback.hasHit();
+            if (callback.hasHit())
+            {
+                rayCast.mResult.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
+                rayCast.mResult.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
+                rayCast.mHitObject = callback.m_collisionObject;
+                rayCast.mHitObjectId = getCollisionObjectId(rayCast.mHitObject);
+            }
+        }
+        else
+        {
+            btCollisionWorld::ClosestConvexResultCallback callback(rayCast.mFrom, rayCast.mTo);
+            callback.m_collisionFilterGroup = rayCast.mGroup;
+            callback.m_collisionFilterMask = rayCast.mMask;
+
+            const btSphereShape shape(rayCast.mRadius);
+            const btQuaternion rotation = btQuaternion::getIdentity();
+
+            mCollisionWorld->convexSweepTest(
+                &shape, btTransform(rotation, rayCast.mFrom), btTransform(rotation, rayCast.mTo), callback);
+
+            rayCast.mResult.mHit = callback.hasHit();
+            if (callback.hasHit())
+            {
+                rayCast.mResult.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
+                rayCast.mResult.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
+                rayCast.mHitObject = callback.m_hitCollisionObject;
+                rayCast.mHitObjectId = getCollisionObjectId(rayCast.mHitObject);
+            }
+        }
+    }
+
+    void PhysicsTaskScheduler::callRayCastCallbacks()
+    {
+        for (AsyncRayCast& rayCast : mFinishedRayCasts)
+        {
+            // Hit object could be removed since the ray cast was done and another one could get its address
+            if (rayCast.mHitObjectId != 0 && getCollisionObjectId(rayCast.mHitObject) == rayCast.mHitObjectId)
+                if (auto* ptrHolder = static_cast<PtrHolder*>(getUserPointer(rayCast.mHitObject)))
+                    rayCast.mResult.mHitObject = ptrHolder->getPtr();
+
+            try
+            {
+                rayCast.mCallback(rayCast.mResult);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Async ray cast callback has failed: " << e.what();
+            }
+        }
+
+        mFinishedRayCasts.clear();
+    }
+
     void PhysicsTaskScheduler::updateAabbs()
     {
         MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
@@ -746,6 +873,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
+        Debug::Trace::setThreadName("Physics worker");
         mWorkersSync->runWorker([this] {
             std::shared_lock lock(mSimulationMutex);
             doSimulation();
@@ -780,6 +908,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::doSimulation()
     {
+        const Debug::Trace::Scope trace("PhysicsTaskScheduler::doSimulation");
         while (mRemainingSteps)
         {
             mPreStepBarrier->wait([this] { afterPreStep(); });
@@ -793,6 +922,7 @@ namespace MWPhysics
         }
 
         refreshLOSCache();
+        castQueuedRays();
         mPostSimBarrier->wait([this] { afterPostSim(); });
     }
 
@@ -822,7 +952,7 @@ namespace MWPhysics
         auto it = mCollisionObjects.find(object);
         if (it == mCollisionObjects.end())
             return nullptr;
-        return (*it)->getUserPointer();
+        return it->first->getUserPointer();
     }
 
     void PhysicsTaskScheduler::releaseSharedStates()
@@ -3,12 +3,15 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <shared_mutex>
 #include <thread>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
@@ -37,6 +40,28 @@ namespace MWPhysics
         AllowSharedLocks,
     };
 
+    struct AsyncRayCast
+    {
+        btVector3 mFrom;
+        btVector3 mTo;
+        float mRadius = 0;
+        int mMask = CollisionType_Default;
+        int mGroup = 0xff;
+        std::vector<const btCollisionObject*> mIgnore;
+        AsyncRayCastingCallback mCallback;
+        // Ids tell apart objects which got the same address as removed ones
+        std::vector<std::uint64_t> mIgnoreIds;
+        const btCollisionObject* mHitObject = nullptr;
+        std::uint64_t mHitObjectId = 0;
+        RayCastingResult mResult{};
+    };
+
+    struct AsyncRayCastStats
+    {
+        std::size_t mQueued = 0;
+        std::size_t mCast = 0;
+    };
+
     class PhysicsTaskScheduler
     {
     public:
@@ -67,6 +92,10 @@ namespace MWPhysics
         void removeCollisionObject(btCollisionObject* collisionObject);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// Ray casts are done by the physics threads after the next simulation, callbacks are called from
+        /// applyQueuedMovements on the main thread one frame later.
+        void queueRayCast(AsyncRayCast&& rayCast);
+        AsyncRayCastStats getAsyncRayCastStats() const;
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -80,6 +109,10 @@ namespace MWPhysics
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
+        void castQueuedRays();
+        void castRay(AsyncRayCast& rayCast) const;
+        std::uint64_t getCollisionObjectId(const btCollisionObject* object) const;
+        void callRayCastCallbacks();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -94,13 +127,18 @@ namespace MWPhysics
 
         std::unique_ptr<WorldFrameData> mWorldFrameData;
         std::vector<Simulation>* mSimulations = nullptr;
-        std::unordered_set<const btCollisionObject*> mCollisionObjects;
+        std::unordered_map<const btCollisionObject*, std::uint64_t> mCollisionObjects; // object -> id
+        std::uint64_t mLastCollisionObjectId = 0;
         float mDefaultPhysicsDt;
         float mPhysicsDt;
         float mTimeAccum;
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
         std::vector<LOSRequest> mLOSCache;
+        std::vector<AsyncRayCast> mQueuedRayCasts;
+        std::vector<AsyncRayCast> mRayCasts;
+        std::vector<AsyncRayCast> mFinishedRayCasts;
+        std::size_t mRayCastsCount = 0;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
         // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
@@ -116,12 +154,14 @@ namespace MWPhysics
         bool mAdvanceSimulation;
         std::atomic<int> mNextJob;
         std::atomic<int> mNextLOS;
+        std::atomic<int> mNextRayCast;
         std::vector<std::thread> mThreads;
 
         mutable std::shared_mutex mSimulationMutex;
         mutable std::shared_mutex mCollisionWorldMutex;
         mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
+        mutable std::mutex mQueuedRayCastsMutex;
 
         unsigned int mFrameNumber;
         const osg::Timer* mTimer;
@@ -204,25 +204,9 @@ namespace MWPhysics
         btVector3 btFrom = Misc::Convert::toBullet(from);
         btVector3 btTo = Misc::Convert::toBullet(to);
 
-        std::vector<const btCollisionObject*> ignoreList;
+        std::vector<const btCollisionObject*> ignoreList = getCollisionObjects(ignore);
         std::vector<const btCollisionObject*> targetCollisionObjects;
 
-        for (const auto& ptr : ignore)
-        {
-            if (!ptr.isEmpty())
-            {
-                const Actor* actor = getActor(ptr);
-                if (actor)
-                    ignoreList.push_back(actor->getCollisionObject());
-                else
-                {
-                    const Object* object = getObject(ptr);
-                    if (object)
-                        ignoreList.push_back(object->getCollisionObject());
-                }
-            }
-        }
-
         if (!targets.empty())
         {
             for (const MWWorld::Ptr& target : targets)
@@ -251,6 +235,44 @@ namespace MWPhysics
         return result;
     }
 
+    void PhysicsSystem::asyncCastRay(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
+        const std::vector<MWWorld::ConstPtr>& ignore, int mask, int group, AsyncRayCastingCallback&& callback) const
+    {
+        mTaskScheduler->queueRayCast(AsyncRayCast{
+            .mFrom = Misc::Convert::toBullet(from),
+            .mTo = Misc::Convert::toBullet(to),
+            .mRadius = radius,
+            .mMask = mask,
+            .mGroup = group,
+            .mIgnore = getCollisionObjects(ignore),
+            .mCallback = std::move(callback),
+        });
+    }
+
+    std::vector<const btCollisionObject*> PhysicsSystem::getCollisionObjects(
+        const std::vector<MWWorld::ConstPtr>& ptrs) const
+    {
+        std::vector<const btCollisionObject*> result;
+
+        for (const auto& ptr : ptrs)
+        {
+            if (!ptr.isEmpty())
+            {
+                const Actor* actor = getActor(ptr);
+                if (actor)
+                    result.push_back(actor->getCollisionObject());
+                else
+                {
+                    const Object* object = getObject(ptr);
+                    if (object)
+                        result.push_back(object->getCollisionObject());
+                }
+            }
+        }
+
+        return result;
+    }
+
     RayCastingResult PhysicsSystem::castSphere(
         const osg::Vec3f& from, const osg::Vec3f& to, float radius, int mask, int group) const
     {
@@ -869,6 +891,10 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Objects", static_cast<double>(mObjects.size()));
         stats.setAttribute(frameNumber, "Physics Projectiles", static_cast<double>(mProjectiles.size()));
         stats.setAttribute(frameNumber, "Physics HeightFields", static_cast<double>(mHeightFields.size()));
+
+        const AsyncRayCastStats rayCastStats = mTaskScheduler->getAsyncRayCastStats();
+        stats.setAttribute(frameNumber, "Physics Async Rays Queued", static_cast<double>(rayCastStats.mQueued));
+        stats.setAttribute(frameNumber, "Physics Async Rays Cast", static_cast<double>(rayCastStats.mCast));
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
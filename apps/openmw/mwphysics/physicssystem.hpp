@@ -219,6 +219,10 @@ namespace MWPhysics
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
+        void asyncCastRay(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
+            const std::vector<MWWorld::ConstPtr>& ignore, int mask, int group,
+            AsyncRayCastingCallback&& callback) const override;
+
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
@@ -294,6 +298,8 @@ namespace MWPhysics
 
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        std::vector<const btCollisionObject*> getCollisionObjects(const std::vector<MWWorld::ConstPtr>& ptrs) const;
+
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
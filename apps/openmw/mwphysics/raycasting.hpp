@@ -1,6 +1,9 @@
 #ifndef OPENMW_MWPHYSICS_RAYCASTING_H
 #define OPENMW_MWPHYSICS_RAYCASTING_H
 
+#include <functional>
+#include <vector>
+
 #include <osg/Vec3f>
 
 #include "../mwworld/ptr.hpp"
@@ -18,6 +21,8 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    using AsyncRayCastingCallback = std::function<void(const RayCastingResult&)>;
+
     class RayCastingInterface
     {
     public:
@@ -37,6 +42,13 @@ namespace MWPhysics
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
+        /// Queues a ray cast, or a sphere cast if radius is positive, to be done by physics threads together with the
+        /// next simulation. The callback is called from the main thread with the next physics update after that.
+        /// @param ignore Is supported only for ray casts.
+        virtual void asyncCastRay(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
+            const std::vector<MWWorld::ConstPtr>& ignore, int mask, int group,
+            AsyncRayCastingCallback&& callback) const = 0;
+
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
     };
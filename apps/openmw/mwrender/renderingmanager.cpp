@@ -18,6 +18,7 @@
 #include <osgViewer/Viewer>
 
 #include <components/nifosg/nifloader.hpp>
+#include <components/nifosg/posecache.hpp>
 
 #include <components/debug/debuglog.hpp>
 
@@ -36,6 +37,7 @@
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
@@ -330,6 +332,8 @@ namespace MWRender
 
         resourceSystem->getSceneManager()->setParticleSystemMask(MWRender::Mask_ParticleSystem);
 
+        NifOsg::setPoseCacheTimeStep(Settings::game().mAnimationPoseCacheTimeStep);
+
         // Figure out which pipeline must be used by default and inform the user
         bool forceShaders = Settings::shaders().mForceShaders;
         {
@@ -583,6 +587,14 @@ namespace MWRender
         NifOsg::Loader::setHiddenNodeMask(Mask_UpdateVisitor);
         NifOsg::Loader::setIntersectionDisabledNodeMask(Mask_Effect);
         NifOsg::Loader::setSoftEffectEnabled(Settings::shaders().mSoftParticles);
+        if (Settings::models().mCompressKeyframes)
+        {
+            NifOsg::KeyframeCompressionSettings compression;
+            compression.mRotationTolerance = Settings::models().mKeyframeRotationTolerance;
+            compression.mTranslationTolerance = Settings::models().mKeyframeTranslationTolerance;
+            compression.mScaleTolerance = Settings::models().mKeyframeScaleTolerance;
+            NifOsg::Loader::setKeyframeCompression(compression);
+        }
         Nif::Reader::setLoadUnsupportedFiles(Settings::models().mLoadUnsupportedNifFiles);
 
         mStateUpdater->setFogEnd(mViewDistance);
@@ -1504,9 +1516,16 @@ namespace MWRender
     {
         osg::Stats* stats = mViewer->getViewerStats();
         unsigned int frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+        const SceneUtil::MorphStats morphStats = SceneUtil::takeMorphStats();
+        const NifOsg::PoseCacheStats poseCacheStats = NifOsg::takePoseCacheStats();
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            stats->setAttribute(frameNumber, "Morph Geometries", static_cast<double>(morphStats.mGeometries));
+            stats->setAttribute(frameNumber, "Morph Targets", static_cast<double>(morphStats.mTargets));
+            stats->setAttribute(frameNumber, "Morph Vertices", static_cast<double>(morphStats.mVertices));
+            stats->setAttribute(frameNumber, "Pose Cache Get", static_cast<double>(poseCacheStats.mGet));
+            stats->setAttribute(frameNumber, "Pose Cache Hit", static_cast<double>(poseCacheStats.mHit));
         }
     }
 
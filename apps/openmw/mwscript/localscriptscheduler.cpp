@@ -0,0 +1,167 @@
+#include "localscriptscheduler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace MWScript
+{
+    namespace
+    {
+        constexpr unsigned maxPeriod = 8;
+
+        // Number of consecutive runs not changing locals after which a script is considered idle
+        constexpr unsigned idleRuns = 16;
+    }
+
+    void LocalScriptScheduler::beginFrame(float frameDuration)
+    {
+        ++mFrame;
+        mTime += frameDuration;
+        mFrameDuration = frameDuration;
+        mFrameStats = FrameStats{};
+    }
+
+    std::optional<float> LocalScriptScheduler::schedule(
+        const ESM::RefId& script, const void* instance, float distance, bool urgent)
+    {
+        auto [it, inserted] = mInstances.try_emplace(instance);
+        Instance& state = it->second;
+
+        if (inserted || state.mScript != script)
+        {
+            state = Instance{};
+            state.mScript = script;
+            state.mLastRunFrame = mFrame - 1;
+            state.mLastRunTime = mTime - mFrameDuration;
+            urgent = true;
+        }
+
+        state.mLastSeenFrame = mFrame;
+
+        const std::size_t elapsed = mFrame - state.mLastRunFrame;
+
+        if (!urgent && mSettings.mEnabled && !mSettings.mUnscheduled.contains(script))
+        {
+            const unsigned period = getPeriod(state, distance);
+
+            bool skip = elapsed < period;
+
+            if (!skip && mSettings.mFrameBudget > 0 && mFrameStats.mTime >= mSettings.mFrameBudget
+                && elapsed < period + maxPeriod)
+            {
+                ++mFrameStats.mDeferred;
+                skip = true;
+            }
+
+            if (skip)
+            {
+                ++mFrameStats.mSkips;
+                ++mScriptStats[script].mSkips;
+                return std::nullopt;
+            }
+        }
+
+        // Avoid rounding errors of the accumulated time for scripts running every frame
+        const float secondsPassed = elapsed <= 1 ? mFrameDuration : static_cast<float>(mTime - state.mLastRunTime);
+
+        state.mLastRunFrame = mFrame;
+        state.mLastRunTime = mTime;
+
+        return secondsPassed;
+    }
+
+    void LocalScriptScheduler::finish(const ESM::RefId& script, const void* instance, double time, bool changedLocals)
+    {
+        ++mFrameStats.mRuns;
+        mFrameStats.mTime += time;
+
+        ScriptStats& stats = mScriptStats[script];
+        ++stats.mRuns;
+        stats.mTime += time;
+        stats.mMaxTime = std::max(stats.mMaxTime, time);
+
+        const auto it = mInstances.find(instance);
+        if (it == mInstances.end())
+            return;
+
+        if (changedLocals)
+            it->second.mIdleRuns = 0;
+        else if (it->second.mIdleRuns < idleRuns)
+            ++it->second.mIdleRuns;
+    }
+
+    void LocalScriptScheduler::endFrame()
+    {
+        std::erase_if(mInstances, [&](const auto& v) { return v.second.mLastSeenFrame != mFrame; });
+    }
+
+    void LocalScriptScheduler::clearInstances()
+    {
+        mInstances.clear();
+        mFrameStats = FrameStats{};
+    }
+
+    void LocalScriptScheduler::clear()
+    {
+        mInstances.clear();
+        mScriptStats.clear();
+        mFrameStats = FrameStats{};
+    }
+
+    unsigned LocalScriptScheduler::getPeriod(const Instance& instance, float distance) const
+    {
+        unsigned period = 1;
+
+        if (mSettings.mFullRateDistance > 0)
+            for (float limit = mSettings.mFullRateDistance; distance >= limit && period < maxPeriod; limit *= 2)
+                period *= 2;
+
+        if (mSettings.mThrottleIdle && instance.mIdleRuns >= idleRuns && period < maxPeriod)
+            period *= 2;
+
+        return period;
+    }
+
+    std::string LocalScriptScheduler::formatStats() const
+    {
+        std::unordered_map<ESM::RefId, std::size_t> instances;
+        for (const auto& [key, instance] : mInstances)
+            ++instances[instance.mScript];
+
+        std::vector<std::pair<ESM::RefId, ScriptStats>> scripts(mScriptStats.begin(), mScriptStats.end());
+        std::sort(scripts.begin(), scripts.end(), [](const auto& l, const auto& r) {
+            return std::tie(r.second.mTime, l.first) < std::tie(l.second.mTime, r.first);
+        });
+
+        std::ostringstream out;
+
+        out << "Local script scheduling is " << (mSettings.mEnabled ? "enabled" : "disabled")
+            << " (section [Game] in settings.cfg)\n";
+        out << "Last frame: " << mFrameStats.mRuns << " runs, " << mFrameStats.mSkips << " skipped, "
+            << mFrameStats.mDeferred << " deferred, " << std::fixed << std::setprecision(3)
+            << mFrameStats.mTime * 1000 << " ms\n\n";
+
+        constexpr int nameW = 32;
+        constexpr int valueW = 12;
+
+        out << std::left << std::setw(nameW) << "Script" << std::right << std::setw(valueW) << "instances"
+            << std::setw(valueW) << "runs" << std::setw(valueW) << "skips" << std::setw(valueW) << "total ms"
+            << std::setw(valueW) << "avg ms" << std::setw(valueW) << "max ms" << "\n";
+
+        for (const auto& [script, stats] : scripts)
+        {
+            const auto it = instances.find(script);
+            out << std::left << std::setw(nameW) << script.toDebugString() << std::right << std::setw(valueW)
+                << (it == instances.end() ? 0 : it->second) << std::setw(valueW) << stats.mRuns << std::setw(valueW)
+                << stats.mSkips << std::setw(valueW) << stats.mTime * 1000 << std::setw(valueW)
+                << (stats.mRuns == 0 ? 0.0 : stats.mTime * 1000 / static_cast<double>(stats.mRuns))
+                << std::setw(valueW) << stats.mMaxTime * 1000 << "\n";
+        }
+
+        return out.str();
+    }
+}
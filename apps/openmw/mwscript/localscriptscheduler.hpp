@@ -0,0 +1,117 @@
+#ifndef GAME_SCRIPT_LOCALSCRIPTSCHEDULER_H
+#define GAME_SCRIPT_LOCALSCRIPTSCHEDULER_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <components/esm/refid.hpp>
+
+namespace MWScript
+{
+    struct LocalScriptSchedulerSettings
+    {
+        /// When disabled every local script runs every frame.
+        bool mEnabled = false;
+        /// Scripts of objects closer than this to the player run every frame, further ones run less often.
+        float mFullRateDistance = 2048;
+        /// Run scripts which stopped changing their locals less often.
+        bool mThrottleIdle = false;
+        /// Time in seconds local scripts may take per frame before due scripts are deferred, 0 for unlimited.
+        float mFrameBudget = 0;
+        /// Scripts depending on being run every frame.
+        std::unordered_set<ESM::RefId> mUnscheduled;
+    };
+
+    /// \brief Decides which active local scripts run in the current frame
+    ///
+    /// Each instance of a local script gets an update period (1, 2, 4 or 8 frames) from its distance to the player,
+    /// which is doubled for scripts that stopped changing their locals when idle throttling is enabled. Scripts due
+    /// to run are deferred to a later frame when the frame budget is spent, but never for more than the longest
+    /// period. Scripts of activated objects and unscheduled scripts always run. A scheduled script is given the time
+    /// passed since its previous run as the frame duration, so timers and movement keep their rate.
+    class LocalScriptScheduler
+    {
+    public:
+        struct ScriptStats
+        {
+            std::size_t mRuns = 0;
+            std::size_t mSkips = 0;
+            double mTime = 0;
+            double mMaxTime = 0;
+        };
+
+        struct FrameStats
+        {
+            std::size_t mRuns = 0;
+            std::size_t mSkips = 0;
+            std::size_t mDeferred = 0;
+            double mTime = 0;
+        };
+
+        void setSettings(const LocalScriptSchedulerSettings& settings) { mSettings = settings; }
+
+        const LocalScriptSchedulerSettings& getSettings() const { return mSettings; }
+
+        void beginFrame(float frameDuration);
+
+        /// @param instance identifies the object the script is running on
+        /// @param urgent the script has to run this frame, e.g. because the object was activated
+        /// @return time passed since the previous run of the instance if it should run this frame
+        std::optional<float> schedule(const ESM::RefId& script, const void* instance, float distance, bool urgent);
+
+        /// Report a run of a script allowed by schedule.
+        /// @param time spent running the script in seconds
+        void finish(const ESM::RefId& script, const void* instance, double time, bool changedLocals);
+
+        /// Forget instances not scheduled in the current frame.
+        void endFrame();
+
+        /// Forget an instance, e.g. because its object is removed and the address may be reused by another one.
+        void remove(const void* instance) { mInstances.erase(instance); }
+
+        /// Forget all instances and statistics of the current frame when scripts run without the scheduler.
+        void clearInstances();
+
+        void clear();
+
+        const FrameStats& getFrameStats() const { return mFrameStats; }
+
+        /// Statistics per script accumulated since the last resetStats.
+        const std::unordered_map<ESM::RefId, ScriptStats>& getScriptStats() const { return mScriptStats; }
+
+        void resetStats() { mScriptStats.clear(); }
+
+        /// Statistics are collected only while requested, otherwise script runs are not timed.
+        void setCollectStats(bool value) { mCollectStats = value; }
+
+        bool getCollectStats() const { return mCollectStats; }
+
+        std::string formatStats() const;
+
+    private:
+        struct Instance
+        {
+            ESM::RefId mScript;
+            std::size_t mLastSeenFrame = 0;
+            std::size_t mLastRunFrame = 0;
+            double mLastRunTime = 0;
+            unsigned mIdleRuns = 0;
+        };
+
+        LocalScriptSchedulerSettings mSettings;
+        std::unordered_map<const void*, Instance> mInstances;
+        std::unordered_map<ESM::RefId, ScriptStats> mScriptStats;
+        FrameStats mFrameStats;
+        std::size_t mFrame = 0;
+        double mTime = 0;
+        float mFrameDuration = 0;
+        bool mCollectStats = false;
+
+        unsigned getPeriod(const Instance& instance, float distance) const;
+    };
+}
+
+#endif
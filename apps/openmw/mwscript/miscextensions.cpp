@@ -10,6 +10,7 @@
 #include <components/compiler/opcodes.hpp>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 
 #include <components/interpreter/interpreter.hpp>
 #include <components/interpreter/opcodes.hpp>
@@ -1756,6 +1757,23 @@ namespace MWScript
             }
         };
 
+        class OpWriteTrace : public Interpreter::Opcode0
+        {
+        public:
+            void execute(Interpreter::Runtime& runtime) override
+            {
+                // Threads keep adding events while the trace is written
+                if (!Debug::Trace::isEnabled())
+                    runtime.getContext().report("Tracing is disabled, set OPENMW_TRACE_FILE to enable it");
+                else if (Debug::Trace::writeFile())
+                    runtime.getContext().report(
+                        "Trace is written to " + Files::pathToUnicodeString(Debug::Trace::getFile()));
+                else
+                    runtime.getContext().report(
+                        "Failed to write trace to " + Files::pathToUnicodeString(Debug::Trace::getFile()));
+            }
+        };
+
         class OpTestModels : public Interpreter::Opcode0
         {
             template <class T>
@@ -1937,6 +1955,7 @@ namespace MWScript
             interpreter.installSegment5<OpHelp>(Compiler::Misc::opcodeHelp);
             interpreter.installSegment5<OpReloadLua>(Compiler::Misc::opcodeReloadLua);
             interpreter.installSegment5<OpTestModels>(Compiler::Misc::opcodeTestModels);
+            interpreter.installSegment5<OpWriteTrace>(Compiler::Misc::opcodeWriteTrace);
         }
     }
 }
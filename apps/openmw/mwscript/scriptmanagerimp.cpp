@@ -75,7 +75,9 @@ namespace MWScript
 
             if (success)
             {
-                mScripts.emplace(name, CompiledScript(mParser.getProgram(), mParser.getLocals()));
+                Interpreter::Program program = mParser.getProgram();
+                Interpreter::DecodedProgram decoded = mInterpreter.decode(program);
+                mScripts.emplace(name, CompiledScript(std::move(program), std::move(decoded), mParser.getLocals()));
 
                 return true;
             }
@@ -94,7 +96,7 @@ namespace MWScript
             if (!compile(name))
             {
                 // failed -> ignore script from now on.
-                mScripts.emplace(name, CompiledScript({}, Compiler::Locals()));
+                mScripts.emplace(name, CompiledScript({}, {}, Compiler::Locals()));
                 return false;
             }
 
@@ -109,7 +111,7 @@ namespace MWScript
         {
             try
             {
-                mInterpreter.run(iter->second.mProgram, interpreterContext);
+                mInterpreter.run(iter->second.mProgram, iter->second.mDecoded, interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -134,6 +136,7 @@ namespace MWScript
         }
 
         mGlobalScripts.clear();
+        mLocalScriptScheduler.clear();
     }
 
     std::pair<int, int> ScriptManager::compileAll()
@@ -205,6 +208,16 @@ namespace MWScript
         return mGlobalScripts;
     }
 
+    LocalScriptScheduler& ScriptManager::getLocalScriptScheduler()
+    {
+        return mLocalScriptScheduler;
+    }
+
+    void ScriptManager::removeLocalScriptInstance(const void* instance)
+    {
+        mLocalScriptScheduler.remove(instance);
+    }
+
     const Compiler::Extensions& ScriptManager::getExtensions() const
     {
         return *mCompilerContext.getExtensions();
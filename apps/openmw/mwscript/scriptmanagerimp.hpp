@@ -16,6 +16,7 @@
 #include "../mwbase/scriptmanager.hpp"
 
 #include "globalscripts.hpp"
+#include "localscriptscheduler.hpp"
 
 namespace MWWorld
 {
@@ -46,11 +47,14 @@ namespace MWScript
         struct CompiledScript
         {
             Interpreter::Program mProgram;
+            Interpreter::DecodedProgram mDecoded;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
 
-            explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
+            explicit CompiledScript(
+                Interpreter::Program&& program, Interpreter::DecodedProgram&& decoded, const Compiler::Locals& locals)
                 : mProgram(std::move(program))
+                , mDecoded(std::move(decoded))
                 , mLocals(locals)
             {
             }
@@ -58,6 +62,7 @@ namespace MWScript
 
         std::unordered_map<ESM::RefId, CompiledScript> mScripts;
         GlobalScripts mGlobalScripts;
+        LocalScriptScheduler mLocalScriptScheduler;
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
 
     public:
@@ -81,6 +86,10 @@ namespace MWScript
 
         GlobalScripts& getGlobalScripts() override;
 
+        LocalScriptScheduler& getLocalScriptScheduler() override;
+
+        void removeLocalScriptInstance(const void* instance) override;
+
         const Compiler::Extensions& getExtensions() const override;
     };
 }
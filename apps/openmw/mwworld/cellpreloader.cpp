@@ -8,6 +8,7 @@
 #include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
@@ -92,6 +93,7 @@ namespace MWWorld
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
+            const Debug::Trace::Scope trace("PreloadItem::doWork");
             if (mIsExterior)
             {
                 try
@@ -180,6 +182,7 @@ namespace MWWorld
 
         void doWork() override
         {
+            const Debug::Trace::Scope trace("TerrainPreloadItem::doWork");
             for (unsigned int i = 0; i < mTerrainViews.size() && i < mPreloadPositions.size() && !mAbort; ++i)
             {
                 mTerrainViews[i]->reset();
@@ -211,7 +214,11 @@ namespace MWWorld
         {
         }
 
-        void doWork() override { mResourceSystem->updateCache(mReferenceTime); }
+        void doWork() override
+        {
+            const Debug::Trace::Scope trace("UpdateCacheItem::doWork");
+            mResourceSystem->updateCache(mReferenceTime);
+        }
 
     private:
         double mReferenceTime;
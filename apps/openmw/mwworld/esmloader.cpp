@@ -65,12 +65,13 @@ namespace MWWorld
             }
             case ESM::Format::Tes4:
             {
-                ESM4::Reader reader(std::move(stream), filepath,
+                auto reader = std::make_unique<ESM4::Reader>(std::move(stream), filepath,
                     MWBase::Environment::get().getResourceSystem()->getVFS(),
                     mEncoder != nullptr ? &mEncoder->getStatelessEncoder() : nullptr);
-                reader.setModIndex(index);
-                reader.updateModIndices(mNameToIndex);
-                mStore.loadESM4(reader, listener);
+                reader->setReadAheadThreads(ESM4::Reader::getDefaultReadAheadThreads());
+                reader->setModIndex(index);
+                reader->updateModIndices(mNameToIndex);
+                mStore.loadESM4(std::move(reader), listener);
                 break;
             }
         }
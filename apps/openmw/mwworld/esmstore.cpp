@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <tuple>
 
 #include <components/debug/debuglog.hpp>
@@ -209,6 +211,16 @@ namespace
         return spellsToReplace;
     }
 
+    // References from temporary cell groups are used only when the cell is loaded, unlike persistent ones which can
+    // be looked up by id as enable parents or door destinations
+    bool isTemporaryReference(const ESM4::Reader& reader)
+    {
+        if (reader.stackSize() == 0)
+            return false;
+        const std::int32_t groupType = reader.grp().type;
+        return groupType == ESM4::Grp_CellTemporaryChild || groupType == ESM4::Grp_CellVisibleDistChild;
+    }
+
     // Custom enchanted items can reference scripts that no longer exist, this doesn't necessarily mean the base item no
     // longer exists however. So instead of removing the item altogether, we're only removing the script.
     template <class MapT>
@@ -241,6 +253,9 @@ namespace MWWorld
         IDMap mIds;
         IDMap mStaticIds;
 
+        // ESM4 files stay open while there are deferred references to load from them
+        std::mutex mESM4ReadersMutex;
+
         template <typename T>
         static void assignStoreToIndex(ESMStore& stores, Store<T>& store)
         {
@@ -263,8 +278,10 @@ namespace MWWorld
         }
 
         template <typename T>
-        static bool typedReadRecordESM4(ESM4::Reader& reader, Store<T>& store)
+        static bool typedReadRecordESM4(
+            const std::shared_ptr<ESM4::Reader>& readerPtr, Store<T>& store, std::mutex& readersMutex)
         {
+            ESM4::Reader& reader = *readerPtr;
             auto recordType = static_cast<ESM4::RecordTypes>(reader.hdr().record.typeId);
 
             ESM::RecNameInts esm4RecName = static_cast<ESM::RecNameInts>(ESM::esm4Recname(recordType));
@@ -274,6 +291,15 @@ namespace MWWorld
                 {
                     if (T::sRecordId == esm4RecName)
                     {
+                        if constexpr (std::is_base_of_v<ESM4RefsStore<T>, Store<T>>)
+                        {
+                            if (isTemporaryReference(reader))
+                            {
+                                store.deferStatic(readerPtr, readersMutex);
+                                reader.skipRecordData();
+                                return true;
+                            }
+                        }
                         reader.getRecordData();
                         T value;
                         value.load(reader);
@@ -285,10 +311,12 @@ namespace MWWorld
             return false;
         }
 
-        static bool readRecord(ESM4::Reader& reader, ESMStore& store)
+        static bool readRecord(const std::shared_ptr<ESM4::Reader>& reader, ESMStore& store)
         {
+            std::mutex& readersMutex = store.mStoreImp->mESM4ReadersMutex;
             return std::apply(
-                [&reader](auto&... x) { return (typedReadRecordESM4(reader, x) || ...); }, store.mStoreImp->mStores);
+                [&](auto&... x) { return (typedReadRecordESM4(reader, x, readersMutex) || ...); },
+                store.mStoreImp->mStores);
         }
     };
 
@@ -468,17 +496,20 @@ namespace MWWorld
         }
     }
 
-    void ESMStore::loadESM4(ESM4::Reader& reader, Loading::Listener* listener)
+    void ESMStore::loadESM4(std::unique_ptr<ESM4::Reader> reader, Loading::Listener* listener)
     {
         if (listener != nullptr)
             listener->setProgressRange(::EsmLoader::fileProgress);
-        auto visitorRec = [this, listener](ESM4::Reader& r) {
-            bool result = ESMStoreImp::readRecord(r, *this);
+        const std::shared_ptr<ESM4::Reader> sharedReader = std::move(reader);
+        auto visitorRec = [this, listener, &sharedReader](ESM4::Reader& r) {
+            bool result = ESMStoreImp::readRecord(sharedReader, *this);
             if (listener != nullptr)
                 listener->setProgress(::EsmLoader::fileProgress * r.getFileOffset() / r.getFileSize());
             return result;
         };
-        ESM4::ReaderUtils::readAll(reader, visitorRec, [](ESM4::Reader&) {});
+        ESM4::ReaderUtils::readAll(*sharedReader, visitorRec, [](ESM4::Reader&) {});
+        // Deferred references are loaded one cell at a time, there is nothing to read ahead
+        sharedReader->setReadAheadThreads(0);
     }
 
     void ESMStore::setIdType(const ESM::RefId& id, ESM::RecNameInts type)
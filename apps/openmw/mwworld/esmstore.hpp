@@ -222,7 +222,7 @@ namespace MWWorld
         void validateDynamic();
 
         void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
-        void loadESM4(ESM4::Reader& esm, Loading::Listener* listener);
+        void loadESM4(std::unique_ptr<ESM4::Reader> esm, Loading::Listener* listener);
 
         template <class T>
         const Store<T>& get() const
@@ -6,6 +6,9 @@
 #include <components/esm3/loadnpc.hpp>
 #include <components/esm3/loadscpt.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/scriptmanager.hpp"
+
 #include "cellstore.hpp"
 #include "class.hpp"
 #include "containerstore.hpp"
@@ -13,6 +16,11 @@
 
 namespace
 {
+    // Object may be destroyed after that and a new one may get the same address
+    void removeScheduledInstance(const MWWorld::Ptr& ptr)
+    {
+        MWBase::Environment::get().getScriptManager()->removeLocalScriptInstance(ptr.mRef);
+    }
 
     struct AddScriptsVisitor
     {
@@ -145,6 +153,7 @@ void MWWorld::LocalScripts::clearCell(CellStore* cell)
             if (iter == mIter)
                 ++mIter;
 
+            removeScheduledInstance(iter->second);
             mScripts.erase(iter++);
         }
         else
@@ -160,6 +169,7 @@ void MWWorld::LocalScripts::remove(const MWWorld::CellRef* ref)
             if (iter == mIter)
                 ++mIter;
 
+            removeScheduledInstance(iter->second);
             mScripts.erase(iter);
             break;
         }
@@ -173,6 +183,7 @@ void MWWorld::LocalScripts::remove(const Ptr& ptr)
             if (iter == mIter)
                 ++mIter;
 
+            removeScheduledInstance(iter->second);
             mScripts.erase(iter);
             break;
         }
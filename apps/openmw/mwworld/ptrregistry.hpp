@@ -5,6 +5,7 @@
 
 #include "components/esm3/cellref.hpp"
 
+#include <atomic>
 #include <unordered_map>
 
 namespace MWWorld
@@ -68,7 +69,7 @@ namespace MWWorld
         }
 
     private:
-        std::size_t mRevision = 0;
+        std::atomic<std::size_t> mRevision = 0;
         std::unordered_map<ESM::RefNum, Ptr> mIndex;
         ESM::RefNum mLastGenerated;
     };
@@ -302,6 +302,11 @@ namespace MWWorld
         return ret;
     }
 
+    bool RefData::isActivationPending() const
+    {
+        return mFlags & Flag_OnActivate;
+    }
+
     const ESM::AnimationState& RefData::getAnimationState() const
     {
         return mAnimationState;
@@ -139,6 +139,9 @@ namespace MWWorld
 
         bool onActivate();
 
+        /// Was the object activated without a script checking OnActivate since then?
+        bool isActivationPending() const;
+
         bool activateByScript();
 
         bool hasChanged() const;
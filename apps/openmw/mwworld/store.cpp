@@ -9,8 +9,10 @@
 #include <components/esm/records.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
+#include <components/esm4/reader.hpp>
 
 #include <components/fallback/fallback.hpp>
+#include <components/files/conversion.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
 
@@ -1233,6 +1235,113 @@ namespace MWWorld
             return nullptr;
         return foundLand->second;
     }
+
+    // ESM4 references
+    //=========================================================================
+    template <typename T>
+    void ESM4RefsStore<T>::deferStatic(const std::shared_ptr<ESM4::Reader>& reader, std::mutex& readerMutex)
+    {
+        const ESM::FormId id = reader->getFormIdFromHeader();
+        // Record from the current file overrides the one loaded from a previous file
+        this->mStatic.erase(id);
+        mDeferred.insert_or_assign(id,
+            DeferredReference{
+                .mReader = reader,
+                .mOffset = reader->getRecordOffset(),
+                .mCell = reader->currCell(),
+            });
+        mReaderMutex = &readerMutex;
+    }
+
+    template <typename T>
+    void ESM4RefsStore<T>::preprocessReferences(const Store<ESM4::Cell>& cells)
+    {
+        for (auto& [_, ref] : this->mStatic)
+        {
+            const ESM4::Cell* cell = cells.find(ref.mParent);
+            if (cell->isExterior() && (cell->mFlags & ESM4::Rec_Persistent))
+            {
+                const ESM4::Cell* actualCell = cells.searchExterior(
+                    positionToExteriorCellLocation(ref.mPos.pos[0], ref.mPos.pos[1], cell->mParent));
+                if (actualCell)
+                    ref.mParent = actualCell->mId;
+            }
+            mPerCellReferences[ref.mParent].mRefs.push_back(&ref);
+        }
+        for (const auto& [id, deferred] : mDeferred)
+        {
+            // Record from a following file was loaded without deferring
+            if (this->mStatic.contains(id))
+                continue;
+            const ESM::RefId cellId(deferred.mCell);
+            CellReferences& refs = mPerCellReferences[cellId];
+            refs.mDeferred.push_back(deferred);
+            refs.mIsLoaded = false;
+            mDeferredCells.emplace(id, cellId);
+        }
+        mDeferred.clear();
+    }
+
+    template <typename T>
+    std::span<const T* const> ESM4RefsStore<T>::getByCell(ESM::RefId cellId) const
+    {
+        auto it = mPerCellReferences.find(cellId);
+        if (it == mPerCellReferences.end())
+            return {};
+        CellReferences& refs = it->second;
+        if (!refs.mIsLoaded.load(std::memory_order_acquire))
+        {
+            const std::lock_guard lock(*mReaderMutex);
+            if (!refs.mIsLoaded.load(std::memory_order_relaxed))
+            {
+                loadDeferred(refs);
+                refs.mIsLoaded.store(true, std::memory_order_release);
+            }
+        }
+        return refs.mRefs;
+    }
+
+    template <typename T>
+    const T* ESM4RefsStore<T>::searchStatic(const ESM::FormId& id) const
+    {
+        if (const T* ref = TypedDynamicStore<T, ESM::FormId>::searchStatic(id))
+            return ref;
+        const auto it = mDeferredCells.find(id);
+        if (it == mDeferredCells.end())
+            return nullptr;
+        for (const T* ref : getByCell(it->second))
+            if (ref->mId == id)
+                return ref;
+        return nullptr;
+    }
+
+    template <typename T>
+    void ESM4RefsStore<T>::loadDeferred(CellReferences& refs) const
+    {
+        // Pointers to loaded records are stored in mRefs so there must be no reallocation
+        refs.mLoaded.reserve(refs.mDeferred.size());
+        for (const DeferredReference& deferred : refs.mDeferred)
+        {
+            ESM4::Reader& reader = *deferred.mReader;
+            try
+            {
+                if (!reader.seekRecord(deferred.mOffset))
+                    throw std::runtime_error("failed to read record header");
+                reader.setCurrCell(deferred.mCell);
+                reader.getRecordData();
+                T value;
+                value.load(reader);
+                refs.mRefs.push_back(&refs.mLoaded.emplace_back(std::move(value)));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to load reference at offset " << deferred.mOffset << " from "
+                                  << Files::pathToUnicodeString(reader.getFileName()) << ": " << e.what();
+            }
+        }
+        // Reader is closed when the last of its deferred records is loaded
+        refs.mDeferred = {};
+    }
 }
 
 template class MWWorld::TypedDynamicStore<ESM::Activator>;
@@ -1282,6 +1391,10 @@ template class MWWorld::TypedDynamicStore<ESM4::Reference, ESM::FormId>;
 template class MWWorld::TypedDynamicStore<ESM4::ActorCharacter, ESM::FormId>;
 template class MWWorld::TypedDynamicStore<ESM4::ActorCreature, ESM::FormId>;
 
+template class MWWorld::ESM4RefsStore<ESM4::Reference>;
+template class MWWorld::ESM4RefsStore<ESM4::ActorCharacter>;
+template class MWWorld::ESM4RefsStore<ESM4::ActorCreature>;
+
 template class MWWorld::TypedDynamicStore<ESM4::Activator>;
 template class MWWorld::TypedDynamicStore<ESM4::Ammunition>;
 template class MWWorld::TypedDynamicStore<ESM4::Armor>;
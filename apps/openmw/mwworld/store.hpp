@@ -1,8 +1,10 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <span>
 #include <string>
@@ -37,6 +39,11 @@ namespace ESM
     class ESMWriter;
 }
 
+namespace ESM4
+{
+    class Reader;
+}
+
 namespace Loading
 {
     class Listener;
@@ -538,32 +545,42 @@ namespace MWWorld
     class ESM4RefsStore : public TypedDynamicStore<T, ESM::FormId>
     {
     public:
-        void preprocessReferences(const Store<ESM4::Cell>& cells)
+        /// Remembers position of the reference record the reader points to instead of loading it. The record is
+        /// loaded by the first getByCell call for its cell. Reader is kept until all its deferred records are loaded
+        /// and should be used only under the given mutex after that.
+        void deferStatic(const std::shared_ptr<ESM4::Reader>& reader, std::mutex& readerMutex);
+
+        void preprocessReferences(const Store<ESM4::Cell>& cells);
+
+        /// Loads deferred references of the cell if necessary, can be called from any thread.
+        std::span<const T* const> getByCell(ESM::RefId cellId) const;
+
+        /// Also finds deferred references loading all references of their cell.
+        const T* searchStatic(const ESM::FormId& id) const;
+
+    private:
+        struct DeferredReference
         {
-            for (auto& [_, ref] : this->mStatic)
-            {
-                const ESM4::Cell* cell = cells.find(ref.mParent);
-                if (cell->isExterior() && (cell->mFlags & ESM4::Rec_Persistent))
-                {
-                    const ESM4::Cell* actualCell = cells.searchExterior(
-                        positionToExteriorCellLocation(ref.mPos.pos[0], ref.mPos.pos[1], cell->mParent));
-                    if (actualCell)
-                        ref.mParent = actualCell->mId;
-                }
-                mPerCellReferences[ref.mParent].push_back(&ref);
-            }
-        }
+            std::shared_ptr<ESM4::Reader> mReader;
+            std::streamoff mOffset;
+            ESM::FormId mCell;
+        };
 
-        std::span<const T* const> getByCell(ESM::RefId cellId) const
+        struct CellReferences
         {
-            auto it = mPerCellReferences.find(cellId);
-            if (it == mPerCellReferences.end())
-                return {};
-            return it->second;
-        }
+            std::vector<const T*> mRefs;
+            std::vector<DeferredReference> mDeferred;
+            std::vector<T> mLoaded;
+            std::atomic_bool mIsLoaded{ true };
+        };
 
-    private:
-        std::unordered_map<ESM::RefId, std::vector<T*>> mPerCellReferences;
+        // Indexed by reference id so records overridden by the following content files are dropped
+        std::unordered_map<ESM::FormId, DeferredReference> mDeferred;
+        mutable std::unordered_map<ESM::RefId, CellReferences> mPerCellReferences;
+        std::unordered_map<ESM::FormId, ESM::RefId> mDeferredCells;
+        std::mutex* mReaderMutex = nullptr;
+
+        void loadDeferred(CellReferences& refs) const;
     };
 
     template <>
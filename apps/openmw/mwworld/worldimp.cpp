@@ -48,6 +48,7 @@
 #include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/navigator.hpp>
+#include <components/detournavigator/pathqueryservice.hpp>
 #include <components/detournavigator/settings.hpp>
 #include <components/detournavigator/stats.hpp>
 #include <components/detournavigator/updateguard.hpp>
@@ -301,6 +302,8 @@ namespace MWWorld
             auto navigatorSettings = DetourNavigator::makeSettingsFromSettingsManager(maxRecastLogLevel);
             navigatorSettings.mRecast.mSwimHeightScale = mSwimHeightScale;
             mNavigator = DetourNavigator::makeNavigator(navigatorSettings, mUserDataPath);
+            if (const std::size_t threads = Settings::navigator().mAsyncPathQueryThreads; threads > 0)
+                mPathQueryService = std::make_unique<DetourNavigator::PathQueryService>(*mNavigator, threads);
         }
         else
         {
@@ -1671,6 +1674,9 @@ namespace MWWorld
 
         updateNavigator();
 
+        if (mPathQueryService != nullptr)
+            mPathQueryService->update();
+
         mPlayer->update();
 
         mPhysics->debugDraw();
@@ -3817,6 +3823,11 @@ namespace MWWorld
         return mNavigator.get();
     }
 
+    DetourNavigator::PathQueryService* World::getPathQueryService() const
+    {
+        return mPathQueryService.get();
+    }
+
     void World::updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
         const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const
     {
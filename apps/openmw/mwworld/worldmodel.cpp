@@ -144,7 +144,10 @@ MWWorld::CellStore& MWWorld::WorldModel::insertCellStore(const ESM::Cell& cell)
 
 void MWWorld::WorldModel::clear()
 {
-    mPtrRegistry.clear();
+    {
+        const std::lock_guard lock(mPtrRegistryMutex);
+        mPtrRegistry.clear();
+    }
     mInteriors.clear();
     mExteriors.clear();
     mCells.clear();
@@ -349,12 +352,14 @@ namespace MWWorld
     {
         if (ptr.mRef == nullptr)
             throw std::logic_error("Ptr with nullptr mRef is not allowed to be registered");
+        const std::lock_guard lock(mPtrRegistryMutex);
         mPtrRegistry.insert(ptr);
         ptr.mRef->mWorldModel = this;
     }
 
     void WorldModel::deregisterLiveCellRef(LiveCellRefBase& ref) noexcept
     {
+        const std::lock_guard lock(mPtrRegistryMutex);
         mPtrRegistry.remove(ref);
         ref.mWorldModel = nullptr;
     }
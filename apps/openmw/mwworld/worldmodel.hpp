@@ -3,6 +3,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -67,13 +68,29 @@ namespace MWWorld
 
         Ptr getPtrByRefId(const ESM::RefId& name);
 
-        Ptr getPtr(ESM::RefNum refNum) const { return mPtrRegistry.getOrEmpty(refNum); }
+        // Ptrs are registered and looked up by Lua scripts running in parallel (see LuaManager::updateLocalScripts),
+        // so access to the registry is synchronized. Iterating over the view is allowed only on the main thread while
+        // no scripts are running.
+
+        Ptr getPtr(ESM::RefNum refNum) const
+        {
+            const std::lock_guard lock(mPtrRegistryMutex);
+            return mPtrRegistry.getOrEmpty(refNum);
+        }
 
         PtrRegistryView getPtrRegistryView() const { return PtrRegistryView(mPtrRegistry); }
 
-        ESM::RefNum getLastGeneratedRefNum() const { return mPtrRegistry.getLastGenerated(); }
+        ESM::RefNum getLastGeneratedRefNum() const
+        {
+            const std::lock_guard lock(mPtrRegistryMutex);
+            return mPtrRegistry.getLastGenerated();
+        }
 
-        void setLastGeneratedRefNum(ESM::RefNum v) { mPtrRegistry.setLastGenerated(v); }
+        void setLastGeneratedRefNum(ESM::RefNum v)
+        {
+            const std::lock_guard lock(mPtrRegistryMutex);
+            mPtrRegistry.setLastGenerated(v);
+        }
 
         std::size_t getPtrRegistryRevision() const { return mPtrRegistry.getRevision(); }
 
@@ -81,7 +98,11 @@ namespace MWWorld
 
         void deregisterLiveCellRef(LiveCellRefBase& ref) noexcept;
 
-        void assignSaveFileRefNum(ESM::CellRef& ref) { mPtrRegistry.assign(ref); }
+        void assignSaveFileRefNum(ESM::CellRef& ref)
+        {
+            const std::lock_guard lock(mPtrRegistryMutex);
+            mPtrRegistry.assign(ref);
+        }
 
         template <typename Fn>
         void forEachLoadedCellStore(Fn&& fn)
@@ -106,6 +127,7 @@ namespace MWWorld
     private:
         struct GetCellStoreCallback;
 
+        mutable std::mutex mPtrRegistryMutex;
         PtrRegistry mPtrRegistry; // defined before mCells because during destruction it should be the last
 
         MWWorld::ESMStore& mStore;
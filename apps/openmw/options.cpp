@@ -46,6 +46,9 @@ namespace OpenMW
 
         addOption("no-sound", bpo::value<bool>()->implicit_value(true)->default_value(false), "disable all sounds");
 
+        addOption("headless", bpo::value<bool>()->implicit_value(true)->default_value(false),
+            "run without rendering and sound in a hidden window (implies skip-menu, no-sound and no-grab)");
+
         addOption("script-all", bpo::value<bool>()->implicit_value(true)->default_value(false),
             "compile all scripts (excluding dialogue scripts) at startup");
 
@@ -95,6 +98,19 @@ namespace OpenMW
         addOption("random-seed", bpo::value<unsigned int>()->default_value(Misc::Rng::generateDefaultSeed()),
             "seed value for random number generator");
 
+        addOption("record-input", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "record random seed, frame durations and input events into a file");
+
+        addOption("replay-input", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "replay a file written with record-input instead of handling user input and quit when it ends "
+            "(other startup options should match the recorded session)");
+
+        addOption("replay-fixed-step", bpo::value<float>()->default_value(0),
+            "simulate each replayed frame with this duration in seconds instead of the recorded one (0 to disable)");
+
+        addOption("timings-summary", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "write p50, p95 and p99 of each frame profiling stats into a file on exit");
+
         return desc;
     }
 }
@@ -4,6 +4,8 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
+#include <components/debug/trace.hpp>
+
 #include <cstddef>
 #include <string>
 
@@ -122,6 +124,7 @@ namespace OMW
             , mFrameNumber(frameNumber)
             , mTimer(timer)
             , mStats(stats)
+            , mTrace(UserStatsValue<type>::sValue.mLabel.c_str())
         {
         }
 
@@ -147,6 +150,7 @@ namespace OMW
         const unsigned int mFrameNumber;
         const osg::Timer& mTimer;
         osg::Stats& mStats;
+        const Debug::Trace::Scope mTrace;
     };
 }
 
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <osg/Stats>
+
+#include <sstream>
+#include <string>
+
+#include "apps/openmw/frametimings.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        std::string getLine(const std::string& summary, const std::string& name)
+        {
+            std::istringstream stream(summary);
+            std::string line;
+            while (std::getline(stream, line))
+                if (line.starts_with(name + ' '))
+                    return line;
+            return {};
+        }
+
+        TEST(OMWFrameTimingsTest, writeShouldReportPercentilesInMilliseconds)
+        {
+            osg::ref_ptr<osg::Stats> stats = new osg::Stats("test", 200);
+            for (unsigned i = 0; i < 100; ++i)
+                stats->setAttribute(i, "physics_time_taken", (i + 1) / 1000.0);
+            FrameTimings timings;
+            for (unsigned i = 0; i < 100; ++i)
+                timings.add(*stats, i);
+            std::ostringstream summary;
+            timings.write(summary);
+            EXPECT_EQ(getLine(summary.str(), "physics_time_taken"), "physics_time_taken 100 50.000 95.000 99.000");
+        }
+
+        TEST(OMWFrameTimingsTest, writeShouldReportZeroForStatsWithoutValues)
+        {
+            osg::ref_ptr<osg::Stats> stats = new osg::Stats("test", 10);
+            FrameTimings timings;
+            timings.add(*stats, 0);
+            std::ostringstream summary;
+            timings.write(summary);
+            EXPECT_EQ(getLine(summary.str(), "input_time_taken"), "input_time_taken 0 0.000 0.000 0.000");
+        }
+
+        TEST(OMWFrameTimingsTest, addShouldSkipFramesWithoutValue)
+        {
+            osg::ref_ptr<osg::Stats> stats = new osg::Stats("test", 10);
+            stats->setAttribute(0, "script_time_taken", 0.002);
+            stats->setAttribute(2, "script_time_taken", 0.004);
+            FrameTimings timings;
+            for (unsigned i = 0; i < 3; ++i)
+                timings.add(*stats, i);
+            std::ostringstream summary;
+            timings.write(summary);
+            EXPECT_EQ(getLine(summary.str(), "script_time_taken"), "script_time_taken 2 2.000 4.000 4.000");
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include "apps/openmw/mwmechanics/pathfinding.hpp"
+
+#include <components/detournavigator/agentbounds.hpp>
+#include <components/detournavigator/navigatorstub.hpp>
+#include <components/detournavigator/pathqueryservice.hpp>
+
+#include <gtest/gtest.h>
+
+namespace MWMechanics
+{
+    namespace
+    {
+        using namespace testing;
+        using namespace DetourNavigator;
+
+        struct MWMechanicsPathFinderTest : Test
+        {
+            const osg::Vec3f mStart{ 0, 0, 0 };
+            const osg::Vec3f mEnd{ 100, 0, 0 };
+            const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(29, 29, 66) };
+            NavigatorStub mNavigator;
+            PathQueryService mService{ mNavigator, 1 };
+            PathFinder mPathFinder;
+
+            void completePath()
+            {
+                mPathFinder.buildStraightPath(mEnd);
+                mPathFinder.update(mEnd, 1, 1, {}, mAgentBounds, Flag_walk);
+            }
+
+            void enqueueAsyncPath()
+            {
+                mPathFinder.enqueueAsyncPath(mService,
+                    PathQuery{
+                        .mAgentBounds = mAgentBounds,
+                        .mStart = mStart,
+                        .mEnd = mEnd,
+                        .mIncludeFlags = Flag_walk,
+                    },
+                    PathType::Full, nullptr);
+            }
+        };
+
+        TEST_F(MWMechanicsPathFinderTest, straightPathShouldBeCompletedAtEnd)
+        {
+            completePath();
+            EXPECT_TRUE(mPathFinder.checkPathCompleted());
+        }
+
+        TEST_F(MWMechanicsPathFinderTest, completedPathShouldNotBeCompletedWhileAsyncPathIsPending)
+        {
+            completePath();
+            enqueueAsyncPath();
+            EXPECT_FALSE(mPathFinder.checkPathCompleted());
+        }
+
+        TEST_F(MWMechanicsPathFinderTest, failedAsyncPathShouldKeepCurrentPath)
+        {
+            completePath();
+            enqueueAsyncPath();
+            mService.wait();
+            mService.update();
+            mPathFinder.collectAsyncPath();
+            EXPECT_TRUE(mPathFinder.checkPathCompleted());
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include "apps/openmw/mwscript/localscriptscheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWScript;
+
+    struct MWScriptLocalScriptSchedulerTest : Test
+    {
+        const ESM::RefId mScript = ESM::RefId::stringRefId("script");
+        const int mObject = 0;
+        const int mOtherObject = 0;
+        const float mFrameDuration = 0.1f;
+        LocalScriptScheduler mScheduler;
+
+        MWScriptLocalScriptSchedulerTest()
+        {
+            LocalScriptSchedulerSettings settings;
+            settings.mEnabled = true;
+            settings.mFullRateDistance = 1000;
+            mScheduler.setSettings(settings);
+        }
+
+        std::optional<float> runFrame(float distance, bool urgent = false, double time = 0, bool changedLocals = true)
+        {
+            mScheduler.beginFrame(mFrameDuration);
+            const std::optional<float> result = mScheduler.schedule(mScript, &mObject, distance, urgent);
+            if (result.has_value())
+                mScheduler.finish(mScript, &mObject, time, changedLocals);
+            mScheduler.endFrame();
+            return result;
+        }
+    };
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_every_frame_when_disabled)
+    {
+        mScheduler.setSettings(LocalScriptSchedulerSettings{});
+        for (int i = 0; i < 10; ++i)
+            EXPECT_EQ(runFrame(1e6f), mFrameDuration) << i;
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_every_frame_close_to_player)
+    {
+        for (int i = 0; i < 10; ++i)
+            EXPECT_EQ(runFrame(999), mFrameDuration) << i;
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_distant_script_less_often_with_time_passed_since_last_run)
+    {
+        EXPECT_EQ(runFrame(3000), mFrameDuration);
+        EXPECT_EQ(runFrame(3000), std::nullopt);
+        EXPECT_EQ(runFrame(3000), std::nullopt);
+        EXPECT_EQ(runFrame(3000), std::nullopt);
+        const std::optional<float> secondsPassed = runFrame(3000);
+        ASSERT_TRUE(secondsPassed.has_value());
+        EXPECT_FLOAT_EQ(*secondsPassed, 4 * mFrameDuration);
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_urgent_script)
+    {
+        EXPECT_EQ(runFrame(1e6f), mFrameDuration);
+        const std::optional<float> secondsPassed = runFrame(1e6f, true);
+        ASSERT_TRUE(secondsPassed.has_value());
+        EXPECT_EQ(*secondsPassed, mFrameDuration);
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_unscheduled_script_every_frame)
+    {
+        LocalScriptSchedulerSettings settings = mScheduler.getSettings();
+        settings.mUnscheduled.insert(mScript);
+        mScheduler.setSettings(settings);
+        for (int i = 0; i < 10; ++i)
+            EXPECT_EQ(runFrame(1e6f), mFrameDuration) << i;
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_idle_script_every_frame_by_default)
+    {
+        for (int i = 0; i < 20; ++i)
+            EXPECT_EQ(runFrame(0, false, 0, false), mFrameDuration) << i;
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_idle_script_less_often_when_enabled)
+    {
+        LocalScriptSchedulerSettings settings = mScheduler.getSettings();
+        settings.mThrottleIdle = true;
+        mScheduler.setSettings(settings);
+        for (int i = 0; i < 16; ++i)
+            EXPECT_EQ(runFrame(0, false, 0, false), mFrameDuration) << i;
+        EXPECT_EQ(runFrame(0, false, 0, false), std::nullopt);
+        EXPECT_EQ(runFrame(0, false, 0, false), 2 * mFrameDuration);
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_defer_script_when_budget_is_spent_for_limited_number_of_frames)
+    {
+        LocalScriptSchedulerSettings settings = mScheduler.getSettings();
+        settings.mFrameBudget = 0.001f;
+        mScheduler.setSettings(settings);
+
+        int runs = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            mScheduler.beginFrame(mFrameDuration);
+            if (mScheduler.schedule(mScript, &mOtherObject, 0, false).has_value())
+                mScheduler.finish(mScript, &mOtherObject, 0.01, true);
+            if (mScheduler.schedule(mScript, &mObject, 0, false).has_value())
+                ++runs;
+            mScheduler.endFrame();
+        }
+
+        EXPECT_EQ(mScheduler.getFrameStats().mDeferred, 0u);
+        EXPECT_EQ(runs, 2);
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_run_removed_instance_as_new_one)
+    {
+        EXPECT_EQ(runFrame(3000), mFrameDuration);
+        EXPECT_EQ(runFrame(3000), std::nullopt);
+        mScheduler.remove(&mObject);
+        EXPECT_EQ(runFrame(3000), mFrameDuration);
+    }
+
+    TEST_F(MWScriptLocalScriptSchedulerTest, should_collect_stats_per_script)
+    {
+        runFrame(3000, false, 0.5);
+        runFrame(3000, false, 0.5);
+        runFrame(3000, false, 0.5);
+
+        const auto it = mScheduler.getScriptStats().find(mScript);
+        ASSERT_NE(it, mScheduler.getScriptStats().end());
+        EXPECT_EQ(it->second.mRuns, 1u);
+        EXPECT_EQ(it->second.mSkips, 2u);
+        EXPECT_EQ(it->second.mTime, 0.5);
+    }
+}
@@ -3,10 +3,12 @@
 #include <array>
 #include <sstream>
 
-#include "testutils.hpp"
+#include <components/testing/mwscript.hpp>
 
 namespace
 {
+    using namespace TestingOpenMW;
+
     struct MWScriptTest : public ::testing::Test
     {
         MWScriptTest()
@@ -60,6 +62,11 @@ namespace
             mInterpreter.run(script.mProgram, context);
         }
 
+        void runDecoded(const Interpreter::Program& program, TestInterpreterContext& context)
+        {
+            mInterpreter.run(program, mInterpreter.decode(program), context);
+        }
+
         template <typename T, typename... TArgs>
         void installOpcode(int code, TArgs&&... args)
         {
@@ -104,21 +111,6 @@ End)mwscript";
 
 AddTopic "OpenMW Unit Test"
 
-End)mwscript";
-
-    const std::string sScript3 = R"mwscript(Begin math
-
-short a
-short b
-short c
-short d
-short e
-
-set b to ( a + 1 )
-set c to ( a - 1 )
-set d to ( b * c )
-set e to ( d / a )
-
 End)mwscript";
 
     // https://forum.openmw.org/viewtopic.php?f=6&t=2262
@@ -560,7 +552,7 @@ End)mwscript";
 
     TEST_F(MWScriptTest, mwscript_test_math)
     {
-        if (const auto script = compile(sScript3))
+        if (const auto script = compile(sMathScript))
         {
             struct Algorithm
             {
@@ -603,6 +595,36 @@ End)mwscript";
         }
     }
 
+    TEST_F(MWScriptTest, mwscript_test_decoded_program_should_match_program)
+    {
+        if (const auto script = compile(sMathScript))
+        {
+            TestInterpreterContext expected;
+            TestInterpreterContext actual;
+            for (int i = 1; i < 100; ++i)
+            {
+                expected.setLocalShort(0, i);
+                actual.setLocalShort(0, i);
+                run(*script, expected);
+                runDecoded(script->mProgram, actual);
+                for (int j = 0; j < 5; ++j)
+                    EXPECT_EQ(expected.getLocalShort(j), actual.getLocalShort(j)) << "i=" << i << " j=" << j;
+            }
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_decoded_program_should_report_unknown_opcode_on_execution)
+    {
+        Interpreter::Program program;
+        program.mInstructions.push_back(0xffffffff);
+        TestInterpreterContext context;
+        EXPECT_THROW(runDecoded(program, context), std::runtime_error);
+    }
+
     TEST_F(MWScriptTest, mwscript_test_forum_thread)
     {
         registerExtensions();
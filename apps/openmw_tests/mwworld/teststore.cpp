@@ -3,8 +3,14 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
@@ -868,4 +874,148 @@ namespace
         ASSERT_NE(dialogue, nullptr);
         EXPECT_THAT(dialogue->mInfo, ElementsAre(HasIdEqualTo("info0"), HasIdEqualTo("info2")));
     }
+
+    // ESM4 file with a header and REFR records without groups, cell is set by the test like it's done for a group
+    struct Esm4File
+    {
+        std::string mContent;
+
+        Esm4File() { addRecord(ESM4::REC_TES4, 0, {}); }
+
+        void addRecord(std::uint32_t typeId, ESM::FormId32 id, const std::string& data)
+        {
+            ESM4::RecordHeader header{};
+            header.record.typeId = typeId;
+            header.record.dataSize = static_cast<std::uint32_t>(data.size());
+            header.record.id = id;
+            mContent.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            mContent.append(data);
+        }
+
+        void addReference(ESM::FormId32 id, ESM::FormId32 baseObj)
+        {
+            ESM4::SubRecordHeader header{};
+            header.typeId = ESM::fourCC("NAME");
+            header.dataSize = sizeof(baseObj);
+            std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+            data.append(reinterpret_cast<const char*>(&baseObj), sizeof(baseObj));
+            addRecord(ESM4::REC_REFR, id, data);
+        }
+    };
+
+    struct MWWorldESM4RefsStoreTest : Test
+    {
+        const ESM::FormId mCell{ 1, 0 };
+        const ESM::FormId mOtherCell{ 2, 0 };
+        std::mutex mMutex;
+        MWWorld::Store<ESM4::Cell> mCells;
+        MWWorld::Store<ESM4::Reference> mStore;
+
+        std::shared_ptr<ESM4::Reader> deferReferences(const Esm4File& file, std::span<const ESM::FormId> cells)
+        {
+            auto reader = std::make_shared<ESM4::Reader>(
+                std::make_unique<std::istringstream>(file.mContent), "test.esm", nullptr, nullptr);
+            for (const ESM::FormId& cell : cells)
+            {
+                if (!reader->getRecordHeader())
+                    throw std::runtime_error("Failed to read record header");
+                reader->setCurrCell(cell);
+                mStore.deferStatic(reader, mMutex);
+                reader->skipRecordData();
+            }
+            return reader;
+        }
+    };
+
+    MATCHER_P2(IsReference, id, baseObj, "")
+    {
+        return arg != nullptr && arg->mId == id && arg->mBaseObj == baseObj;
+    }
+
+    TEST_F(MWWorldESM4RefsStoreTest, getByCellShouldLoadDeferredReferences)
+    {
+        Esm4File file;
+        file.addReference(0x10, 0x20);
+        file.addReference(0x11, 0x21);
+        file.addReference(0x12, 0x22);
+        deferReferences(file, std::array{ mCell, mOtherCell, mCell });
+        mStore.preprocessReferences(mCells);
+
+        EXPECT_EQ(mStore.getSize(), 0);
+        EXPECT_THAT(mStore.getByCell(ESM::RefId(mCell)),
+            UnorderedElementsAre(IsReference(ESM::FormId{ 0x10, 0 }, ESM::FormId{ 0x20, 0 }),
+                IsReference(ESM::FormId{ 0x12, 0 }, ESM::FormId{ 0x22, 0 })));
+        EXPECT_THAT(mStore.getByCell(ESM::RefId(mOtherCell)),
+            ElementsAre(IsReference(ESM::FormId{ 0x11, 0 }, ESM::FormId{ 0x21, 0 })));
+        EXPECT_THAT(mStore.getByCell(ESM::RefId(ESM::FormId{ 3, 0 })), IsEmpty());
+    }
+
+    TEST_F(MWWorldESM4RefsStoreTest, getByCellShouldSetParentCellOfDeferredReferences)
+    {
+        Esm4File file;
+        file.addReference(0x10, 0x20);
+        deferReferences(file, std::array{ mCell });
+        mStore.preprocessReferences(mCells);
+
+        const std::span<const ESM4::Reference* const> refs = mStore.getByCell(ESM::RefId(mCell));
+        ASSERT_EQ(refs.size(), 1);
+        EXPECT_EQ(refs[0]->mParent, ESM::RefId(mCell));
+    }
+
+    TEST_F(MWWorldESM4RefsStoreTest, searchStaticShouldFindDeferredReference)
+    {
+        Esm4File file;
+        file.addReference(0x10, 0x20);
+        file.addReference(0x11, 0x21);
+        deferReferences(file, std::array{ mCell, mOtherCell });
+        mStore.preprocessReferences(mCells);
+
+        EXPECT_THAT(mStore.searchStatic(ESM::FormId{ 0x11, 0 }),
+            IsReference(ESM::FormId{ 0x11, 0 }, ESM::FormId{ 0x21, 0 }));
+        EXPECT_THAT(mStore.searchStatic(ESM::FormId{ 0x10, 0 }),
+            IsReference(ESM::FormId{ 0x10, 0 }, ESM::FormId{ 0x20, 0 }));
+        EXPECT_EQ(mStore.searchStatic(ESM::FormId{ 0x12, 0 }), nullptr);
+    }
+
+    TEST_F(MWWorldESM4RefsStoreTest, searchStaticShouldReturnReferenceLoadedByGetByCell)
+    {
+        Esm4File file;
+        file.addReference(0x10, 0x20);
+        deferReferences(file, std::array{ mCell });
+        mStore.preprocessReferences(mCells);
+
+        const std::span<const ESM4::Reference* const> refs = mStore.getByCell(ESM::RefId(mCell));
+        ASSERT_EQ(refs.size(), 1);
+        EXPECT_EQ(mStore.searchStatic(ESM::FormId{ 0x10, 0 }), refs[0]);
+    }
+
+    TEST_F(MWWorldESM4RefsStoreTest, deferStaticShouldOverrideStaticReference)
+    {
+        ESM4::Reference ref;
+        ref.mId = ESM::FormId{ 0x10, 0 };
+        ref.mBaseObj = ESM::FormId{ 0x30, 0 };
+        mStore.insertStatic(ref);
+
+        Esm4File file;
+        file.addReference(0x10, 0x20);
+        deferReferences(file, std::array{ mCell });
+        mStore.preprocessReferences(mCells);
+
+        EXPECT_THAT(mStore.searchStatic(ESM::FormId{ 0x10, 0 }),
+            IsReference(ESM::FormId{ 0x10, 0 }, ESM::FormId{ 0x20, 0 }));
+    }
+
+    TEST_F(MWWorldESM4RefsStoreTest, readerShouldBeReleasedWhenAllDeferredReferencesAreLoaded)
+    {
+        Esm4File file;
+        file.addReference(0x10, 0x20);
+        file.addReference(0x11, 0x21);
+        const std::weak_ptr<ESM4::Reader> reader = deferReferences(file, std::array{ mCell, mOtherCell });
+        mStore.preprocessReferences(mCells);
+
+        mStore.getByCell(ESM::RefId(mCell));
+        EXPECT_FALSE(reader.expired());
+        mStore.getByCell(ESM::RefId(mOtherCell));
+        EXPECT_TRUE(reader.expired());
+    }
 }
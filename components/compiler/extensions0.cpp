@@ -328,6 +328,7 @@ namespace Compiler
             extensions.registerInstruction("reloadlua", "", opcodeReloadLua);
             extensions.registerInstruction("testmodels", "", opcodeTestModels);
             extensions.registerInstruction("t3d", "", opcodeTestModels);
+            extensions.registerInstruction("writetrace", "", opcodeWriteTrace);
         }
     }
 
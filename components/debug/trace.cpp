@@ -0,0 +1,236 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Debug::Trace
+{
+    namespace
+    {
+        // Enough for a few seconds of a busy thread
+        constexpr std::uint64_t bufferCapacity = 1 << 16;
+
+        // Fields are atomic because they may be read by write while the owning thread overwrites them
+        struct Event
+        {
+            std::atomic<const char*> mName{ nullptr };
+            std::atomic<std::chrono::steady_clock::rep> mBegin{ 0 };
+            std::atomic<std::chrono::steady_clock::rep> mEnd{ 0 };
+        };
+
+        struct EventCopy
+        {
+            const char* mName;
+            std::chrono::steady_clock::time_point mBegin;
+            std::chrono::steady_clock::time_point mEnd;
+        };
+
+        struct ThreadBuffer
+        {
+            const std::size_t mThreadId;
+            std::string mThreadName;
+            std::atomic<std::uint64_t> mWritten{ 0 };
+            std::uint64_t mCleared = 0;
+            // Allocated by the first event, so naming a thread doesn't cost memory when tracing is disabled
+            std::unique_ptr<Event[]> mEvents;
+
+            explicit ThreadBuffer(std::size_t threadId)
+                : mThreadId(threadId)
+            {
+            }
+        };
+
+        struct Registry
+        {
+            std::mutex mMutex;
+            // Buffers outlive threads so events of finished threads are written too
+            std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+            const std::chrono::steady_clock::time_point mStart = std::chrono::steady_clock::now();
+            std::filesystem::path mFile;
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        ThreadBuffer& getThreadBuffer()
+        {
+            thread_local const std::shared_ptr<ThreadBuffer> buffer = [] {
+                Registry& registry = getRegistry();
+                const std::lock_guard lock(registry.mMutex);
+                auto result = std::make_shared<ThreadBuffer>(registry.mBuffers.size() + 1);
+                registry.mBuffers.push_back(result);
+                return result;
+            }();
+            return *buffer;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                           << std::dec;
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+
+        double toMicroseconds(std::chrono::steady_clock::duration value)
+        {
+            return std::chrono::duration<double, std::micro>(value).count();
+        }
+    }
+
+    namespace Detail
+    {
+        std::atomic_bool sEnabled{ false };
+
+        void addEvent(
+            const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+        {
+            ThreadBuffer& buffer = getThreadBuffer();
+            if (buffer.mEvents == nullptr)
+            {
+                const std::lock_guard lock(getRegistry().mMutex);
+                buffer.mEvents = std::make_unique<Event[]>(bufferCapacity);
+            }
+            // Only the owning thread writes into the buffer. The fence makes write see at least this value of mWritten
+            // after reading any field of the overwritten event, so the event is known to be overwritten.
+            const std::uint64_t index = buffer.mWritten.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            Event& event = buffer.mEvents[index % bufferCapacity];
+            event.mName.store(name, std::memory_order_relaxed);
+            event.mBegin.store(begin.time_since_epoch().count(), std::memory_order_relaxed);
+            event.mEnd.store(end.time_since_epoch().count(), std::memory_order_relaxed);
+            buffer.mWritten.store(index + 1, std::memory_order_release);
+        }
+    }
+
+    void setEnabled(bool value)
+    {
+        Detail::sEnabled.store(value, std::memory_order_relaxed);
+    }
+
+    void setThreadName(std::string_view name)
+    {
+        ThreadBuffer& buffer = getThreadBuffer();
+        const std::lock_guard lock(getRegistry().mMutex);
+        buffer.mThreadName = name;
+    }
+
+    void write(std::ostream& stream)
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+
+        const auto precision = stream.precision(3);
+        const auto flags = stream.setf(std::ios::fixed, std::ios::floatfield);
+
+        stream << "{\"traceEvents\":[";
+        bool first = true;
+        const auto separate = [&] {
+            if (!first)
+                stream << ",\n";
+            first = false;
+        };
+
+        std::vector<EventCopy> events;
+        for (const std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+        {
+            if (!buffer->mThreadName.empty())
+            {
+                separate();
+                stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->mThreadId
+                       << R"(,"args":{"name":)";
+                writeString(stream, buffer->mThreadName);
+                stream << "}}";
+            }
+
+            if (buffer->mEvents == nullptr)
+                continue;
+
+            const std::uint64_t written = buffer->mWritten.load(std::memory_order_acquire);
+            const std::uint64_t begin
+                = std::max(buffer->mCleared, written > bufferCapacity ? written - bufferCapacity : 0);
+            events.clear();
+            for (std::uint64_t i = begin; i < written; ++i)
+            {
+                const Event& event = buffer->mEvents[i % bufferCapacity];
+                events.push_back(EventCopy{
+                    .mName = event.mName.load(std::memory_order_relaxed),
+                    .mBegin = std::chrono::steady_clock::time_point(
+                        std::chrono::steady_clock::duration(event.mBegin.load(std::memory_order_relaxed))),
+                    .mEnd = std::chrono::steady_clock::time_point(
+                        std::chrono::steady_clock::duration(event.mEnd.load(std::memory_order_relaxed))),
+                });
+            }
+
+            // The owning thread may overwrite the oldest events while they are copied. The event with index equal to
+            // mWritten may be partially written, so its slot is considered overwritten too.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const std::uint64_t writtenAfter = buffer->mWritten.load(std::memory_order_relaxed) + 1;
+            const std::uint64_t overwritten = writtenAfter > bufferCapacity ? writtenAfter - bufferCapacity : 0;
+
+            for (std::uint64_t i = std::max(begin, overwritten); i < written; ++i)
+            {
+                const EventCopy& event = events[i - begin];
+                separate();
+                stream << R"({"name":)";
+                writeString(stream, event.mName);
+                stream << R"(,"ph":"X","pid":1,"tid":)" << buffer->mThreadId
+                       << R"(,"ts":)" << toMicroseconds(event.mBegin - registry.mStart)
+                       << R"(,"dur":)" << toMicroseconds(event.mEnd - event.mBegin) << '}';
+            }
+        }
+
+        stream << "],\"displayTimeUnit\":\"ms\"}\n";
+
+        stream.precision(precision);
+        stream.flags(flags);
+    }
+
+    void setFile(const std::filesystem::path& path)
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        registry.mFile = path;
+    }
+
+    std::filesystem::path getFile()
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        return registry.mFile;
+    }
+
+    bool writeFile()
+    {
+        std::ofstream stream(getFile(), std::ios_base::out);
+        if (!stream.is_open())
+            return false;
+        write(stream);
+        return true;
+    }
+
+    void clear()
+    {
+        Registry& registry = getRegistry();
+        const std::lock_guard lock(registry.mMutex);
+        for (const std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+            buffer->mCleared = buffer->mWritten.load(std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACE_H
+#define OPENMW_COMPONENTS_DEBUG_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+
+// Captures timings of scopes from all threads to be viewed in chrome://tracing or Perfetto. Each thread writes into
+// its own ring buffer without locking, so only the most recent events of each thread are kept. When capture is
+// disabled a scope costs a single relaxed atomic load. The trace can be written while threads keep adding events.
+namespace Debug::Trace
+{
+    namespace Detail
+    {
+        extern std::atomic_bool sEnabled;
+
+        void addEvent(const char* name, std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end);
+    }
+
+    inline bool isEnabled()
+    {
+        return Detail::sEnabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool value);
+
+    // Name is used for the thread track in the trace
+    void setThreadName(std::string_view name);
+
+    // Writes events collected so far in Chrome trace event JSON format
+    void write(std::ostream& stream);
+
+    // File written by writeFile
+    void setFile(const std::filesystem::path& path);
+
+    std::filesystem::path getFile();
+
+    // Writes events collected so far into the file set by setFile, returns false when it can't be opened
+    bool writeFile();
+
+    // Discards collected events
+    void clear();
+
+    class Scope
+    {
+    public:
+        // Name should be a string literal or any other string which lives until the trace is written
+        explicit Scope(const char* name)
+            : mName(isEnabled() ? name : nullptr)
+        {
+            if (mName != nullptr)
+                mBegin = std::chrono::steady_clock::now();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            if (mName != nullptr)
+                Detail::addEvent(mName, mBegin, std::chrono::steady_clock::now());
+        }
+
+    private:
+        const char* const mName;
+        std::chrono::steady_clock::time_point mBegin;
+    };
+}
+
+#endif
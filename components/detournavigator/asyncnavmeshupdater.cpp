@@ -8,6 +8,7 @@
 #include "version.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/thread.hpp>
@@ -450,12 +451,14 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
         Misc::setCurrentThreadIdlePriority();
+        Debug::Trace::setThreadName("Navigator");
         while (!mShouldStop)
         {
             if (JobIt job = getNextJob(); job != mJobs.end())
             {
                 try
                 {
+                    const Debug::Trace::Scope trace("AsyncNavMeshUpdater::processJob");
                     const JobStatus status = processJob(*job);
                     Log(Debug::Debug) << "Processed job " << job->mId << " with status=" << status
                                       << " changeType=" << job->mChangeType;
@@ -577,8 +580,10 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = takeSharedNavMeshTileData(job, *recastMesh);
+
+            if (preparedNavMeshData == nullptr)
+                preparedNavMeshData = prepareSharedNavMeshTileData(job, *recastMesh);
 
             if (preparedNavMeshData == nullptr)
             {
@@ -629,8 +634,9 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = takeSharedNavMeshTileData(job, *job.mRecastMesh);
+            if (preparedNavMeshData == nullptr)
+                preparedNavMeshData = prepareSharedNavMeshTileData(job, *job.mRecastMesh);
             generatedNavMeshData = true;
         }
 
@@ -664,6 +670,78 @@ namespace DetourNavigator
         return result;
     }
 
+    std::vector<AgentBounds> AsyncNavMeshUpdater::getAgentsToShareTile(const Job& job)
+    {
+        std::vector<AgentBounds> result;
+
+        // Tiles for update jobs are not cached and removed tiles are not generated, so only added tiles are shared
+        if (job.mChangeType != ChangeType::add)
+            return result;
+
+        const std::scoped_lock lock(mMutex);
+        const auto processingTiles = mProcessingTiles.lockConst();
+
+        for (const Job& other : mJobs)
+        {
+            if (other.mAgentBounds == job.mAgentBounds || other.mWorldspace != job.mWorldspace
+                || other.mChangedTile != job.mChangedTile || other.mChangeType != ChangeType::add
+                || processingTiles->contains(getAgentAndTile(other))
+                || std::find(result.begin(), result.end(), other.mAgentBounds) != result.end())
+                continue;
+            result.push_back(other.mAgentBounds);
+        }
+
+        return result;
+    }
+
+    std::unique_ptr<PreparedNavMeshData> AsyncNavMeshUpdater::prepareSharedNavMeshTileData(
+        const Job& job, const RecastMesh& recastMesh)
+    {
+        std::vector<AgentBounds> agentsBounds = getAgentsToShareTile(job);
+
+        if (agentsBounds.empty())
+            return prepareNavMeshTileData(
+                recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+
+        agentsBounds.insert(agentsBounds.begin(), job.mAgentBounds);
+
+        Log(Debug::Debug) << "Generating tile for job " << job.mId << " and " << agentsBounds.size() - 1
+                          << " other agent(s)";
+
+        std::vector<std::unique_ptr<PreparedNavMeshData>> prepared = prepareNavMeshTilesData(
+            recastMesh, job.mWorldspace, job.mChangedTile, agentsBounds, mSettings.get().mRecast);
+
+        const auto sharedTiles = mSharedTiles.lock();
+        for (std::size_t i = 1; i < agentsBounds.size(); ++i)
+        {
+            if (prepared[i] == nullptr)
+                continue;
+            (*sharedTiles)[std::make_tuple(agentsBounds[i], job.mChangedTile)] = SharedTileData{
+                .mWorldspace = job.mWorldspace,
+                .mRecastMeshVersion = recastMesh.getVersion(),
+                .mData = std::move(prepared[i]),
+            };
+        }
+
+        return std::move(prepared.front());
+    }
+
+    std::unique_ptr<PreparedNavMeshData> AsyncNavMeshUpdater::takeSharedNavMeshTileData(
+        const Job& job, const RecastMesh& recastMesh)
+    {
+        const auto sharedTiles = mSharedTiles.lock();
+        const auto it = sharedTiles->find(getAgentAndTile(job));
+        if (it == sharedTiles->end())
+            return nullptr;
+        SharedTileData shared = std::move(it->second);
+        sharedTiles->erase(it);
+        // Recast mesh has changed since the data was generated
+        if (shared.mWorldspace != job.mWorldspace || shared.mRecastMeshVersion != recastMesh.getVersion())
+            return nullptr;
+        Log(Debug::Debug) << "Use shared tile data for job " << job.mId;
+        return std::move(shared.mData);
+    }
+
     JobStatus AsyncNavMeshUpdater::handleUpdateNavMeshStatus(UpdateNavMeshStatus status, const Job& job,
         const GuardedNavMeshCacheItem& navMeshCacheItem, const RecastMesh& recastMesh)
     {
@@ -794,6 +872,7 @@ namespace DetourNavigator
     void AsyncNavMeshUpdater::removeJob(JobIt job)
     {
         Log(Debug::Debug) << "Removing job " << job->mId << " by thread=" << std::this_thread::get_id();
+        mSharedTiles.lock()->erase(getAgentAndTile(*job));
         const std::lock_guard lock(mMutex);
         mJobs.erase(job);
     }
@@ -897,12 +976,16 @@ namespace DetourNavigator
 
     void DbWorker::run() noexcept
     {
+        Debug::Trace::setThreadName("Navigator DB");
         while (!mShouldStop)
         {
             try
             {
                 if (const auto job = mQueue.pop())
+                {
+                    const Debug::Trace::Scope trace("DbWorker::processJob");
                     processJob(*job);
+                }
             }
             catch (const std::exception& e)
             {
@@ -12,6 +12,7 @@
 #include "stats.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
+#include "version.hpp"
 #include "waitconditiontype.hpp"
 
 #include <boost/geometry/geometries/point.hpp>
@@ -23,6 +24,7 @@
 #include <deque>
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -191,6 +193,14 @@ namespace DetourNavigator
         inline void processWritingJob(JobIt job);
     };
 
+    // Navmesh data generated by a job for another agent with a pending job for the same tile
+    struct SharedTileData
+    {
+        ESM::RefId mWorldspace;
+        Version mRecastMeshVersion;
+        std::unique_ptr<PreparedNavMeshData> mData;
+    };
+
     class AsyncNavMeshUpdater
     {
     public:
@@ -229,6 +239,7 @@ namespace DetourNavigator
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
+        Misc::ScopeGuarded<std::map<std::tuple<AgentBounds, TilePosition>, SharedTileData>> mSharedTiles;
         std::vector<std::thread> mThreads;
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits{ 0 };
@@ -241,6 +252,14 @@ namespace DetourNavigator
 
         inline JobStatus processJobWithDbResult(Job& job, GuardedNavMeshCacheItem& navMeshCacheItem);
 
+        inline std::vector<AgentBounds> getAgentsToShareTile(const Job& job);
+
+        inline std::unique_ptr<PreparedNavMeshData> prepareSharedNavMeshTileData(
+            const Job& job, const RecastMesh& recastMesh);
+
+        inline std::unique_ptr<PreparedNavMeshData> takeSharedNavMeshTileData(
+            const Job& job, const RecastMesh& recastMesh);
+
         inline JobStatus handleUpdateNavMeshStatus(UpdateNavMeshStatus status, const Job& job,
             const GuardedNavMeshCacheItem& navMeshCacheItem, const RecastMesh& recastMesh);
 
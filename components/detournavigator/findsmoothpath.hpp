@@ -82,6 +82,15 @@ namespace DetourNavigator
         const RecastSettings& mSettings;
     };
 
+    /// Buffers reused by consecutive findSmoothPath calls to avoid allocations per query.
+    struct FindSmoothPathBuffers
+    {
+        std::vector<dtPolyRef> mPolygonPath;
+        std::vector<float> mCornerVerts;
+        std::vector<unsigned char> mCornerFlags;
+        std::vector<dtPolyRef> mCornerPolys;
+    };
+
     inline std::optional<std::size_t> findPolygonPath(const dtNavMeshQuery& navMeshQuery, const dtPolyRef startRef,
         const dtPolyRef endRef, const osg::Vec3f& startPos, const osg::Vec3f& endPos, const dtQueryFilter& queryFilter,
         std::span<dtPolyRef> pathBuffer)
@@ -98,23 +107,24 @@ namespace DetourNavigator
 
     Status makeSmoothPath(const dtNavMeshQuery& navMeshQuery, const osg::Vec3f& start, const osg::Vec3f& end,
         std::span<dtPolyRef> polygonPath, std::size_t polygonPathSize, std::size_t maxSmoothPathSize, bool skipFirst,
-        std::output_iterator<osg::Vec3f> auto& out)
+        FindSmoothPathBuffers& buffers, std::output_iterator<osg::Vec3f> auto& out)
     {
         assert(polygonPathSize <= polygonPath.size());
 
-        std::vector<float> cornerVertsBuffer(maxSmoothPathSize * 3);
-        std::vector<unsigned char> cornerFlagsBuffer(maxSmoothPathSize);
-        std::vector<dtPolyRef> cornerPolysBuffer(maxSmoothPathSize);
+        buffers.mCornerVerts.resize(maxSmoothPathSize * 3);
+        buffers.mCornerFlags.resize(maxSmoothPathSize);
+        buffers.mCornerPolys.resize(maxSmoothPathSize);
         int cornersCount = 0;
         constexpr int findStraightPathOptions = DT_STRAIGHTPATH_AREA_CROSSINGS | DT_STRAIGHTPATH_ALL_CROSSINGS;
         if (const dtStatus status = navMeshQuery.findStraightPath(start.ptr(), end.ptr(), polygonPath.data(),
-                static_cast<int>(polygonPathSize), cornerVertsBuffer.data(), cornerFlagsBuffer.data(),
-                cornerPolysBuffer.data(), &cornersCount, static_cast<int>(maxSmoothPathSize), findStraightPathOptions);
+                static_cast<int>(polygonPathSize), buffers.mCornerVerts.data(), buffers.mCornerFlags.data(),
+                buffers.mCornerPolys.data(), &cornersCount, static_cast<int>(maxSmoothPathSize),
+                findStraightPathOptions);
             dtStatusFailed(status))
             return Status::FindStraightPathFailed;
 
         for (int i = skipFirst ? 1 : 0; i < cornersCount; ++i)
-            *out++ = Misc::Convert::makeOsgVec3f(&cornerVertsBuffer[static_cast<std::size_t>(i) * 3]);
+            *out++ = Misc::Convert::makeOsgVec3f(&buffers.mCornerVerts[static_cast<std::size_t>(i) * 3]);
 
         return Status::Success;
     }
@@ -122,7 +132,7 @@ namespace DetourNavigator
     Status findSmoothPath(const dtNavMeshQuery& navMeshQuery, const osg::Vec3f& halfExtents, const osg::Vec3f& start,
         const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts, const DetourSettings& settings,
         float endTolerance, const ToNavMeshCoordinatesSpan<const osg::Vec3f>& checkpoints,
-        std::output_iterator<osg::Vec3f> auto out)
+        FindSmoothPathBuffers& buffers, std::output_iterator<osg::Vec3f> auto out)
     {
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
@@ -149,8 +159,8 @@ namespace DetourNavigator
             dtStatusFailed(status) || endRef == 0)
             return Status::EndPolygonNotFound;
 
-        std::vector<dtPolyRef> polygonPath(settings.mMaxPolygonPathSize);
-        std::span<dtPolyRef> polygonPathBuffer = polygonPath;
+        buffers.mPolygonPath.resize(settings.mMaxPolygonPathSize);
+        std::span<dtPolyRef> polygonPath = buffers.mPolygonPath;
         dtPolyRef currentRef = startRef;
         osg::Vec3f currentNavMeshPos = startNavMeshPos;
         bool skipFirst = false;
@@ -178,7 +188,7 @@ namespace DetourNavigator
                 continue;
 
             const Status smoothStatus = makeSmoothPath(navMeshQuery, currentNavMeshPos, checkpointNavMeshPos,
-                polygonPath, *toCheckpointPathSize, settings.mMaxSmoothPathSize, skipFirst, out);
+                polygonPath, *toCheckpointPathSize, settings.mMaxSmoothPathSize, skipFirst, buffers, out);
 
             if (smoothStatus != Status::Success)
                 return smoothStatus;
@@ -189,7 +199,7 @@ namespace DetourNavigator
         }
 
         const std::optional<std::size_t> toEndPathSize = findPolygonPath(
-            navMeshQuery, currentRef, endRef, currentNavMeshPos, endNavMeshPos, queryFilter, polygonPathBuffer);
+            navMeshQuery, currentRef, endRef, currentNavMeshPos, endNavMeshPos, queryFilter, polygonPath);
 
         if (!toEndPathSize.has_value())
             return Status::FindPathOverPolygonsFailed;
@@ -204,7 +214,7 @@ namespace DetourNavigator
             return Status::TargetPolygonNotFound;
 
         const Status smoothStatus = makeSmoothPath(navMeshQuery, currentNavMeshPos, targetNavMeshPos, polygonPath,
-            *toEndPathSize, settings.mMaxSmoothPathSize, skipFirst, out);
+            *toEndPathSize, settings.mMaxSmoothPathSize, skipFirst, buffers, out);
 
         if (smoothStatus != Status::Success)
             return smoothStatus;
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 
 namespace DetourNavigator
 {
@@ -130,12 +131,17 @@ namespace DetourNavigator
             int mWalkableRadius = 0;
         };
 
+        int getWalkableClimb(const RecastSettings& settings)
+        {
+            return static_cast<int>(std::floor(getMaxClimb(settings) / settings.mCellHeight));
+        }
+
         RecastParams makeRecastParams(const RecastSettings& settings, const AgentBounds& agentBounds)
         {
             RecastParams result;
 
             result.mWalkableHeight = getWalkableHeight(settings, agentBounds);
-            result.mWalkableClimb = static_cast<int>(std::floor(getMaxClimb(settings) / settings.mCellHeight));
+            result.mWalkableClimb = getWalkableClimb(settings);
             result.mWalkableRadius = getWalkableRadius(settings, agentBounds);
             result.mMaxEdgeLen
                 = static_cast<int>(std::round(static_cast<float>(settings.mMaxEdgeLen) / settings.mCellSize));
@@ -195,7 +201,7 @@ namespace DetourNavigator
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const Mesh& mesh, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+            int walkableClimb, rcHeightfield& solid)
         {
             std::vector<unsigned char> areas(mesh.getAreaTypes().begin(), mesh.getAreaTypes().end());
             std::vector<float> vertices = mesh.getVertices();
@@ -219,11 +225,11 @@ namespace DetourNavigator
                 areas.data());
 
             return rcRasterizeTriangles(&context, vertices.data(), static_cast<int>(mesh.getVerticesCount()),
-                mesh.getIndices().data(), areas.data(), static_cast<int>(areas.size()), solid, params.mWalkableClimb);
+                mesh.getIndices().data(), areas.data(), static_cast<int>(areas.size()), solid, walkableClimb);
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const Rectangle& rectangle, AreaType areaType,
-            const RecastParams& params, rcHeightfield& solid)
+            int walkableClimb, rcHeightfield& solid)
         {
             const std::array vertices{
                 rectangle.mBounds.mMin.x(), rectangle.mHeight, rectangle.mBounds.mMin.y(), // vertex 0
@@ -243,11 +249,11 @@ namespace DetourNavigator
             const std::array<unsigned char, 2> areas{ areaType, areaType };
 
             return rcRasterizeTriangles(&context, vertices.data(), static_cast<int>(vertices.size() / 3),
-                indices.data(), areas.data(), static_cast<int>(areas.size()), solid, params.mWalkableClimb);
+                indices.data(), areas.data(), static_cast<int>(areas.size()), solid, walkableClimb);
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, float agentHalfExtentsZ,
-            const std::vector<CellWater>& water, const RecastSettings& settings, const RecastParams& params,
+            const std::vector<CellWater>& water, const RecastSettings& settings, int walkableClimb,
             const TileBounds& realTileBounds, rcHeightfield& solid)
         {
             for (const CellWater& cellWater : water)
@@ -259,7 +265,7 @@ namespace DetourNavigator
                     const Rectangle rectangle{ toNavMeshCoordinates(settings, *intersection),
                         toNavMeshCoordinates(
                             settings, getSwimLevel(settings, cellWater.mWater.mLevel, agentHalfExtentsZ)) };
-                    if (!rasterizeTriangles(context, rectangle, AreaType_water, params, solid))
+                    if (!rasterizeTriangles(context, rectangle, AreaType_water, walkableClimb, solid))
                         return false;
                 }
             }
@@ -267,8 +273,8 @@ namespace DetourNavigator
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const TileBounds& realTileBounds,
-            const std::vector<FlatHeightfield>& heightfields, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+            const std::vector<FlatHeightfield>& heightfields, const RecastSettings& settings, int walkableClimb,
+            rcHeightfield& solid)
         {
             for (const FlatHeightfield& heightfield : heightfields)
             {
@@ -277,7 +283,7 @@ namespace DetourNavigator
                 {
                     const Rectangle rectangle{ toNavMeshCoordinates(settings, *intersection),
                         toNavMeshCoordinates(settings, heightfield.mHeight) };
-                    if (!rasterizeTriangles(context, rectangle, AreaType_ground, params, solid))
+                    if (!rasterizeTriangles(context, rectangle, AreaType_ground, walkableClimb, solid))
                         return false;
                 }
             }
@@ -285,28 +291,43 @@ namespace DetourNavigator
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const std::vector<Heightfield>& heightfields,
-            const RecastSettings& settings, const RecastParams& params, rcHeightfield& solid)
+            const RecastSettings& settings, int walkableClimb, rcHeightfield& solid)
         {
             for (const Heightfield& heightfield : heightfields)
             {
                 const Mesh mesh = makeMesh(heightfield);
-                if (!rasterizeTriangles(context, mesh, settings, params, solid))
+                if (!rasterizeTriangles(context, mesh, settings, walkableClimb, solid))
                     return false;
             }
             return true;
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const TilePosition& tilePosition,
-            float agentHalfExtentsZ, const RecastMesh& recastMesh, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+        // Rasterizes everything except water which level depends on agent bounds
+        [[nodiscard]] bool rasterizeSharedTriangles(RecastContext& context, const TilePosition& tilePosition,
+            const RecastMesh& recastMesh, const RecastSettings& settings, int walkableClimb, rcHeightfield& solid)
         {
             const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
-            return rasterizeTriangles(context, recastMesh.getMesh(), settings, params, solid)
-                && rasterizeTriangles(
-                    context, agentHalfExtentsZ, recastMesh.getWater(), settings, params, realTileBounds, solid)
-                && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, params, solid)
+            return rasterizeTriangles(context, recastMesh.getMesh(), settings, walkableClimb, solid)
+                && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, walkableClimb, solid)
                 && rasterizeTriangles(
-                    context, realTileBounds, recastMesh.getFlatHeightfields(), settings, params, solid);
+                    context, realTileBounds, recastMesh.getFlatHeightfields(), settings, walkableClimb, solid);
+        }
+
+        [[nodiscard]] bool copyHeightfield(
+            RecastContext& context, const rcHeightfield& source, int walkableClimb, rcHeightfield& destination)
+        {
+            if (!rcCreateHeightfield(&context, destination, source.width, source.height, source.bmin, source.bmax,
+                    source.cs, source.ch))
+                return false;
+
+            // Spans of a column don't overlap, so adding them in order produces the same columns
+            for (int z = 0; z < source.height; ++z)
+                for (int x = 0; x < source.width; ++x)
+                    for (const rcSpan* span = source.spans[x + z * source.width]; span != nullptr; span = span->next)
+                        if (!rcAddSpan(&context, destination, x, z, span->smin, span->smax, span->area, walkableClimb))
+                            return false;
+
+            return true;
         }
 
         bool isValidWalkableHeight(int value)
@@ -519,32 +540,77 @@ namespace DetourNavigator
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
     {
-        RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
+        return std::move(
+            prepareNavMeshTilesData(recastMesh, worldspace, tilePosition, std::span(&agentBounds, 1), settings)
+                .front());
+    }
+
+    std::vector<std::unique_ptr<PreparedNavMeshData>> prepareNavMeshTilesData(const RecastMesh& recastMesh,
+        ESM::RefId worldspace, const TilePosition& tilePosition, std::span<const AgentBounds> agentsBounds,
+        const RecastSettings& settings)
+    {
+        std::vector<std::unique_ptr<PreparedNavMeshData>> result(agentsBounds.size());
 
-        const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+        if (agentsBounds.empty())
+            return result;
+
+        float minZ = std::numeric_limits<float>::max();
+        float maxZ = -std::numeric_limits<float>::max();
+        for (const AgentBounds& agentBounds : agentsBounds)
+        {
+            const auto [agentMinZ, agentMaxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+            minZ = std::min(minZ, agentMinZ);
+            maxZ = std::max(maxZ, agentMaxZ);
+        }
 
-        rcHeightfield solid;
+        RecastContext context(
+            worldspace, tilePosition, agentsBounds.front(), recastMesh.getVersion(), settings.mMaxLogLevel);
+
+        // Everything except water doesn't depend on agent bounds, so it is rasterized once and each agent gets a copy
+        rcHeightfield shared;
+        const int walkableClimb = getWalkableClimb(settings);
         if (!initHeightfield(context, tilePosition, toNavMeshCoordinates(settings, minZ),
-                toNavMeshCoordinates(settings, maxZ), settings, solid))
-            return nullptr;
+                toNavMeshCoordinates(settings, maxZ), settings, shared))
+            return result;
+
+        if (!rasterizeSharedTriangles(context, tilePosition, recastMesh, settings, walkableClimb, shared))
+            return result;
+
+        const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
+
+        for (std::size_t i = 0; i < agentsBounds.size(); ++i)
+        {
+            const AgentBounds& agentBounds = agentsBounds[i];
+            RecastContext agentContext(
+                worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
 
-        const RecastParams params = makeRecastParams(settings, agentBounds);
+            // The last agent takes the shared heightfield itself
+            rcHeightfield copy;
+            const bool last = i + 1 == agentsBounds.size();
+            if (!last && !copyHeightfield(agentContext, shared, walkableClimb, copy))
+                continue;
+            rcHeightfield& solid = last ? shared : copy;
 
-        if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
-            return nullptr;
+            if (!rasterizeTriangles(agentContext, agentBounds.mHalfExtents.z(), recastMesh.getWater(), settings,
+                    walkableClimb, realTileBounds, solid))
+                continue;
 
-        rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
-        rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
-        rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+            const RecastParams params = makeRecastParams(settings, agentBounds);
 
-        std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
+            rcFilterLowHangingWalkableObstacles(&agentContext, params.mWalkableClimb, solid);
+            rcFilterLedgeSpans(&agentContext, params.mWalkableHeight, params.mWalkableClimb, solid);
+            rcFilterWalkableLowHeightSpans(&agentContext, params.mWalkableHeight, solid);
 
-        if (!fillPolyMesh(context, settings, params, solid, result->mPolyMesh, result->mPolyMeshDetail))
-            return nullptr;
+            auto data = std::make_unique<PreparedNavMeshData>();
 
-        result->mCellSize = settings.mCellSize;
-        result->mCellHeight = settings.mCellHeight;
+            if (!fillPolyMesh(agentContext, settings, params, solid, data->mPolyMesh, data->mPolyMeshDetail))
+                continue;
+
+            data->mCellSize = settings.mCellSize;
+            data->mCellHeight = settings.mCellHeight;
+
+            result[i] = std::move(data);
+        }
 
         return result;
     }
@@ -7,6 +7,7 @@
 #include <components/esm/refid.hpp>
 
 #include <memory>
+#include <span>
 #include <vector>
 
 class dtNavMesh;
@@ -46,6 +47,12 @@ namespace DetourNavigator
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
 
+    // Rasterizes the recast mesh once and builds a tile for each agent from a copy of the heightfield. Result has
+    // an element per agent, nullptr if generation for the agent has failed.
+    std::vector<std::unique_ptr<PreparedNavMeshData>> prepareNavMeshTilesData(const RecastMesh& recastMesh,
+        ESM::RefId worldspace, const TilePosition& tilePosition, std::span<const AgentBounds> agentsBounds,
+        const RecastSettings& settings);
+
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
         const TilePosition& tile, const RecastSettings& settings);
@@ -35,10 +35,11 @@ namespace DetourNavigator
             return Status::NavMeshNotFound;
         const Settings& settings = navigator.getSettings();
         FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
+        thread_local FindSmoothPathBuffers buffers;
         const auto locked = navMesh->lock();
         return findSmoothPath(locked->getQuery(), toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
             toNavMeshCoordinates(settings.mRecast, start), toNavMeshCoordinates(settings.mRecast, end), includeFlags,
-            areaCosts, settings.mDetour, endTolerance, ToNavMeshCoordinatesSpan(checkpoints, settings.mRecast),
+            areaCosts, settings.mDetour, endTolerance, ToNavMeshCoordinatesSpan(checkpoints, settings.mRecast), buffers,
             outTransform);
     }
 
@@ -7,11 +7,20 @@
 
 #include <DetourAlloc.h>
 
+#include <smhasher/MurmurHash3.h>
+
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <format>
+#include <iterator>
+#include <limits>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -29,12 +38,10 @@ namespace DetourNavigator
                 tile_position_y INTEGER NOT NULL,
                 version INTEGER NOT NULL,
                 input BLOB,
-                data BLOB
+                data BLOB,
+                input_hash BLOB
             );
 
-            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input
-                ON tiles (worldspace, tile_position_x, tile_position_y, input);
-
             CREATE INDEX IF NOT EXISTS index_tiles_by_worldspace_and_tile_position
                 ON tiles (worldspace, tile_position_x, tile_position_y);
 
@@ -51,31 +58,45 @@ namespace DetourNavigator
             COMMIT;
         )";
 
+        // Increment with every migration added to migrate
+        constexpr int schemaVersion = 1;
+
+        constexpr const char inputHashIndex[] = R"(
+            DROP INDEX IF EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input;
+
+            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input_hash
+                ON tiles (worldspace, tile_position_x, tile_position_y, input_hash);
+        )";
+
         constexpr std::string_view getMaxTileIdQuery = R"(
             SELECT max(tile_id) FROM tiles
         )";
 
         constexpr std::string_view findTileQuery = R"(
-            SELECT tile_id, version
+            SELECT tile_id, version, input
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view getTileDataQuery = R"(
-            SELECT tile_id, version, data
+            SELECT tile_id, version, input, data
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
+        // A conflict by the input hash is resolved by NavMeshDb::insertTile, other conflicts are errors
         constexpr std::string_view insertTileQuery = R"(
-            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
-                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
+            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input_hash,
+                                input,  data)
+                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input_hash,
+                               :input, :data)
+                ON CONFLICT (worldspace, tile_position_x, tile_position_y, input_hash) DO NOTHING
         )";
 
         constexpr std::string_view updateTileQuery = R"(
@@ -152,6 +173,162 @@ namespace DetourNavigator
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        using InputHash = std::array<std::uint64_t, 2>;
+
+        InputHash getInputHash(const std::vector<std::byte>& input)
+        {
+            const InputHash seed{ 0, 0 };
+            InputHash result;
+            MurmurHash3_x64_128(input.data(), static_cast<int>(input.size()), seed.data(), result.data());
+            return result;
+        }
+
+        Sqlite3::ConstBlob toBlob(const InputHash& hash)
+        {
+            return Sqlite3::ConstBlob{ reinterpret_cast<const char*>(hash.data()), static_cast<int>(sizeof(hash)) };
+        }
+
+        // Check the stored compressed input against the given one to rule out a hash collision. Compares the size
+        // stored by Misc::compress before decompressing.
+        bool isSameInput(const std::vector<std::byte>& compressedInput, const std::vector<std::byte>& input)
+        {
+            std::size_t size = 0;
+            if (compressedInput.size() < sizeof(size))
+                return false;
+            std::memcpy(&size, compressedInput.data(), sizeof(size));
+            return size == input.size() && Misc::decompress(compressedInput) == input;
+        }
+
+        struct GetUserVersion
+        {
+            static std::string_view text() noexcept { return "pragma user_version;"; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct HasInputHashColumn
+        {
+            static std::string_view text() noexcept
+            {
+                return "SELECT count(*) FROM pragma_table_info('tiles') WHERE name = 'input_hash';";
+            }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct GetTilesWithoutInputHash
+        {
+            static std::string_view text() noexcept
+            {
+                return R"(
+                    SELECT tile_id, input
+                      FROM tiles
+                     WHERE input_hash IS NULL
+                       AND tile_id > :min_tile_id
+                     ORDER BY tile_id
+                     LIMIT :limit
+                )";
+            }
+
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId minTileId, int limit)
+            {
+                Sqlite3::bindParameter(db, statement, ":min_tile_id", minTileId);
+                Sqlite3::bindParameter(db, statement, ":limit", limit);
+            }
+        };
+
+        struct SetInputHash
+        {
+            static std::string_view text() noexcept
+            {
+                return "UPDATE tiles SET input_hash = :input_hash WHERE tile_id = :tile_id";
+            }
+
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, const Sqlite3::ConstBlob& inputHash)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+                Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
+            }
+        };
+
+        struct DeleteTile
+        {
+            static std::string_view text() noexcept { return "DELETE FROM tiles WHERE tile_id = :tile_id"; }
+
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+            }
+        };
+
+        void exec(sqlite3& db, const char* query)
+        {
+            if (const int ec = sqlite3_exec(&db, query, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed to execute \"" + std::string(query) + "\": " + sqlite3_errmsg(&db));
+        }
+
+        int getUserVersion(sqlite3& db)
+        {
+            Sqlite3::Statement<GetUserVersion> statement(db);
+            int value = 0;
+            request(db, statement, &value, 1);
+            return value;
+        }
+
+        // Tiles written by versions before 1 are indexed by the compressed input itself
+        void addInputHash(sqlite3& db)
+        {
+            Sqlite3::Statement<HasInputHashColumn> hasInputHashColumn(db);
+            int count = 0;
+            request(db, hasInputHashColumn, &count, 1);
+            if (count == 0)
+                exec(db, "ALTER TABLE tiles ADD COLUMN input_hash BLOB;");
+
+            Sqlite3::Statement<GetTilesWithoutInputHash> getTiles(db);
+            Sqlite3::Statement<SetInputHash> setInputHash(db);
+            constexpr int batchSize = 256;
+            std::vector<std::tuple<TileId, std::vector<std::byte>>> tiles;
+            TileId minTileId{ std::numeric_limits<std::int64_t>::min() };
+            std::size_t updated = 0;
+            while (true)
+            {
+                tiles.clear();
+                request(db, getTiles, std::back_inserter(tiles), batchSize, minTileId, batchSize);
+                if (tiles.empty())
+                    break;
+                for (const auto& [tileId, input] : tiles)
+                {
+                    const InputHash hash = getInputHash(Misc::decompress(input));
+                    execute(db, setInputHash, tileId, toBlob(hash));
+                }
+                minTileId = std::get<0>(tiles.back());
+                updated += tiles.size();
+            }
+
+            exec(db, inputHashIndex);
+
+            if (updated != 0)
+                Log(Debug::Info) << "Added input hash to " << updated << " navmesh tiles";
+        }
+
+        Sqlite3::Db makeNavMeshDb(std::string_view path)
+        {
+            Sqlite3::Db db = Sqlite3::makeDb(path, schema);
+
+            const int version = getUserVersion(*db);
+            if (version >= schemaVersion)
+                return db;
+
+            Sqlite3::Transaction transaction(*db);
+
+            if (version < 1)
+                addInputHash(*db);
+
+            exec(*db, std::format("pragma user_version = {};", schemaVersion).c_str());
+
+            transaction.commit();
+
+            return db;
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -167,7 +344,7 @@ namespace DetourNavigator
     }
 
     NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize)
-        : mDb(Sqlite3::makeDb(path, schema))
+        : mDb(makeNavMeshDb(path))
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
@@ -202,33 +379,62 @@ namespace DetourNavigator
     std::optional<Tile> NavMeshDb::findTile(
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
-        Tile result;
-        auto row = std::tie(result.mTileId, result.mVersion);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mFindTile, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
-            return {};
-        return result;
+        const InputHash inputHash = getInputHash(input);
+        std::vector<std::tuple<TileId, TileVersion, std::vector<std::byte>>> rows;
+        request(*mDb, mFindTile, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+            worldspace.serializeText(), tilePosition, toBlob(inputHash));
+        for (const auto& [tileId, version, compressedInput] : rows)
+            if (isSameInput(compressedInput, input))
+                return Tile{ tileId, version };
+        return {};
     }
 
     std::optional<TileData> NavMeshDb::getTileData(
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
-        TileData result;
-        auto row = std::tie(result.mTileId, result.mVersion, result.mData);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
-            return {};
-        result.mData = Misc::decompress(result.mData);
-        return result;
+        const InputHash inputHash = getInputHash(input);
+        std::vector<std::tuple<TileId, TileVersion, std::vector<std::byte>, std::vector<std::byte>>> rows;
+        request(*mDb, mGetTileData, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+            worldspace.serializeText(), tilePosition, toBlob(inputHash));
+        for (auto& [tileId, version, compressedInput, data] : rows)
+            if (isSameInput(compressedInput, input))
+                return TileData{ tileId, version, Misc::decompress(data) };
+        return {};
     }
 
     int NavMeshDb::insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition,
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
+        const InputHash inputHash = getInputHash(input);
         const std::vector<std::byte> compressedInput = Misc::compress(input);
         const std::vector<std::byte> compressedData = Misc::compress(data);
-        return execute(*mDb, mInsertTile, tileId, worldspace.serializeText(), tilePosition, version, compressedInput,
-            compressedData);
+        const auto insert = [&] {
+            return execute(*mDb, mInsertTile, tileId, worldspace.serializeText(), tilePosition, version,
+                toBlob(inputHash), compressedInput, compressedData);
+        };
+
+        if (const int inserted = insert(); inserted != 0)
+            return inserted;
+
+        // There is a tile with the same input hash at this position. The same input means a duplicate which is an
+        // error like a duplicate tile id. A different input is a hash collision, the old tile is replaced because
+        // only one of them can be found.
+        std::vector<std::tuple<TileId, TileVersion, std::vector<std::byte>>> rows;
+        request(*mDb, mFindTile, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+            worldspace.serializeText(), tilePosition, toBlob(inputHash));
+        Sqlite3::Statement<DeleteTile> deleteTile(*mDb);
+        for (const auto& [existingTileId, existingVersion, existingInput] : rows)
+        {
+            if (isSameInput(existingInput, input))
+                throw std::runtime_error("Navmesh tile with the same input already exists: "
+                    + std::to_string(existingTileId.mValue) + " (inserting " + std::to_string(tileId.mValue) + ")");
+            execute(*mDb, deleteTile, existingTileId);
+            ++mInputHashCollisions;
+            Log(Debug::Warning) << "Navmesh tile " << existingTileId.mValue << " is replaced by tile " << tileId.mValue
+                                << " with a different input but the same input hash";
+        }
+
+        return insert();
     }
 
     int NavMeshDb::updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data)
@@ -290,12 +496,12 @@ namespace DetourNavigator
         }
 
         void FindTile::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view GetTileData::text() noexcept
@@ -304,12 +510,12 @@ namespace DetourNavigator
         }
 
         void GetTileData::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view InsertTile::text() noexcept
@@ -318,14 +524,15 @@ namespace DetourNavigator
         }
 
         void InsertTile::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
-            const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-            const std::vector<std::byte>& data)
+            const TilePosition& tilePosition, TileVersion version, const Sqlite3::ConstBlob& inputHash,
+            const std::vector<std::byte>& input, const std::vector<std::byte>& data)
         {
             Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
             Sqlite3::bindParameter(db, statement, ":version", version);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
             Sqlite3::bindParameter(db, statement, ":input", input);
             Sqlite3::bindParameter(db, statement, ":data", data);
         }
@@ -60,22 +60,22 @@ namespace DetourNavigator
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct GetTileData
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct InsertTile
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
-                const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-                const std::vector<std::byte>& data);
+                const TilePosition& tilePosition, TileVersion version, const Sqlite3::ConstBlob& inputHash,
+                const std::vector<std::byte>& input, const std::vector<std::byte>& data);
         };
 
         struct UpdateTile
@@ -133,6 +133,8 @@ namespace DetourNavigator
         };
     }
 
+    /// Tiles are looked up by a hash of their input. The compressed input is stored only to verify the match.
+    /// Databases created by older versions are migrated on open.
     class NavMeshDb
     {
     public:
@@ -167,6 +169,9 @@ namespace DetourNavigator
 
         void vacuum();
 
+        // Number of tiles replaced by insertTile because of a different input with the same hash
+        std::size_t getInputHashCollisions() const { return mInputHashCollisions; }
+
     private:
         Sqlite3::Db mDb;
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
@@ -181,6 +186,7 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
+        std::size_t mInputHashCollisions = 0;
     };
 }
 
@@ -0,0 +1,189 @@
+#include "pathqueryservice.hpp"
+#include "debug.hpp"
+#include "findsmoothpath.hpp"
+#include "navigator.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/guarded.hpp>
+
+#include <DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <span>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        // Limits number of jobs taken by a thread at once to let other threads share the queue
+        constexpr std::size_t maxBatchSize = 16;
+
+        PathQueryResult processQuery(const Settings& settings, const PathQuery& query,
+            const SharedNavMeshCacheItem& navMesh, dtNavMeshQuery& navMeshQuery, FindSmoothPathBuffers& buffers)
+        {
+            PathQueryResult result;
+
+            if (navMesh == nullptr)
+            {
+                result.mStatus = Status::NavMeshNotFound;
+                return result;
+            }
+
+            const auto locked = navMesh->lockConst();
+
+            // dtNavMeshQuery resets its node pool for each query, initialization is needed only for another navmesh
+            if (navMeshQuery.getAttachedNavMesh() != &locked->getImpl())
+            {
+                if (const dtStatus status
+                    = navMeshQuery.init(&locked->getImpl(), settings.mDetour.mMaxNavMeshQueryNodes);
+                    dtStatusFailed(status))
+                {
+                    Log(Debug::Error) << "Failed to init dtNavMeshQuery for path query: " << WriteDtStatus{ status };
+                    result.mStatus = Status::InitNavMeshQueryFailed;
+                    return result;
+                }
+            }
+
+            auto out = std::back_inserter(result.mPath);
+            FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
+            result.mStatus = findSmoothPath(navMeshQuery,
+                toNavMeshCoordinates(settings.mRecast, query.mAgentBounds.mHalfExtents),
+                toNavMeshCoordinates(settings.mRecast, query.mStart),
+                toNavMeshCoordinates(settings.mRecast, query.mEnd), query.mIncludeFlags, query.mAreaCosts,
+                settings.mDetour, query.mEndTolerance,
+                ToNavMeshCoordinatesSpan(std::span<const osg::Vec3f>(query.mCheckpoints), settings.mRecast), buffers,
+                outTransform);
+
+            return result;
+        }
+    }
+
+    PathQueryService::PathQueryService(const Navigator& navigator, std::size_t threads)
+        : mNavigator(navigator)
+        , mSettings(navigator.getSettings())
+        , mThreadsCount(std::max<std::size_t>(threads, 1))
+    {
+        for (std::size_t i = 0; i < mThreadsCount; ++i)
+            mThreads.emplace_back([this] { run(); });
+    }
+
+    PathQueryService::~PathQueryService()
+    {
+        stop();
+    }
+
+    void PathQueryService::enqueue(PathQuery&& query, Callback&& callback)
+    {
+        SharedNavMeshCacheItem navMesh = mNavigator.getNavMesh(query.mAgentBounds);
+        const std::lock_guard lock(mMutex);
+        mQueued.push_back(Job{
+            .mQuery = std::move(query),
+            .mNavMesh = std::move(navMesh),
+            .mCallback = std::move(callback),
+            .mResult = {},
+        });
+        mHasJob.notify_one();
+    }
+
+    void PathQueryService::update()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mDelivering.swap(mDone);
+        }
+
+        for (Job& job : mDelivering)
+        {
+            try
+            {
+                job.mCallback(std::move(job.mResult));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Path query callback has failed: " << e.what();
+            }
+        }
+
+        mDelivering.clear();
+    }
+
+    void PathQueryService::wait()
+    {
+        std::unique_lock lock(mMutex);
+        mJobDone.wait(lock, [&] { return mQueued.empty() && mProcessing == 0; });
+    }
+
+    PathQueryServiceStats PathQueryService::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return PathQueryServiceStats{
+            .mQueued = mQueued.size(),
+            .mProcessing = mProcessing,
+            .mDone = mDone.size(),
+        };
+    }
+
+    void PathQueryService::stop()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+            mQueued.clear();
+            mHasJob.notify_all();
+        }
+        for (std::thread& thread : mThreads)
+            if (thread.joinable())
+                thread.join();
+    }
+
+    void PathQueryService::run() noexcept
+    {
+        dtNavMeshQuery navMeshQuery;
+        FindSmoothPathBuffers buffers;
+        std::vector<Job> batch;
+
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                mHasJob.wait(lock, [&] { return mShouldStop || !mQueued.empty(); });
+                if (mShouldStop)
+                    return;
+                const std::size_t size = std::clamp<std::size_t>(mQueued.size() / mThreadsCount, 1, maxBatchSize);
+                const auto end = mQueued.begin() + static_cast<std::ptrdiff_t>(size);
+                std::move(mQueued.begin(), end, std::back_inserter(batch));
+                mQueued.erase(mQueued.begin(), end);
+                mProcessing += size;
+            }
+
+            for (Job& job : batch)
+            {
+                try
+                {
+                    job.mResult = processQuery(mSettings, job.mQuery, job.mNavMesh, navMeshQuery, buffers);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Path query has failed: " << e.what();
+                    job.mResult = PathQueryResult{ .mStatus = Status::FindPathOverPolygonsFailed, .mPath = {} };
+                }
+                // Don't keep navmesh alive longer than needed
+                job.mNavMesh = nullptr;
+            }
+
+            {
+                const std::lock_guard lock(mMutex);
+                mProcessing -= batch.size();
+                std::move(batch.begin(), batch.end(), std::back_inserter(mDone));
+                mJobDone.notify_all();
+            }
+
+            batch.clear();
+        }
+    }
+}
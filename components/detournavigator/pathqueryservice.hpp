@@ -0,0 +1,102 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHQUERYSERVICE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHQUERYSERVICE_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "sharednavmeshcacheitem.hpp"
+#include "status.hpp"
+
+#include <osg/Vec3f>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct Navigator;
+    struct Settings;
+
+    struct PathQuery
+    {
+        AgentBounds mAgentBounds;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+        std::vector<osg::Vec3f> mCheckpoints;
+    };
+
+    struct PathQueryResult
+    {
+        Status mStatus = Status::Success;
+        std::vector<osg::Vec3f> mPath;
+    };
+
+    struct PathQueryServiceStats
+    {
+        std::size_t mQueued = 0;
+        std::size_t mProcessing = 0;
+        std::size_t mDone = 0;
+    };
+
+    /// \brief Finds paths over navmesh on background threads
+    ///
+    /// Each thread owns a dtNavMeshQuery and path buffers reused for all queries it processes. Threads take queued
+    /// queries in batches. Results are passed to the callbacks by update on the thread calling it, so callbacks
+    /// submitted during a frame are called in the next update after the path is found.
+    class PathQueryService
+    {
+    public:
+        using Callback = std::function<void(PathQueryResult&&)>;
+
+        explicit PathQueryService(const Navigator& navigator, std::size_t threads);
+
+        ~PathQueryService();
+
+        /// Has to be called from the same thread as the navigator updates.
+        void enqueue(PathQuery&& query, Callback&& callback);
+
+        /// Calls callbacks of finished queries.
+        void update();
+
+        /// Blocks until all enqueued queries are finished. Callbacks are still called only by update.
+        void wait();
+
+        PathQueryServiceStats getStats() const;
+
+    private:
+        struct Job
+        {
+            PathQuery mQuery;
+            SharedNavMeshCacheItem mNavMesh;
+            Callback mCallback;
+            PathQueryResult mResult;
+        };
+
+        const Navigator& mNavigator;
+        const Settings& mSettings;
+        const std::size_t mThreadsCount;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mJobDone;
+        bool mShouldStop = false;
+        std::deque<Job> mQueued;
+        std::size_t mProcessing = 0;
+        std::vector<Job> mDone;
+        std::vector<Job> mDelivering;
+        std::vector<std::thread> mThreads;
+
+        void run() noexcept;
+
+        void stop();
+    };
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "localizedstrings.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace ESM4
+{
+    namespace
+    {
+        std::uint32_t readUint32(std::span<const char> content, std::size_t offset)
+        {
+            std::uint32_t result;
+            std::memcpy(&result, content.data() + offset, sizeof(result));
+            return result;
+        }
+    }
+
+    LocalizedStrings::LocalizedStrings(LocalizedStringType type, Platform::File::ScopedMapping&& mapping)
+        : mType(type)
+        , mMapping(std::move(mapping))
+    {
+        buildIndex(mMapping.getData());
+    }
+
+    LocalizedStrings::LocalizedStrings(LocalizedStringType type, std::istream& stream)
+        : mType(type)
+        , mBuffer(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>())
+    {
+        buildIndex(mBuffer);
+    }
+
+    void LocalizedStrings::buildIndex(std::span<const char> content)
+    {
+        constexpr std::size_t headerSize = 2 * sizeof(std::uint32_t);
+        constexpr std::size_t entrySize = 2 * sizeof(std::uint32_t);
+
+        if (content.size() < headerSize)
+            throw std::runtime_error("Localized strings file is too small: " + std::to_string(content.size()));
+
+        const std::uint32_t numEntries = readUint32(content, 0);
+        const std::uint32_t dataSize = readUint32(content, sizeof(std::uint32_t));
+        const std::size_t directorySize = headerSize + static_cast<std::size_t>(numEntries) * entrySize;
+
+        if (content.size() < directorySize || content.size() - directorySize < dataSize)
+            throw std::runtime_error("Localized strings file of " + std::to_string(content.size()) + " bytes has "
+                + std::to_string(numEntries) + " entries and " + std::to_string(dataSize) + " bytes of data");
+
+        mData = content.subspan(content.size() - dataSize);
+
+        mEntries.reserve(numEntries);
+        for (std::size_t i = 0; i < numEntries; ++i)
+        {
+            const std::size_t offset = headerSize + i * entrySize;
+            mEntries.push_back(Entry{
+                .mStringId = readUint32(content, offset),
+                .mOffset = readUint32(content, offset + sizeof(std::uint32_t)),
+            });
+        }
+
+        // Duplicated ids resolve to the string with the lowest offset
+        std::sort(mEntries.begin(), mEntries.end(), [](const Entry& l, const Entry& r) {
+            return l.mStringId < r.mStringId || (l.mStringId == r.mStringId && l.mOffset < r.mOffset);
+        });
+    }
+
+    std::optional<std::string_view> LocalizedStrings::find(std::uint32_t stringId) const
+    {
+        const auto it = std::lower_bound(mEntries.begin(), mEntries.end(), stringId,
+            [](const Entry& entry, std::uint32_t id) { return entry.mStringId < id; });
+        if (it == mEntries.end() || it->mStringId != stringId)
+            return std::nullopt;
+
+        if (it->mOffset >= mData.size())
+            throw std::runtime_error("Localized string " + std::to_string(stringId) + " offset "
+                + std::to_string(it->mOffset) + " is out of data bounds " + std::to_string(mData.size()));
+
+        const std::string_view data(mData.data() + it->mOffset, mData.size() - it->mOffset);
+
+        if (mType == LocalizedStringType::Strings)
+            return data.substr(0, data.find('\0'));
+
+        if (data.size() < sizeof(std::uint32_t))
+            throw std::runtime_error("Localized string " + std::to_string(stringId) + " has no size");
+
+        std::uint32_t size;
+        std::memcpy(&size, data.data(), sizeof(size));
+        if (size > data.size() - sizeof(size))
+            throw std::runtime_error("Localized string " + std::to_string(stringId) + " size " + std::to_string(size)
+                + " is out of data bounds " + std::to_string(data.size() - sizeof(size)));
+
+        // Size includes null terminator
+        std::string_view result = data.substr(sizeof(size), size);
+        if (!result.empty() && result.back() == '\0')
+            result.remove_suffix(1);
+        return result;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef OPENMW_COMPONENTS_ESM4_LOCALIZEDSTRINGS_H
+#define OPENMW_COMPONENTS_ESM4_LOCALIZEDSTRINGS_H
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <components/platform/file.hpp>
+
+namespace ESM4
+{
+    enum class LocalizedStringType
+    {
+        Strings,
+        ILStrings,
+        DLStrings,
+    };
+
+    // Content of a .STRINGS, .ILSTRINGS or .DLSTRINGS file indexed by string id. Strings are neither copied nor
+    // decoded, found ones point into the file content which is memory mapped when the file is on the filesystem.
+    class LocalizedStrings
+    {
+    public:
+        explicit LocalizedStrings(LocalizedStringType type, Platform::File::ScopedMapping&& mapping);
+
+        // Reads the whole stream, used for files from archives
+        explicit LocalizedStrings(LocalizedStringType type, std::istream& stream);
+
+        LocalizedStringType getType() const { return mType; }
+
+        std::size_t getSize() const { return mEntries.size(); }
+
+        // Returns the string without null terminator or nullopt if there is no string with given id
+        std::optional<std::string_view> find(std::uint32_t stringId) const;
+
+    private:
+        struct Entry
+        {
+            std::uint32_t mStringId;
+            std::uint32_t mOffset;
+        };
+
+        LocalizedStringType mType;
+        Platform::File::ScopedMapping mMapping;
+        std::vector<char> mBuffer;
+        std::span<const char> mData;
+        std::vector<Entry> mEntries;
+
+        void buildIndex(std::span<const char> content);
+    };
+}
+
+#endif
@@ -0,0 +1,270 @@
+#include "readahead.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+#include <components/bsa/memorystream.hpp>
+#include <components/debug/debuglog.hpp>
+
+#include "common.hpp"
+#include "reader.hpp"
+
+namespace ESM4
+{
+    namespace
+    {
+        // Keeps memory usage bounded while giving each thread a few records to work on
+        constexpr std::size_t pendingPerThread = 16;
+
+        std::string getError(const std::string& header, const int errorCode, const char* msg)
+        {
+            return header + ": code " + std::to_string(errorCode) + ", " + std::string(msg != nullptr ? msg : "(null)");
+        }
+
+        struct InflateEnd
+        {
+            void operator()(z_stream* stream) const { inflateEnd(stream); }
+        };
+
+        std::optional<std::string> tryDecompressAll(std::span<char> compressed, std::span<char> decompressed)
+        {
+            z_stream stream{};
+
+            stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
+            stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
+            stream.avail_in = static_cast<uInt>(compressed.size());
+            stream.avail_out = static_cast<uInt>(decompressed.size());
+
+            if (const int ec = inflateInit(&stream); ec != Z_OK)
+                return getError("inflateInit error", ec, stream.msg);
+
+            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
+
+            if (const int ec = inflate(&stream, Z_NO_FLUSH); ec != Z_STREAM_END)
+                return getError("inflate error", ec, stream.msg);
+
+            return std::nullopt;
+        }
+
+        std::optional<std::string> tryDecompressByBlock(
+            std::span<char> compressed, std::span<char> decompressed, std::size_t blockSize)
+        {
+            z_stream stream{};
+
+            if (const int ec = inflateInit(&stream); ec != Z_OK)
+                return getError("inflateInit error", ec, stream.msg);
+
+            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
+
+            while (!compressed.empty() && !decompressed.empty())
+            {
+                const auto prevTotalIn = stream.total_in;
+                const auto prevTotalOut = stream.total_out;
+                stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
+                stream.avail_in = static_cast<uInt>(std::min(blockSize, compressed.size()));
+                stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
+                stream.avail_out = static_cast<uInt>(std::min(blockSize, decompressed.size()));
+                const int ec = inflate(&stream, Z_NO_FLUSH);
+                if (ec == Z_STREAM_END)
+                    break;
+                if (ec != Z_OK)
+                    return getError(
+                        "inflate error after reading " + std::to_string(stream.total_in) + " bytes", ec, stream.msg);
+                compressed = compressed.subspan(stream.total_in - prevTotalIn);
+                decompressed = decompressed.subspan(stream.total_out - prevTotalOut);
+            }
+
+            return std::nullopt;
+        }
+    }
+
+    std::unique_ptr<Bsa::MemoryInputStream> decompress(
+        std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
+    {
+        auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
+
+        const std::span decompressed(result->getRawData(), uncompressedSize);
+
+        const auto allError = tryDecompressAll(compressed, decompressed);
+        if (!allError.has_value())
+            return result;
+
+        Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
+                            << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
+                            << " uncompressed size = " << uncompressedSize << ": " << *allError
+                            << ". Trying to decompress by block...";
+
+        std::memset(result->getRawData(), 0, uncompressedSize);
+
+        constexpr std::size_t blockSize = 4;
+        const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
+        if (!blockError.has_value())
+            return result;
+
+        std::ostringstream s;
+        s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
+          << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
+          << " uncompressed size = " << uncompressedSize << ": " << *blockError;
+        throw std::runtime_error(s.str());
+    }
+
+    ReadAhead::ReadAhead(std::size_t threads)
+        : mMaxPending(std::max<std::size_t>(threads, 1) * pendingPerThread)
+    {
+        mThreads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            mThreads.emplace_back([this] { run(); });
+    }
+
+    ReadAhead::~ReadAhead()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+            mTasks.clear();
+        }
+        mHasTask.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    std::unique_ptr<Bsa::MemoryInputStream> ReadAhead::take(std::uint32_t typeId, std::streamoff position)
+    {
+        mLoadedTypes.insert(typeId);
+        const auto it = mPending.find(position);
+        if (it == mPending.end())
+            return nullptr;
+        std::future<std::unique_ptr<Bsa::MemoryInputStream>> result = std::move(it->second);
+        mPending.erase(it);
+        return result.get();
+    }
+
+    void ReadAhead::read(std::istream& stream, std::size_t recHeaderSize, std::streamoff fileSize)
+    {
+        if (mThreads.empty())
+            return;
+
+        const std::streamoff start = stream.tellg();
+        if (start < 0)
+            return;
+
+        // Drop records skipped by the reader
+        mPending.erase(mPending.begin(), mPending.lower_bound(start));
+
+        // Going back and forth in the file is not free, so records are read ahead in batches
+        if (mPending.size() > mMaxPending / 2)
+            return;
+
+        std::streamoff position = std::max(start, mScanned);
+        if (position != start)
+            stream.seekg(position);
+
+        RecordHeader header{};
+        while (mPending.size() < mMaxPending && position + static_cast<std::streamoff>(recHeaderSize) <= fileSize)
+        {
+            stream.read(reinterpret_cast<char*>(&header), static_cast<std::streamsize>(recHeaderSize));
+            if (stream.gcount() != static_cast<std::streamsize>(recHeaderSize))
+                break;
+
+            // Group content follows the header
+            if (header.record.typeId == REC_GRUP)
+            {
+                position += recHeaderSize;
+                continue;
+            }
+
+            const std::streamoff next = position + recHeaderSize + header.record.dataSize;
+            if (next > fileSize)
+                break;
+
+            if ((header.record.flags & Rec_Compressed) != 0 && header.record.dataSize > sizeof(std::uint32_t)
+                && mLoadedTypes.contains(header.record.typeId))
+            {
+                Task task{
+                    .mPosition = position + static_cast<std::streamoff>(recHeaderSize + sizeof(std::uint32_t)),
+                    .mUncompressedSize = 0,
+                    .mCompressed = takeBuffer(),
+                    .mResult = {},
+                };
+                task.mCompressed.resize(header.record.dataSize - sizeof(std::uint32_t));
+                stream.read(reinterpret_cast<char*>(&task.mUncompressedSize), sizeof(std::uint32_t));
+                stream.read(task.mCompressed.data(), static_cast<std::streamsize>(task.mCompressed.size()));
+                if (stream.gcount() != static_cast<std::streamsize>(task.mCompressed.size()))
+                    break;
+                mPending.emplace(task.mPosition, task.mResult.get_future());
+                {
+                    const std::lock_guard lock(mMutex);
+                    mTasks.push_back(std::move(task));
+                }
+                mHasTask.notify_one();
+            }
+            else
+            {
+                stream.ignore(header.record.dataSize);
+            }
+
+            position = next;
+        }
+
+        mScanned = position;
+
+        stream.clear();
+        stream.seekg(start);
+    }
+
+    void ReadAhead::reset()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mTasks.clear();
+        }
+        mPending.clear();
+        mLoadedTypes.clear();
+        mScanned = 0;
+    }
+
+    std::vector<char> ReadAhead::takeBuffer()
+    {
+        const std::lock_guard lock(mMutex);
+        if (mBuffers.empty())
+            return {};
+        std::vector<char> result = std::move(mBuffers.back());
+        mBuffers.pop_back();
+        return result;
+    }
+
+    void ReadAhead::run()
+    {
+        std::unique_lock lock(mMutex);
+        while (true)
+        {
+            mHasTask.wait(lock, [&] { return mShouldStop || !mTasks.empty(); });
+            if (mShouldStop)
+                return;
+
+            Task task = std::move(mTasks.front());
+            mTasks.pop_front();
+            lock.unlock();
+
+            try
+            {
+                task.mResult.set_value(decompress(task.mPosition, task.mCompressed, task.mUncompressedSize));
+            }
+            catch (...)
+            {
+                task.mResult.set_exception(std::current_exception());
+            }
+
+            lock.lock();
+            if (mBuffers.size() < mMaxPending)
+                mBuffers.push_back(std::move(task.mCompressed));
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef OPENMW_COMPONENTS_ESM4_READAHEAD_H
+#define OPENMW_COMPONENTS_ESM4_READAHEAD_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Bsa
+{
+    class MemoryInputStream;
+}
+
+namespace ESM4
+{
+    // Inflates zlib compressed record data. Position of the data in the file is used for error messages only.
+    std::unique_ptr<Bsa::MemoryInputStream> decompress(
+        std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize);
+
+    // Scans records following the current one and inflates compressed ones on worker threads, so the reader gets
+    // them already decompressed. Only types of records loaded by the reader at least once are read ahead, records of
+    // other types are usually skipped.
+    class ReadAhead
+    {
+    public:
+        explicit ReadAhead(std::size_t threads);
+
+        ~ReadAhead();
+
+        // Returns decompressed data of the record with compressed data starting at `position` or nullptr if it was
+        // not read ahead. Rethrows decompression error.
+        std::unique_ptr<Bsa::MemoryInputStream> take(std::uint32_t typeId, std::streamoff position);
+
+        // Stream should point to a group or a record header. Stream position is restored after reading.
+        void read(std::istream& stream, std::size_t recHeaderSize, std::streamoff fileSize);
+
+        // Drops records read ahead, should be called when the reader switches to another file
+        void reset();
+
+        std::size_t getPendingCount() const { return mPending.size(); }
+
+    private:
+        struct Task
+        {
+            std::streamoff mPosition;
+            std::uint32_t mUncompressedSize;
+            std::vector<char> mCompressed;
+            std::promise<std::unique_ptr<Bsa::MemoryInputStream>> mResult;
+        };
+
+        const std::size_t mMaxPending;
+        std::map<std::streamoff, std::future<std::unique_ptr<Bsa::MemoryInputStream>>> mPending;
+        std::set<std::uint32_t> mLoadedTypes;
+        std::streamoff mScanned = 0;
+        std::mutex mMutex;
+        std::condition_variable mHasTask;
+        std::deque<Task> mTasks;
+        std::vector<std::vector<char>> mBuffers;
+        bool mShouldStop = false;
+        std::vector<std::thread> mThreads;
+
+        std::vector<char> takeBuffer();
+
+        void run();
+    };
+}
+
+#endif
@@ -28,11 +28,9 @@
 #include <iomanip>
 #include <iostream>
 #include <optional>
-#include <span>
 #include <sstream>
 #include <stdexcept>
-
-#include <zlib.h>
+#include <thread>
 
 #include <components/bsa/memorystream.hpp>
 #include <components/debug/debuglog.hpp>
@@ -44,6 +42,7 @@
 #include <components/vfs/manager.hpp>
 
 #include "grouptype.hpp"
+#include "readahead.hpp"
 
 namespace ESM4
 {
@@ -52,11 +51,6 @@ namespace ESM4
         using FormId = ESM::FormId;
         using FormId32 = ESM::FormId32;
 
-        std::string getError(const std::string& header, const int errorCode, const char* msg)
-        {
-            return header + ": code " + std::to_string(errorCode) + ", " + std::string(msg != nullptr ? msg : "(null)");
-        }
-
         std::string_view getStringsSuffix(LocalizedStringType type)
         {
             switch (type)
@@ -71,92 +65,6 @@ namespace ESM4
 
             throw std::logic_error("Unsupported LocalizedStringType: " + std::to_string(static_cast<int>(type)));
         }
-
-        struct InflateEnd
-        {
-            void operator()(z_stream* stream) const { inflateEnd(stream); }
-        };
-
-        std::optional<std::string> tryDecompressAll(std::span<char> compressed, std::span<char> decompressed)
-        {
-            z_stream stream{};
-
-            stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
-            stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
-            stream.avail_in = static_cast<uInt>(compressed.size());
-            stream.avail_out = static_cast<uInt>(decompressed.size());
-
-            if (const int ec = inflateInit(&stream); ec != Z_OK)
-                return getError("inflateInit error", ec, stream.msg);
-
-            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
-
-            if (const int ec = inflate(&stream, Z_NO_FLUSH); ec != Z_STREAM_END)
-                return getError("inflate error", ec, stream.msg);
-
-            return std::nullopt;
-        }
-
-        std::optional<std::string> tryDecompressByBlock(
-            std::span<char> compressed, std::span<char> decompressed, std::size_t blockSize)
-        {
-            z_stream stream{};
-
-            if (const int ec = inflateInit(&stream); ec != Z_OK)
-                return getError("inflateInit error", ec, stream.msg);
-
-            const std::unique_ptr<z_stream, InflateEnd> streamPtr(&stream);
-
-            while (!compressed.empty() && !decompressed.empty())
-            {
-                const auto prevTotalIn = stream.total_in;
-                const auto prevTotalOut = stream.total_out;
-                stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
-                stream.avail_in = static_cast<uInt>(std::min(blockSize, compressed.size()));
-                stream.next_out = reinterpret_cast<Bytef*>(decompressed.data());
-                stream.avail_out = static_cast<uInt>(std::min(blockSize, decompressed.size()));
-                const int ec = inflate(&stream, Z_NO_FLUSH);
-                if (ec == Z_STREAM_END)
-                    break;
-                if (ec != Z_OK)
-                    return getError(
-                        "inflate error after reading " + std::to_string(stream.total_in) + " bytes", ec, stream.msg);
-                compressed = compressed.subspan(stream.total_in - prevTotalIn);
-                decompressed = decompressed.subspan(stream.total_out - prevTotalOut);
-            }
-
-            return std::nullopt;
-        }
-
-        std::unique_ptr<Bsa::MemoryInputStream> decompress(
-            std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
-        {
-            auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
-
-            const std::span decompressed(result->getRawData(), uncompressedSize);
-
-            const auto allError = tryDecompressAll(compressed, decompressed);
-            if (!allError.has_value())
-                return result;
-
-            Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
-                                << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-                                << " uncompressed size = " << uncompressedSize << ": " << *allError
-                                << ". Trying to decompress by block...";
-
-            std::memset(result->getRawData(), 0, uncompressedSize);
-
-            constexpr std::size_t blockSize = 4;
-            const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
-            if (!blockError.has_value())
-                return result;
-
-            std::ostringstream s;
-            s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
-              << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-              << " uncompressed size = " << uncompressedSize << ": " << *blockError;
-            throw std::runtime_error(s.str());
-        }
     }
 
     ReaderContext::ReaderContext()
@@ -248,9 +156,35 @@ namespace ESM4
         return getRecordHeader();
     }
 
+    bool Reader::seekRecord(std::streamoff offset)
+    {
+        if (mSavedStream)
+            mStream = std::move(mSavedStream);
+
+        mCtx.groupStack.clear();
+        mStream->clear();
+        mStream->seekg(offset);
+
+        return getRecordHeader();
+    }
+
+    std::size_t Reader::getDefaultReadAheadThreads()
+    {
+        // The reader thread parses records and inflates the ones which were not read ahead in time
+        const unsigned concurrency = std::thread::hardware_concurrency();
+        return concurrency > 1 ? std::min<std::size_t>(concurrency - 1, 4) : 0;
+    }
+
+    void Reader::setReadAheadThreads(std::size_t threads)
+    {
+        mReadAhead = threads > 0 ? std::make_unique<ReadAhead>(threads) : nullptr;
+    }
+
     void Reader::close()
     {
         mStream.reset();
+        if (mReadAhead != nullptr)
+            mReadAhead->reset();
         // clearCtx();
         // mHeader.blank();
     }
@@ -338,7 +272,11 @@ namespace ESM4
 
             if (stream != nullptr)
             {
-                buildLStringIndex(stringType, *stream);
+                // Loose files are mapped, files from archives are read as there is no way to map them
+                if (const std::optional<std::filesystem::path> fsPath = mVFS->getFilesystemPath(vfsPath))
+                    mLocalizedStrings.emplace_back(stringType, Platform::File::ScopedMapping(*fsPath));
+                else
+                    mLocalizedStrings.emplace_back(stringType, *stream);
                 return;
             }
 
@@ -362,8 +300,7 @@ namespace ESM4
 
             if (std::filesystem::exists(fsPath))
             {
-                const Files::IStreamPtr stream = Files::openConstrainedFileStream(fsPath);
-                buildLStringIndex(stringType, *stream);
+                mLocalizedStrings.emplace_back(stringType, Platform::File::ScopedMapping(fsPath));
                 return;
             }
 
@@ -372,98 +309,6 @@ namespace ESM4
         }
     }
 
-    void Reader::buildLStringIndex(LocalizedStringType stringType, std::istream& stream)
-    {
-        stream.seekg(0, std::ios::end);
-        const std::istream::pos_type fileSize = stream.tellg();
-        stream.seekg(0, std::ios::beg);
-
-        std::uint32_t numEntries = 0;
-        stream.read(reinterpret_cast<char*>(&numEntries), sizeof(numEntries));
-
-        std::uint32_t dataSize = 0;
-        stream.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
-
-        const std::istream::pos_type dataStart = fileSize - static_cast<std::istream::pos_type>(dataSize);
-
-        struct LocalizedString
-        {
-            std::uint32_t mOffset = 0;
-            std::uint32_t mStringId = 0;
-        };
-
-        std::vector<LocalizedString> strings;
-        strings.reserve(numEntries);
-
-        for (std::uint32_t i = 0; i < numEntries; ++i)
-        {
-            LocalizedString string;
-
-            stream.read(reinterpret_cast<char*>(&string.mStringId), sizeof(string.mStringId));
-            stream.read(reinterpret_cast<char*>(&string.mOffset), sizeof(string.mOffset));
-
-            strings.push_back(string);
-        }
-
-        std::sort(strings.begin(), strings.end(),
-            [](const LocalizedString& l, const LocalizedString& r) { return l.mOffset < r.mOffset; });
-
-        std::uint32_t lastOffset = 0;
-        std::string_view lastValue;
-
-        for (const LocalizedString& string : strings)
-        {
-            if (string.mOffset == lastOffset)
-            {
-                mLStringIndex.emplace(FormId::fromUint32(string.mStringId), lastValue);
-                continue;
-            }
-
-            const std::istream::pos_type offset = string.mOffset + dataStart;
-            const std::istream::pos_type pos = stream.tellg();
-            if (pos != offset)
-            {
-                char buffer[4096];
-                if (pos < offset && offset - pos < static_cast<std::istream::pos_type>(sizeof(buffer)))
-                    stream.read(buffer, offset - pos);
-                else
-                    stream.seekg(offset);
-            }
-
-            const auto it
-                = mLStringIndex.emplace(FormId::fromUint32(string.mStringId), readLocalizedString(stringType, stream))
-                      .first;
-            lastOffset = string.mOffset;
-            lastValue = it->second;
-        }
-    }
-
-    std::string Reader::readLocalizedString(LocalizedStringType type, std::istream& stream)
-    {
-        if (type == LocalizedStringType::Strings)
-        {
-            std::string data;
-
-            while (true)
-            {
-                char ch = 0;
-                stream.read(&ch, sizeof(ch));
-                if (ch == 0)
-                    break;
-                data.push_back(ch);
-            }
-
-            return data;
-        }
-
-        std::uint32_t size = 0;
-        stream.read(reinterpret_cast<char*>(&size), sizeof(size));
-
-        std::string result;
-        getStringImpl(result, size, stream, true); // expect null terminated string
-        return result;
-    }
-
     void Reader::getLocalizedString(std::string& str)
     {
         if (!hasLocalizedStrings())
@@ -475,20 +320,34 @@ namespace ESM4
             getLocalizedStringImpl(FormId::fromUint32(stringId), str);
     }
 
-    // FIXME: very messy and probably slow/inefficient
     void Reader::getLocalizedStringImpl(const FormId stringId, std::string& str)
     {
-        const auto it = mLStringIndex.find(stringId);
-
-        if (it == mLStringIndex.end())
+        for (const LocalizedStrings& strings : mLocalizedStrings)
         {
-            if (mIgnoreMissingLocalizedStrings)
+            const std::optional<std::string_view> value = strings.find(stringId.toUint32());
+            if (!value.has_value())
+                continue;
+
+            // Only strings with size prefix are encoded
+            if (mEncoder == nullptr || strings.getType() == LocalizedStringType::Strings)
+            {
+                str = *value;
                 return;
-            throw std::runtime_error("ESM4::Reader::getLocalizedString localized string not found for "
-                + ESM::RefId(stringId).toDebugString());
+            }
+
+            const std::string_view result
+                = mEncoder->getUtf8(*value, ToUTF8::BufferAllocationPolicy::FitToRequiredSize, str);
+            if (result.data() == str.data())
+                str.resize(result.size());
+            else
+                str = result;
+            return;
         }
 
-        str = it->second;
+        if (mIgnoreMissingLocalizedStrings)
+            return;
+        throw std::runtime_error(
+            "ESM4::Reader::getLocalizedString localized string not found for " + ESM::RefId(stringId).toDebugString());
     }
 
     bool Reader::getRecordHeader()
@@ -534,14 +393,26 @@ namespace ESM4
             const std::streamoff position = mStream->tellg();
 
             const std::uint32_t recordSize = mCtx.recordHeader.record.dataSize - sizeof(std::uint32_t);
-            std::vector<char> compressed(recordSize);
-            mStream->read(compressed.data(), recordSize);
+            std::unique_ptr<Bsa::MemoryInputStream> memoryStreamPtr;
+            if (mReadAhead != nullptr)
+                memoryStreamPtr = mReadAhead->take(mCtx.recordHeader.record.typeId, position);
+            if (memoryStreamPtr != nullptr)
+            {
+                // Already read by ReadAhead, so there is no need to copy the data
+                mStream->seekg(recordSize, std::ios_base::cur);
+            }
+            else
+            {
+                std::vector<char> compressed(recordSize);
+                mStream->read(compressed.data(), recordSize);
+                memoryStreamPtr = decompress(position, compressed, uncompressedSize);
+            }
+            if (mReadAhead != nullptr)
+                mReadAhead->read(*mStream, mCtx.recHeaderSize, static_cast<std::streamoff>(mFileSize));
             mSavedStream = std::move(mStream);
 
             mCtx.recordHeader.record.dataSize = uncompressedSize - sizeof(uncompressedSize);
 
-            auto memoryStreamPtr = decompress(position, compressed, uncompressedSize);
-
             // For debugging only
             // #if 0
             if (dump)
@@ -29,10 +29,12 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "cellgrid.hpp"
 #include "common.hpp"
 #include "loadtes4.hpp"
+#include "localizedstrings.hpp"
 
 #include <components/esm/formid.hpp>
 #include <components/files/istreamptr.hpp>
@@ -49,6 +51,8 @@ namespace VFS
 
 namespace ESM4
 {
+    class ReadAhead;
+
 #pragma pack(push, 1)
     // NOTE: the label field of a group is not reliable (http://www.uesp.net/wiki/Tes4Mod:Mod_File_Format)
     union GroupLabel
@@ -136,13 +140,6 @@ namespace ESM4
         ReaderContext();
     };
 
-    enum class LocalizedStringType
-    {
-        Strings,
-        ILStrings,
-        DLStrings,
-    };
-
     class Reader
     {
         VFS::Manager const* mVFS;
@@ -157,11 +154,13 @@ namespace ESM4
         Files::IStreamPtr mStream;
         Files::IStreamPtr mSavedStream; // mStream is saved here while using deflated memory stream
 
+        std::unique_ptr<ReadAhead> mReadAhead;
+
         Files::IStreamPtr mStrings;
         Files::IStreamPtr mILStrings;
         Files::IStreamPtr mDLStrings;
 
-        std::unordered_map<ESM::FormId, std::string> mLStringIndex;
+        std::vector<LocalizedStrings> mLocalizedStrings;
 
         std::vector<Reader*>* mGlobalReaderList = nullptr;
 
@@ -169,10 +168,6 @@ namespace ESM4
 
         void buildLStringIndex(LocalizedStringType stringType, std::string_view prefix);
 
-        void buildLStringIndex(LocalizedStringType stringType, std::istream& stream);
-
-        std::string readLocalizedString(LocalizedStringType type, std::istream& stream);
-
         inline bool hasLocalizedStrings() const { return (mHeader.mFlags & Rec_Localized) != 0; }
 
         void getLocalizedStringImpl(const ESM::FormId stringId, std::string& str);
@@ -198,6 +193,13 @@ namespace ESM4
 
         ~Reader();
 
+        // Returns the number of threads used by default to inflate compressed records ahead of the reader
+        static std::size_t getDefaultReadAheadThreads();
+
+        // Reading ahead is off until this is called, records are inflated by the reader thread when they are loaded.
+        // Zero disables it.
+        void setReadAheadThreads(std::size_t threads);
+
         void open(const std::filesystem::path& filename);
 
         void close();
@@ -224,6 +226,16 @@ namespace ESM4
 
         bool restoreContext(const ReaderContext& ctx); // returns the result of re-reading the header
 
+        // WARN: must be called immediately after reading the record header
+        inline std::streamoff getRecordOffset() const
+        {
+            return static_cast<std::streamoff>(getFileOffset() - mCtx.recHeaderSize);
+        }
+
+        // Re-reads the header of a record at the offset returned by getRecordOffset. Unlike restoreContext the group
+        // stack is not restored, so the record can be loaded but the reader should not be used to continue iterating.
+        bool seekRecord(std::streamoff offset); // returns the result of re-reading the header
+
         template <typename T>
         inline void get(T& t)
         {
@@ -0,0 +1,30 @@
+#ifndef OPENMW_COMPONENTS_INTERPRETER_DECODEDPROGRAM_H
+#define OPENMW_COMPONENTS_INTERPRETER_DECODEDPROGRAM_H
+
+#include "types.hpp"
+
+#include <vector>
+
+namespace Interpreter
+{
+    class Opcode0;
+    class Opcode1;
+
+    /// Instructions of a Program resolved to the opcodes installed in an Interpreter, so running it does not need
+    /// to unpack and look up every instruction. Only valid for the Interpreter that decoded it.
+    struct DecodedProgram
+    {
+        struct Instruction
+        {
+            Opcode1* mOpcode1 = nullptr;
+            Opcode0* mOpcode0 = nullptr;
+            unsigned int mArg0 = 0;
+            // Original instruction, used to report unknown opcodes
+            Type_Code mCode = 0;
+        };
+
+        std::vector<Instruction> mInstructions;
+    };
+}
+
+#endif
@@ -24,15 +24,41 @@ namespace Interpreter
             throw std::runtime_error(error);
         }
 
-        template <typename T>
-        auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+        struct UnpackedCode
         {
-            auto it = segment.find(opcode);
-            if (it == segment.end())
+            // -1 if the code doesn't belong to any segment
+            int mSegment = -1;
+            int mOpcode = 0;
+            unsigned int mArg0 = 0;
+        };
+
+        UnpackedCode unpack(Type_Code code)
+        {
+            switch (code >> 30)
+            {
+                case 0:
+                    return UnpackedCode{ 0, static_cast<int>(code >> 24), code & 0xffffff };
+                case 2:
+                    return UnpackedCode{ 2, static_cast<int>((code >> 20) & 0x3ff), code & 0xfffff };
+            }
+
+            switch (code >> 26)
             {
-                abortUnknownCode(seg, opcode);
+                case 0x30:
+                    return UnpackedCode{ 3, static_cast<int>((code >> 8) & 0x3ffff), code & 0xff };
+                case 0x32:
+                    return UnpackedCode{ 5, static_cast<int>(code & 0x3ffffff), 0 };
             }
-            return it->second;
+
+            return UnpackedCode{};
+        }
+
+        [[noreturn]] void abortInvalidCode(Type_Code code)
+        {
+            const UnpackedCode unpacked = unpack(code);
+            if (unpacked.mSegment < 0)
+                abortUnknownSegment(code);
+            abortUnknownCode(unpacked.mSegment, unpacked.mOpcode);
         }
     }
 
@@ -42,50 +68,47 @@ namespace Interpreter
             std::format("Duplicated interpreter instruction code in segment {}: {:#x}", name, code));
     }
 
-    void Interpreter::execute(Type_Code code)
+    DecodedProgram::Instruction Interpreter::decode(Type_Code code) const
     {
-        unsigned int segSpec = code >> 30;
+        const UnpackedCode unpacked = unpack(code);
+
+        DecodedProgram::Instruction result;
+        result.mArg0 = unpacked.mArg0;
+        result.mCode = code;
 
-        switch (segSpec)
+        switch (unpacked.mSegment)
         {
             case 0:
-            {
-                const int opcode = code >> 24;
-                const unsigned int arg0 = code & 0xffffff;
-
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
-            }
-
+                result.mOpcode1 = mSegment0.find(unpacked.mOpcode);
+                break;
             case 2:
-            {
-                const int opcode = (code >> 20) & 0x3ff;
-                const unsigned int arg0 = code & 0xfffff;
-
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
-            }
+                result.mOpcode1 = mSegment2.find(unpacked.mOpcode);
+                break;
+            case 3:
+                result.mOpcode1 = mSegment3.find(unpacked.mOpcode);
+                break;
+            case 5:
+                result.mOpcode0 = mSegment5.find(unpacked.mOpcode);
+                break;
         }
 
-        segSpec = code >> 26;
-
-        switch (segSpec)
-        {
-            case 0x30:
-            {
-                const int opcode = (code >> 8) & 0x3ffff;
-                const unsigned int arg0 = code & 0xff;
+        return result;
+    }
 
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
-            }
+    void Interpreter::execute(Type_Code code)
+    {
+        execute(decode(code));
+    }
 
-            case 0x32:
-            {
-                const int opcode = code & 0x3ffffff;
+    void Interpreter::execute(const DecodedProgram::Instruction& instruction)
+    {
+        if (instruction.mOpcode1 != nullptr)
+            return instruction.mOpcode1->execute(mRuntime, instruction.mArg0);
 
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
-            }
-        }
+        if (instruction.mOpcode0 != nullptr)
+            return instruction.mOpcode0->execute(mRuntime);
 
-        abortUnknownSegment(code);
+        abortInvalidCode(instruction.mCode);
     }
 
     void Interpreter::begin()
@@ -115,7 +138,8 @@ namespace Interpreter
         }
     }
 
-    void Interpreter::run(const Program& program, Context& context)
+    template <typename T>
+    void Interpreter::run(const Program& program, const std::vector<T>& instructions, Context& context)
     {
         begin();
 
@@ -123,9 +147,9 @@ namespace Interpreter
         {
             mRuntime.configure(program, context);
 
-            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < program.mInstructions.size())
+            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < instructions.size())
             {
-                const Type_Code instruction = program.mInstructions[mRuntime.getPC()];
+                const T& instruction = instructions[mRuntime.getPC()];
                 mRuntime.setPC(mRuntime.getPC() + 1);
                 execute(instruction);
             }
@@ -138,4 +162,24 @@ namespace Interpreter
 
         end();
     }
+
+    void Interpreter::run(const Program& program, Context& context)
+    {
+        run(program, program.mInstructions, context);
+    }
+
+    DecodedProgram Interpreter::decode(const Program& program) const
+    {
+        DecodedProgram result;
+        result.mInstructions.reserve(program.mInstructions.size());
+        for (const Type_Code code : program.mInstructions)
+            result.mInstructions.push_back(decode(code));
+        return result;
+    }
+
+    void Interpreter::run(const Program& program, const DecodedProgram& decoded, Context& context)
+    {
+        assert(program.mInstructions.size() == decoded.mInstructions.size());
+        run(program, decoded.mInstructions, context);
+    }
 }
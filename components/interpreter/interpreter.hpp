@@ -1,11 +1,15 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <stack>
 #include <utility>
+#include <vector>
 
+#include "decodedprogram.hpp"
 #include "opcodes.hpp"
 #include "runtime.hpp"
 #include "types.hpp"
@@ -14,18 +18,99 @@ namespace Interpreter
 {
     struct Program;
 
+    /// Opcodes of a segment in tables directly indexed by the opcode. Installed opcodes are clustered in a few
+    /// ranges (e.g. generic and engine specific ones), each of them gets its own table.
+    template <typename T>
+    class OpcodeTable
+    {
+        // Opcodes closer than this to an existing table extend it instead of starting a new one.
+        static constexpr int sMaxGap = 256;
+
+        struct Range
+        {
+            int mFirstCode;
+            std::vector<std::unique_ptr<T>> mOpcodes;
+        };
+
+        std::vector<Range> mRanges;
+
+    public:
+        T* find(int code) const
+        {
+            for (const Range& range : mRanges)
+            {
+                const std::size_t index = static_cast<unsigned int>(code - range.mFirstCode);
+                if (index < range.mOpcodes.size())
+                    return range.mOpcodes[index].get();
+            }
+            return nullptr;
+        }
+
+        /// @return false if there is an opcode with this code already
+        bool insert(int code, std::unique_ptr<T>&& opcode)
+        {
+            for (Range& range : mRanges)
+            {
+                const std::size_t index = static_cast<unsigned int>(code - range.mFirstCode);
+                if (index < range.mOpcodes.size())
+                {
+                    if (range.mOpcodes[index] != nullptr)
+                        return false;
+                    range.mOpcodes[index] = std::move(opcode);
+                    return true;
+                }
+            }
+            // Ranges are sorted and don't overlap, so the code may only extend a range if it is before the next one
+            // or after the previous one.
+            for (std::size_t i = 0; i < mRanges.size(); ++i)
+            {
+                Range& range = mRanges[i];
+                const int end = range.mFirstCode + static_cast<int>(range.mOpcodes.size());
+                if (code >= end && code - end < sMaxGap
+                    && (i + 1 == mRanges.size() || code < mRanges[i + 1].mFirstCode))
+                {
+                    range.mOpcodes.resize(static_cast<std::size_t>(code - range.mFirstCode + 1));
+                    range.mOpcodes.back() = std::move(opcode);
+                    return true;
+                }
+                if (code < range.mFirstCode && range.mFirstCode - code < sMaxGap)
+                {
+                    std::vector<std::unique_ptr<T>> opcodes(static_cast<std::size_t>(range.mFirstCode - code));
+                    opcodes.front() = std::move(opcode);
+                    std::move(range.mOpcodes.begin(), range.mOpcodes.end(), std::back_inserter(opcodes));
+                    range.mOpcodes = std::move(opcodes);
+                    range.mFirstCode = code;
+                    return true;
+                }
+            }
+            Range range{ code, {} };
+            range.mOpcodes.push_back(std::move(opcode));
+            const auto it = std::upper_bound(mRanges.begin(), mRanges.end(), code,
+                [](int value, const Range& range) { return value < range.mFirstCode; });
+            mRanges.insert(it, std::move(range));
+            return true;
+        }
+    };
+
     class Interpreter
     {
         std::stack<Runtime> mCallstack;
         bool mRunning = false;
         Runtime mRuntime;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-        std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        OpcodeTable<Opcode1> mSegment0;
+        OpcodeTable<Opcode1> mSegment2;
+        OpcodeTable<Opcode1> mSegment3;
+        OpcodeTable<Opcode0> mSegment5;
+
+        DecodedProgram::Instruction decode(Type_Code code) const;
 
         void execute(Type_Code code);
 
+        void execute(const DecodedProgram::Instruction& instruction);
+
+        template <typename T>
+        void run(const Program& program, const std::vector<T>& instructions, Context& context);
+
         void begin();
 
         void end();
@@ -35,9 +120,8 @@ namespace Interpreter
         template <typename T, typename... Args>
         void installSegment(auto& segment, std::string_view name, int code, Args&&... args)
         {
-            if (segment.find(code) != segment.end())
+            if (!segment.insert(code, std::make_unique<T>(std::forward<Args>(args)...)))
                 abortDuplicateInstruction(name, code);
-            segment.emplace(code, std::make_unique<T>(std::forward<Args>(args)...));
         }
 
     public:
@@ -71,6 +155,12 @@ namespace Interpreter
         }
 
         void run(const Program& program, Context& context);
+
+        /// Resolve the instructions of the program to the installed opcodes.
+        DecodedProgram decode(const Program& program) const;
+
+        /// Run the program using its instructions decoded by this interpreter.
+        void run(const Program& program, const DecodedProgram& decoded, Context& context);
     };
 }
 
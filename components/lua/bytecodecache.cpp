@@ -0,0 +1,225 @@
+#include "bytecodecache.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+#include <smhasher/MurmurHash3.h>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/version/version.hpp>
+
+#include "luastate.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        constexpr std::string_view magic = "OMWLUABC";
+        constexpr std::uint32_t formatVersion = 2;
+
+        using Hash = std::array<std::uint64_t, 2>;
+
+        Hash getHash(std::string_view value)
+        {
+            Hash seed{ 0, 0 };
+            Hash result{ 0, 0 };
+            MurmurHash3_x64_128(value.data(), static_cast<int>(value.size()), seed.data(), result.data());
+            return result;
+        }
+
+        // Bytecode can be loaded only by the same Lua build with the same number and pointer types. Entries of other
+        // engine builds are ignored too because the Lua build or the internal libraries might differ.
+        std::string getBuildId()
+        {
+            std::ostringstream result;
+            result << Version::getVersion() << ' ' << Version::getCommitHash() << ' ' << getLuaVersion() << ' '
+                   << LUA_VERSION_NUM << ' ' << sizeof(void*) * 8 << "-bit " << sizeof(lua_Number) << '-'
+                   << sizeof(lua_Integer);
+            return result.str();
+        }
+
+        template <class T>
+        void writeValue(std::string& out, T value)
+        {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeString(std::string& out, std::string_view value)
+        {
+            writeValue(out, static_cast<std::uint64_t>(value.size()));
+            out.append(value);
+        }
+
+        class EntryReader
+        {
+        public:
+            explicit EntryReader(std::string_view data)
+                : mData(data)
+            {
+            }
+
+            template <class T>
+            bool readValue(T& value)
+            {
+                if (mData.size() < sizeof(value))
+                    return false;
+                std::memcpy(&value, mData.data(), sizeof(value));
+                mData.remove_prefix(sizeof(value));
+                return true;
+            }
+
+            bool readString(std::string_view& value)
+            {
+                std::uint64_t size = 0;
+                if (!readValue(size) || mData.size() < size)
+                    return false;
+                value = mData.substr(0, static_cast<std::size_t>(size));
+                mData.remove_prefix(static_cast<std::size_t>(size));
+                return true;
+            }
+
+            bool readMagic()
+            {
+                if (!mData.starts_with(magic))
+                    return false;
+                mData.remove_prefix(magic.size());
+                return true;
+            }
+
+            bool atEnd() const { return mData.empty(); }
+
+        private:
+            std::string_view mData;
+        };
+    }
+
+    BytecodeCache::BytecodeCache(std::filesystem::path dir)
+        : mDir(std::move(dir))
+        , mBuildId(getBuildId())
+    {
+    }
+
+    std::filesystem::path BytecodeCache::getEntryPath(std::string_view scriptPath) const
+    {
+        const Hash hash = getHash(scriptPath);
+        std::ostringstream name;
+        name << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1] << ".luac";
+        return mDir / name.str();
+    }
+
+    std::optional<std::string> BytecodeCache::get(
+        std::string_view scriptPath, std::filesystem::file_time_type sourceTime) const
+    {
+        const std::filesystem::path path = getEntryPath(scriptPath);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        const std::string data(std::istreambuf_iterator<char>(stream), {});
+        const bool failed = stream.bad();
+        stream.close();
+
+        EntryReader reader(data);
+        std::uint32_t version = 0;
+        std::string_view buildId;
+        std::string_view entryScriptPath;
+        std::int64_t entrySourceTime = 0;
+        Hash checksum{ 0, 0 };
+        std::string_view bytecode;
+        if (failed || !reader.readMagic() || !reader.readValue(version) || version != formatVersion
+            || !reader.readString(buildId) || !reader.readString(entryScriptPath) || !reader.readValue(entrySourceTime)
+            || !reader.readValue(checksum[0]) || !reader.readValue(checksum[1]) || !reader.readString(bytecode)
+            || !reader.atEnd() || getHash(bytecode) != checksum)
+        {
+            // Unreadable or corrupted entry
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            return std::nullopt;
+        }
+
+        // Stale entries are overwritten after the script is compiled
+        if (buildId != mBuildId || entryScriptPath != scriptPath
+            || entrySourceTime != sourceTime.time_since_epoch().count())
+            return std::nullopt;
+
+        return std::string(bytecode);
+    }
+
+    void BytecodeCache::put(
+        std::string_view scriptPath, std::filesystem::file_time_type sourceTime, std::string_view bytecode) const
+    {
+        const Hash checksum = getHash(bytecode);
+        std::string data(magic);
+        writeValue(data, formatVersion);
+        writeString(data, mBuildId);
+        writeString(data, scriptPath);
+        writeValue(data, static_cast<std::int64_t>(sourceTime.time_since_epoch().count()));
+        writeValue(data, checksum[0]);
+        writeValue(data, checksum[1]);
+        writeString(data, bytecode);
+
+        const std::filesystem::path path = getEntryPath(scriptPath);
+        // Several Lua states may compile the same script at the same time, so every writer uses its own temporary
+        // file and the complete entry replaces the old one atomically.
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        std::error_code ec;
+        std::filesystem::create_directories(mDir, ec);
+        {
+            std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            stream.close();
+            if (stream.fail())
+            {
+                Log(Debug::Warning) << "Failed to write Lua bytecode cache entry "
+                                    << Files::pathToUnicodeString(tmpPath) << " for " << scriptPath;
+                std::filesystem::remove(tmpPath, ec);
+                return;
+            }
+        }
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to write Lua bytecode cache entry " << Files::pathToUnicodeString(path)
+                                << " for " << scriptPath << ": " << ec.message();
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+
+    void BytecodeCache::remove(std::string_view scriptPath) const
+    {
+        std::error_code ec;
+        std::filesystem::remove(getEntryPath(scriptPath), ec);
+    }
+
+    void BytecodeCache::recordLoad(bool hit, double time)
+    {
+        if (hit)
+        {
+            ++mHits;
+            mHitLoadTime += time;
+        }
+        else
+        {
+            ++mMisses;
+            mMissLoadTime += time;
+        }
+    }
+
+    BytecodeCache::Stats BytecodeCache::getStats() const
+    {
+        return Stats{
+            .mHits = mHits,
+            .mMisses = mMisses,
+            .mHitLoadTime = mHitLoadTime,
+            .mMissLoadTime = mMissLoadTime,
+        };
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef COMPONENTS_LUA_BYTECODECACHE_H
+#define COMPONENTS_LUA_BYTECODECACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace LuaUtil
+{
+    // On-disk cache of compiled Lua scripts. There is a file per script named by a hash of the script path. An entry
+    // is valid only for the same script path, source modification time, engine build and Lua ABI, so modified scripts
+    // and updates invalidate entries automatically. The cache directory is writable by the user, so the bytecode is
+    // checked against the checksum stored in the entry and unreadable entries are removed. Entries are read only when
+    // a script is loaded. Can be used from several threads.
+    class BytecodeCache
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t mHits = 0;
+            std::uint64_t mMisses = 0;
+            double mHitLoadTime = 0; // seconds spent to load scripts found in the cache
+            double mMissLoadTime = 0; // seconds spent to compile scripts missing in the cache
+        };
+
+        explicit BytecodeCache(std::filesystem::path dir);
+
+        std::optional<std::string> get(std::string_view scriptPath, std::filesystem::file_time_type sourceTime) const;
+
+        // Failures are logged and ignored, the script will be compiled again next time.
+        void put(std::string_view scriptPath, std::filesystem::file_time_type sourceTime,
+            std::string_view bytecode) const;
+
+        // Removes the entry which bytecode could not be loaded.
+        void remove(std::string_view scriptPath) const;
+
+        void recordLoad(bool hit, double time);
+
+        Stats getStats() const;
+
+    private:
+        const std::filesystem::path mDir;
+        const std::string mBuildId;
+        std::atomic<std::uint64_t> mHits{ 0 };
+        std::atomic<std::uint64_t> mMisses{ 0 };
+        std::atomic<double> mHitLoadTime{ 0 };
+        std::atomic<double> mMissLoadTime{ 0 };
+
+        std::filesystem::path getEntryPath(std::string_view scriptPath) const;
+    };
+}
+
+#endif // COMPONENTS_LUA_BYTECODECACHE_H
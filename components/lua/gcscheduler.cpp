@@ -0,0 +1,86 @@
+#include "gcscheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <sol/state.hpp>
+
+namespace LuaUtil
+{
+    namespace
+    {
+        // Small states are not collected more often than once per this growth
+        constexpr std::uint64_t minCycleGrowth = 1024 * 1024;
+
+        std::uint64_t getMemoryUsage(lua_State* state)
+        {
+            return static_cast<std::uint64_t>(lua_gc(state, LUA_GCCOUNT, 0)) * 1024
+                + static_cast<std::uint64_t>(lua_gc(state, LUA_GCCOUNTB, 0));
+        }
+    }
+
+    void FrameTimeStats::add(double time)
+    {
+        if (mTimes.size() < mCapacity)
+            mTimes.push_back(time);
+        else
+            mTimes[mNext] = time;
+        mNext = (mNext + 1) % mCapacity;
+    }
+
+    double FrameTimeStats::getPercentile(double fraction) const
+    {
+        if (mTimes.empty())
+            return 0;
+        std::vector<double> times = mTimes;
+        const auto index = static_cast<std::size_t>(std::clamp(fraction, 0.0, 1.0) * (times.size() - 1) + 0.5);
+        std::nth_element(times.begin(), times.begin() + index, times.end());
+        return times[index];
+    }
+
+    void GcScheduler::update(lua_State* state, double budget, int steps)
+    {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+
+        if (budget <= 0)
+        {
+            if (mManual)
+            {
+                lua_gc(state, LUA_GCRESTART, 0);
+                mManual = false;
+            }
+            if (steps > 0)
+                lua_gc(state, LUA_GCSTEP, steps);
+        }
+        else
+        {
+            mManual = true;
+            const std::uint64_t memory = getMemoryUsage(state);
+            if (!mInCycle && memory >= std::max(mMemoryAfterCycle * 2, mMemoryAfterCycle + minCycleGrowth))
+                mInCycle = true;
+            if (mInCycle)
+            {
+                const bool overdue = memory >= std::max(mMemoryAfterCycle * 4, mMemoryAfterCycle + minCycleGrowth * 4);
+                const Clock::time_point deadline
+                    = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(budget));
+                do
+                {
+                    // Zero size means the smallest step
+                    if (lua_gc(state, LUA_GCSTEP, 0) != 0)
+                    {
+                        mInCycle = false;
+                        mMemoryAfterCycle = getMemoryUsage(state);
+                        ++mCycles;
+                        break;
+                    }
+                } while (overdue || Clock::now() < deadline);
+            }
+            // A step in Lua 5.1 and LuaJIT sets a new threshold for automatic collection, so it has to be stopped
+            // again every time
+            lua_gc(state, LUA_GCSTOP, 0);
+        }
+
+        mFrameTimeStats.add(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+}
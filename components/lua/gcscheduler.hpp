@@ -0,0 +1,59 @@
+#ifndef COMPONENTS_LUA_GCSCHEDULER_H
+#define COMPONENTS_LUA_GCSCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct lua_State;
+
+namespace LuaUtil
+{
+    // Durations of the last frames, used to report percentiles.
+    class FrameTimeStats
+    {
+    public:
+        explicit FrameTimeStats(std::size_t frames = 1000)
+            : mCapacity(frames)
+        {
+        }
+
+        void add(double time);
+
+        std::size_t size() const { return mTimes.size(); }
+
+        // `fraction` is in [0, 1], e.g. 0.99 for the 99th percentile. Returns 0 if there are no frames.
+        double getPercentile(double fraction) const;
+
+    private:
+        std::size_t mCapacity;
+        std::size_t mNext = 0;
+        std::vector<double> mTimes;
+    };
+
+    // Runs the Lua garbage collector within a time budget per frame. While a budget is set, automatic collection is
+    // stopped, because it is triggered by arbitrary allocations and a single automatic step is not limited in time.
+    // A new cycle starts when memory usage doubles since the end of the previous one, like with the default Lua
+    // settings. If the budget is too small to keep up with allocations and memory usage grows four times, the cycle
+    // is finished regardless of the budget.
+    class GcScheduler
+    {
+    public:
+        // `budget` is in seconds. Zero budget restores automatic collection and performs `steps` as a single
+        // LUA_GCSTEP call instead.
+        void update(lua_State* state, double budget, int steps);
+
+        const FrameTimeStats& getFrameTimeStats() const { return mFrameTimeStats; }
+
+        std::uint64_t getCycles() const { return mCycles; }
+
+    private:
+        bool mManual = false;
+        bool mInCycle = false;
+        std::uint64_t mMemoryAfterCycle = 0;
+        std::uint64_t mCycles = 0;
+        FrameTimeStats mFrameTimeStats;
+    };
+}
+
+#endif // COMPONENTS_LUA_GCSCHEDULER_H
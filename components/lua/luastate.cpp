@@ -4,6 +4,7 @@
 #include <luajit.h>
 #endif // NO_LUAJIT
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 
@@ -11,6 +12,7 @@
 #include <components/files/conversion.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "bytecodecache.hpp"
 #include "luastateptr.hpp"
 #include "scriptscontainer.hpp"
 #include "utf8.hpp"
@@ -71,6 +73,8 @@ namespace LuaUtil
             return;
         const ScriptId& activeScript = self->mActiveScriptIdStack.back();
         activeScript.mContainer->addInstructionCount(activeScript.mIndex, countHookStep);
+        if (self->mProfiler.isActive())
+            self->mProfiler.sample(state, activeScript.mIndex, self->mConf);
         self->mWatchdogInstructionCounter += countHookStep;
         if (self->mSettings.mInstructionLimit > 0
             && self->mWatchdogInstructionCounter > self->mSettings.mInstructionLimit)
@@ -89,7 +93,11 @@ namespace LuaUtil
         const uint64_t memoryLimit = self->mSettings.mMemoryLimit;
 
         if (!ptr)
+        {
             osize = 0;
+            if (nsize > 0)
+                self->mProfiler.countAllocation();
+        }
         int64_t smallAllocDelta = 0, bigAllocDelta = 0;
         if (osize <= smallAllocSize)
             smallAllocDelta -= osize;
@@ -413,9 +421,37 @@ namespace LuaUtil
                 throw std::runtime_error("Lua error: " + res.get<std::string>());
             return res;
         }
-        sol::function res = loadFromVFS(path);
-        mCompiledScripts[path] = res.dump();
-        return res;
+        BytecodeCache* const diskCache = mSettings.mBytecodeCache.get();
+        if (diskCache == nullptr)
+        {
+            sol::function res = loadFromVFS(path);
+            mCompiledScripts[path] = res.dump();
+            return res;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto getLoadTime
+            = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+        // The source is read only if there is no valid entry
+        const std::filesystem::file_time_type sourceTime = mVFS->getLastModified(path);
+        if (const std::optional<std::string> cached = diskCache->get(path.value(), sourceTime))
+        {
+            sol::load_result res = mSol.load(*cached, path.value(), sol::load_mode::binary);
+            if (res.valid())
+            {
+                const auto* const data = reinterpret_cast<const std::byte*>(cached->data());
+                mCompiledScripts[path] = sol::bytecode(data, data + cached->size());
+                diskCache->recordLoad(true, getLoadTime());
+                return res;
+            }
+            // The entry matches the build but can't be loaded, it is compiled again
+            diskCache->remove(path.value());
+        }
+        sol::function fn = loadFromVFS(path);
+        const sol::bytecode& bytecode = mCompiledScripts[path] = fn.dump();
+        diskCache->put(path.value(), sourceTime, bytecode.as_string_view());
+        diskCache->recordLoad(false, getLoadTime());
+        return fn;
     }
 
     sol::function LuaState::loadFromVFS(const VFS::Path::Normalized& path)
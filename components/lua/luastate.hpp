@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <typeinfo>
 
 #include <sol/sol.hpp>
@@ -11,6 +12,7 @@
 
 #include "configuration.hpp"
 #include "luastateptr.hpp"
+#include "profiler.hpp"
 
 namespace VFS
 {
@@ -22,6 +24,7 @@ namespace LuaUtil
 
     std::string getLuaVersion();
 
+    class BytecodeCache;
     class ScriptsContainer;
     struct ScriptId
     {
@@ -35,6 +38,7 @@ namespace LuaUtil
         uint64_t mMemoryLimit = 0; // 0 is unlimited
         uint64_t mSmallAllocMaxSize = 1024 * 1024; // big default value efficiently disables memory tracking
         bool mLogMemoryUsage = false;
+        std::shared_ptr<BytecodeCache> mBytecodeCache; // compiled scripts are not saved to disk if not set
     };
 
     class LuaState;
@@ -179,6 +183,10 @@ namespace LuaUtil
 
         const LuaStateSettings& getSettings() const { return mSettings; }
 
+        // Detailed profiler of handlers and call stacks. Works only if the Lua profiler is enabled.
+        Profiler& getProfiler() { return mProfiler; }
+        const Profiler& getProfiler() const { return mProfiler; }
+
         // Note: Lua profiler can not be re-enabled after disabling.
         static void disableProfiler() { sProfilerEnabled = false; }
         static bool isProfilerEnabled() { return sProfilerEnabled; }
@@ -213,6 +221,7 @@ namespace LuaUtil
         uint64_t mTotalMemoryUsage = 0;
         uint64_t mSmallAllocMemoryUsage = 0;
         std::vector<int64_t> mMemoryUsage;
+        Profiler mProfiler;
 
         // Must be declared before mSol and all sol-related objects. Then on exit it will be destructed the last.
         LuaStatePtr mLuaState;
@@ -0,0 +1,126 @@
+#include "profiler.hpp"
+
+#include <sol/state.hpp>
+
+#include <ostream>
+#include <utility>
+
+#include "configuration.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        // Limits the cost of a single sample in deeply recursive code
+        constexpr int maxStackDepth = 64;
+
+        void appendScriptName(std::string& out, int scriptIndex, const ScriptsConfiguration* conf)
+        {
+            if (conf != nullptr && scriptIndex >= 0 && static_cast<std::size_t>(scriptIndex) < conf->size())
+                out += (*conf)[scriptIndex].mScriptPath.value();
+            else
+                out += "script#" + std::to_string(scriptIndex);
+        }
+
+        void appendFunctionName(std::string& out, const lua_Debug& ar)
+        {
+            out += ar.name != nullptr ? ar.name : "?";
+            if (ar.what != nullptr && std::string_view(ar.what) == "C")
+            {
+                out += " [C]";
+                return;
+            }
+            out += " (";
+            out += ar.short_src;
+            out += ':';
+            out += std::to_string(ar.linedefined);
+            out += ')';
+        }
+    }
+
+    void Profiler::setActive(bool value)
+    {
+        mActive = value;
+        if (value)
+            return;
+        mFrames.clear();
+        mWindowStats.clear();
+        mLastWindowStats.clear();
+        mLastWindowDuration = 0;
+        mStacks.clear();
+    }
+
+    void Profiler::enter(int scriptIndex, std::string_view handler)
+    {
+        mFrames.push_back(Frame{
+            .mScriptIndex = scriptIndex,
+            .mHandler = handler,
+            .mStart = Clock::now(),
+            .mAllocations = mAllocations,
+        });
+    }
+
+    void Profiler::leave()
+    {
+        if (mFrames.empty())
+            return;
+        const Frame& frame = mFrames.back();
+        auto& handlers = mWindowStats[frame.mScriptIndex];
+        auto it = handlers.find(frame.mHandler);
+        if (it == handlers.end())
+            it = handlers.emplace(std::string(frame.mHandler), HandlerStats{}).first;
+        it->second.mTime += std::chrono::duration<double>(Clock::now() - frame.mStart).count();
+        it->second.mCalls += 1;
+        it->second.mAllocations += mAllocations - frame.mAllocations;
+        mFrames.pop_back();
+    }
+
+    void Profiler::sample(lua_State* state, int scriptIndex, const ScriptsConfiguration* conf)
+    {
+        mStackBuffer.clear();
+        appendScriptName(mStackBuffer, scriptIndex, conf);
+        mStackBuffer += ';';
+        if (!mFrames.empty() && mFrames.back().mScriptIndex == scriptIndex)
+            mStackBuffer += mFrames.back().mHandler;
+        else
+            mStackBuffer += "[other]";
+
+        lua_Debug ar;
+        int depth = 0;
+        while (depth < maxStackDepth && lua_getstack(state, depth, &ar) != 0)
+            ++depth;
+        // Level 0 is the running function, so the root of the stack has the highest level
+        for (int level = depth - 1; level >= 0; --level)
+        {
+            if (lua_getstack(state, level, &ar) == 0 || lua_getinfo(state, "Sn", &ar) == 0)
+                continue;
+            mStackBuffer += ';';
+            appendFunctionName(mStackBuffer, ar);
+        }
+
+        auto it = mStacks.find(mStackBuffer);
+        if (it == mStacks.end())
+            mStacks.emplace(mStackBuffer, 1);
+        else
+            it->second += 1;
+    }
+
+    void Profiler::nextWindow(double duration)
+    {
+        mLastWindowStats.clear();
+        std::swap(mLastWindowStats, mWindowStats);
+        mLastWindowDuration = duration;
+    }
+
+    void Profiler::collectStacks(std::map<std::string, std::uint64_t>& out) const
+    {
+        for (const auto& [stack, samples] : mStacks)
+            out[stack] += samples;
+    }
+
+    void writeCollapsedStacks(const std::map<std::string, std::uint64_t>& stacks, std::ostream& stream)
+    {
+        for (const auto& [stack, samples] : stacks)
+            stream << stack << ' ' << samples << '\n';
+    }
+}
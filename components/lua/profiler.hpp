@@ -0,0 +1,111 @@
+#ifndef COMPONENTS_LUA_PROFILER_H
+#define COMPONENTS_LUA_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct lua_State;
+
+namespace LuaUtil
+{
+    class ScriptsConfiguration;
+
+    // Detailed profiler of a single Lua state. While active it records wall time, number of calls and number of
+    // allocations for every handler of every script, and samples Lua call stacks from the instruction count hook.
+    // Handler stats are aggregated over a window that is switched by `nextWindow`, call stacks are accumulated
+    // until the profiler is deactivated.
+    class Profiler
+    {
+    public:
+        struct HandlerStats
+        {
+            double mTime = 0; // seconds, including nested calls
+            std::uint64_t mCalls = 0;
+            std::uint64_t mAllocations = 0;
+        };
+
+        // Script index in ScriptsConfiguration -> handler name -> stats
+        using Stats = std::map<int, std::map<std::string, HandlerStats, std::less<>>>;
+
+        // Measures a call of a script handler if the profiler is active.
+        class Scope
+        {
+        public:
+            Scope(Profiler& profiler, int scriptIndex, std::string_view handler)
+                : mProfiler(profiler.mActive ? &profiler : nullptr)
+            {
+                if (mProfiler != nullptr)
+                    mProfiler->enter(scriptIndex, handler);
+            }
+
+            ~Scope()
+            {
+                if (mProfiler != nullptr)
+                    mProfiler->leave();
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Profiler* mProfiler;
+        };
+
+        bool isActive() const { return mActive; }
+
+        // Deactivation drops all recorded data.
+        void setActive(bool value);
+
+        // Called by the Lua allocator for every new memory block.
+        void countAllocation() { ++mAllocations; }
+
+        // Records the current Lua call stack of `state` as one sample. `scriptIndex` is the script that is
+        // responsible for the running code.
+        void sample(lua_State* state, int scriptIndex, const ScriptsConfiguration* conf);
+
+        // Finishes the current window. Stats of the finished window are available via `getLastWindowStats`.
+        void nextWindow(double duration);
+
+        const Stats& getLastWindowStats() const { return mLastWindowStats; }
+        double getLastWindowDuration() const { return mLastWindowDuration; }
+
+        // Adds sampled call stacks to `out` (stack -> number of samples). Each sample stands for the same number of
+        // Lua instructions.
+        void collectStacks(std::map<std::string, std::uint64_t>& out) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Frame
+        {
+            int mScriptIndex;
+            std::string_view mHandler;
+            Clock::time_point mStart;
+            std::uint64_t mAllocations;
+        };
+
+        bool mActive = false;
+        std::uint64_t mAllocations = 0;
+        std::vector<Frame> mFrames;
+        Stats mWindowStats;
+        Stats mLastWindowStats;
+        double mLastWindowDuration = 0;
+        std::map<std::string, std::uint64_t> mStacks;
+        std::string mStackBuffer;
+
+        void enter(int scriptIndex, std::string_view handler);
+
+        void leave();
+    };
+
+    // Writes call stacks in the collapsed stack format ("frame;frame;frame count" per line) that is supported by
+    // flame graph tools.
+    void writeCollapsedStacks(const std::map<std::string, std::uint64_t>& stacks, std::ostream& stream);
+}
+
+#endif // COMPONENTS_LUA_PROFILER_H
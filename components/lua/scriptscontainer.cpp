@@ -369,23 +369,55 @@ namespace LuaUtil
                 Log(Debug::Error) << mNamePrefix << " can not parse eventData for '" << eventName << "': " << e.what();
                 return;
             }
-            EventHandlerList& list = it->second;
-            for (size_t i = list.size(); i > 0; --i)
+            callEventHandlers(eventName, it->second, object);
+        });
+    }
+
+    void ScriptsContainer::receiveEvent(std::string_view eventName, const sol::object& eventData)
+    {
+        if (eventData.lua_state() != nullptr
+            && sol::main_thread(eventData.lua_state(), eventData.lua_state()) != mLua.unsafeState())
+        {
+            BinaryData binary;
+            try
             {
-                const Handler& h = list[i - 1];
-                try
-                {
-                    sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, object);
-                    if (res.is<bool>() && !res.as<bool>())
-                        break; // Skip other handlers if 'false' was returned.
-                }
-                catch (std::exception& e)
-                {
-                    Log(Debug::Error) << mNamePrefix << "[" << scriptPath(h.mScriptId) << "] eventHandler[" << eventName
-                                      << "] failed. " << e.what();
-                }
+                binary = LuaUtil::serialize(eventData, mSerializer);
             }
-        });
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << mNamePrefix << " can not serialize eventData for '" << eventName
+                                  << "': " << e.what();
+                return;
+            }
+            receiveEvent(eventName, std::string_view(binary));
+            return;
+        }
+        LoadedData& data = ensureLoaded();
+        auto it = data.mEventHandlers.find(eventName);
+        if (it == data.mEventHandlers.end())
+            return;
+        mLua.protectedCall([&](LuaView&) { callEventHandlers(eventName, it->second, eventData); });
+    }
+
+    void ScriptsContainer::callEventHandlers(
+        std::string_view eventName, const EventHandlerList& list, const sol::object& eventData)
+    {
+        for (size_t i = list.size(); i > 0; --i)
+        {
+            const Handler& h = list[i - 1];
+            const Profiler::Scope profilerScope(mLua.getProfiler(), h.mScriptId, eventName);
+            try
+            {
+                sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, eventData);
+                if (res.is<bool>() && !res.as<bool>())
+                    break; // Skip other handlers if 'false' was returned.
+            }
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << mNamePrefix << "[" << scriptPath(h.mScriptId) << "] eventHandler[" << eventName
+                                  << "] failed. " << e.what();
+            }
+        }
     }
 
     void ScriptsContainer::registerEngineHandlers(std::initializer_list<EngineHandlerList*> handlers)
@@ -725,6 +757,9 @@ namespace LuaUtil
 
     void ScriptsContainer::callTimer(const Timer& t)
     {
+        const std::string_view handler
+            = t.mSerializable ? std::string_view(std::get<std::string>(t.mCallback)) : std::string_view("timer");
+        const Profiler::Scope profilerScope(mLua.getProfiler(), t.mScriptId, handler);
         try
         {
             Script& script = getScript(t.mScriptId);
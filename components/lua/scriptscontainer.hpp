@@ -113,6 +113,10 @@ namespace LuaUtil
         // (including `nil`) has no effect.
         void receiveEvent(std::string_view eventName, std::string_view eventData);
 
+        // Same as above, but takes the event data as a Lua value that is passed to the handlers as is. It should be
+        // a copy made by LuaUtil::copy. If the value belongs to another Lua state, it is serialized and deserialized.
+        void receiveEvent(std::string_view eventName, const sol::object& eventData);
+
         // Serializer defines how to serialize/deserialize userdata. If serializer is not provided,
         // only built-in types and types from util package can be serialized.
         void setSerializer(const UserdataSerializer* serializer) { mSerializer = serializer; }
@@ -213,6 +217,7 @@ namespace LuaUtil
             ensureLoaded();
             for (Handler& handler : handlers.mList)
             {
+                const Profiler::Scope profilerScope(mLua.getProfiler(), handler.mScriptId, handlers.mName);
                 try
                 {
                     LuaUtil::call({ this, handler.mScriptId }, handler.mFn, args...);
@@ -279,6 +284,7 @@ namespace LuaUtil
         }
 
         void callOnInit(LuaView& view, int scriptId, const sol::function& onInit, std::string_view data);
+        void callEventHandlers(std::string_view eventName, const EventHandlerList& list, const sol::object& eventData);
         void callTimer(const Timer& t);
         void updateTimerQueue(std::vector<Timer>& timerQueue, double time);
         static void insertTimer(std::vector<Timer>& timerQueue, Timer&& t);
@@ -360,12 +360,70 @@ namespace LuaUtil
     {
         if (obj == sol::nil)
             return "";
-        BinaryData res;
-        res.push_back(FORMAT_VERSION);
-        serialize(res, obj, customSerializer, 0);
+        // Data is written into a per thread buffer that keeps its capacity between calls, so appending values
+        // doesn't reallocate. The result is allocated only once with the final size.
+        constexpr std::size_t maxBufferCapacity = 1024 * 1024;
+        thread_local BinaryData buffer;
+        buffer.clear();
+        buffer.push_back(FORMAT_VERSION);
+        serialize(buffer, obj, customSerializer, 0);
+        BinaryData res(buffer);
+        if (buffer.capacity() > maxBufferCapacity)
+            BinaryData().swap(buffer);
         return res;
     }
 
+    static sol::object copyUserdata(const sol::userdata& data, const UserdataSerializer* customSerializer)
+    {
+        lua_State* const lua = data.lua_state();
+        // These types are immutable in Lua, so the value can be shared
+        if (data.is<osg::Vec2f>() || data.is<osg::Vec3f>() || data.is<TransformM>() || data.is<TransformQ>()
+            || data.is<osg::Vec4f>() || data.is<Misc::Color>())
+            return data;
+        if (customSerializer && customSerializer->copy(data, lua))
+            return sol::stack::pop<sol::object>(lua);
+        BinaryData binary;
+        binary.push_back(FORMAT_VERSION);
+        serializeUserdata(binary, data, customSerializer);
+        return deserialize(lua, binary, customSerializer);
+    }
+
+    static sol::object copy(const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
+    {
+        if (obj.get_type() == sol::type::lightuserdata)
+            throw std::runtime_error("Light userdata is not allowed to be serialized.");
+        if (obj.is<sol::function>())
+            throw std::runtime_error("Functions are not allowed to be serialized.");
+        else if (obj.is<sol::userdata>())
+            return copyUserdata(obj, customSerializer);
+        else if (obj.is<sol::lua_table>())
+        {
+            if (recursionCounter >= 32)
+                throw std::runtime_error(
+                    "Can not serialize more than 32 nested tables. Likely the table contains itself.");
+            sol::table table = obj;
+            sol::table res(obj.lua_state(), sol::create);
+            for (auto& [key, value] : table)
+                res[copy(key, customSerializer, recursionCounter + 1)]
+                    = copy(value, customSerializer, recursionCounter + 1);
+            return res;
+        }
+        // Serialization stores all numbers as double
+        else if (obj.is<double>())
+            return sol::make_object<double>(obj.lua_state(), obj.as<double>());
+        else if (obj.is<std::string_view>() || obj.is<bool>())
+            return obj;
+        else
+            throw std::runtime_error("Unknown Lua type.");
+    }
+
+    sol::object copy(const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
+        if (obj == sol::nil)
+            return sol::nil;
+        return copy(obj, customSerializer, 0);
+    }
+
     sol::object deserialize(
         lua_State* lua, std::string_view binaryData, const UserdataSerializer* customSerializer, bool readOnly)
     {
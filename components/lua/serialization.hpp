@@ -24,6 +24,11 @@ namespace LuaUtil
         // sol::stack::push. Returns false if this type is not supported by this serializer.
         virtual bool deserialize(std::string_view typeName, std::string_view binaryData, lua_State*) const = 0;
 
+        // Pushes on stack the value that serialization and deserialization of sol::userdata would produce.
+        // Returns false if this type of userdata is not supported; in this case LuaUtil::copy falls back to
+        // the serialization round trip.
+        virtual bool copy(const sol::userdata&, lua_State*) const { return false; }
+
     protected:
         static void append(BinaryData&, std::string_view typeName, const void* data, size_t dataSize);
 
@@ -54,6 +59,11 @@ namespace LuaUtil
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
+    // Returns the same value as `deserialize(lua, serialize(obj, customSerializer), customSerializer)` would, but
+    // without the binary round trip. Tables are copied, immutable values (strings, vectors, ...) are shared.
+    // The result belongs to the same Lua state as `obj`. Throws the same errors as serialize.
+    sol::object copy(const sol::object& obj, const UserdataSerializer* customSerializer = nullptr);
+
 }
 
 #endif // COMPONENTS_LUA_SERIALIZATION_H
@@ -36,9 +36,13 @@ namespace LuaUtil
 
     sol::object LuaStorage::Value::getReadOnly(lua_State* state) const
     {
-        if (mReadOnlyValue == sol::nil && !mSerializedValue.empty())
-            mReadOnlyValue = sol::main_object(deserialize(state, mSerializedValue, nullptr, true));
-        return mReadOnlyValue;
+        if (mSerializedValue.empty())
+            return sol::nil;
+        lua_State* const mainState = sol::main_thread(state, state);
+        for (const sol::main_object& value : mReadOnlyValues)
+            if (value.lua_state() == mainState)
+                return value;
+        return mReadOnlyValues.emplace_back(deserialize(state, mSerializedValue, nullptr, true));
     }
 
     const LuaStorage::Value& LuaStorage::Section::get(std::string_view key) const
@@ -128,14 +132,19 @@ namespace LuaUtil
     {
         sol::usertype<SectionView> sview = view.sol().new_usertype<SectionView>("Section");
         sview["get"] = [](sol::this_state s, const SectionView& section, std::string_view key) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
             return section.mSection->get(key).getReadOnly(s);
         };
         sview["getCopy"] = [](sol::this_state s, const SectionView& section, std::string_view key) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
             return section.mSection->get(key).getCopy(s);
         };
-        sview["asTable"]
-            = [](sol::this_state lua, const SectionView& section) { return section.mSection->asTable(lua); };
+        sview["asTable"] = [](sol::this_state lua, const SectionView& section) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
+            return section.mSection->asTable(lua);
+        };
         sview["subscribe"] = [](const SectionView& section, const sol::table& callback) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
             std::vector<Callback>& callbacks
                 = section.mForMenuScripts ? section.mSection->mMenuScriptsCallbacks : section.mSection->mCallbacks;
             if (!callbacks.empty() && callbacks.size() == callbacks.capacity())
@@ -285,6 +294,7 @@ namespace LuaUtil
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
     {
         checkIfActive();
+        const std::lock_guard lock(mMutex);
         auto it = mData.find(sectionName);
         if (it != mData.end())
             return it->second;
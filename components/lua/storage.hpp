@@ -2,8 +2,10 @@
 #define COMPONENTS_LUA_STORAGE_H
 
 #include <map>
+#include <mutex>
 #include <sol/sol.hpp>
 #include <stdexcept>
+#include <vector>
 
 #include "asyncpackage.hpp"
 #include "serialization.hpp"
@@ -75,7 +77,8 @@ namespace LuaUtil
 
         private:
             std::string mSerializedValue;
-            mutable sol::main_object mReadOnlyValue = sol::nil;
+            // One value per Lua state, several states can read the same storage
+            mutable std::vector<sol::main_object> mReadOnlyValues;
         };
 
         struct Section
@@ -120,6 +123,8 @@ namespace LuaUtil
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
 
         std::map<std::string_view, std::shared_ptr<Section>> mData;
+        // Guards lazily created sections, cached values and subscriptions for readers running in parallel
+        std::mutex mMutex;
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
         bool mActive = false;
@@ -0,0 +1,279 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include "hash.hpp"
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// \brief Uniform grid over XY plane indexing points by id
+    ///
+    /// Points are bucketed by X and Y, Z is used only for the exact distance checks. Insertion, removal and
+    /// movement of a point take constant time, so the grid can be updated incrementally every frame. Queries visit
+    /// only the cells intersecting the query area.
+    template <class Id, class Hash = std::hash<Id>>
+    class SpatialGrid
+    {
+    public:
+        explicit SpatialGrid(float cellSize)
+            : mCellSize(cellSize)
+        {
+            assert(cellSize > 0);
+        }
+
+        std::size_t size() const { return mItems.size(); }
+
+        bool empty() const { return mItems.empty(); }
+
+        void clear()
+        {
+            mItems.clear();
+            mItemIndices.clear();
+            mCells.clear();
+        }
+
+        /// Adds a point or moves it if the id is already present.
+        void insert(const Id& id, const osg::Vec3f& position)
+        {
+            const auto it = mItemIndices.find(id);
+            if (it != mItemIndices.end())
+                return move(it->second, position);
+            const osg::Vec2i cell = getCell(position);
+            std::vector<std::size_t>& cellItems = mCells[cell];
+            mItemIndices.emplace(id, mItems.size());
+            mItems.push_back(Item{ .mId = id, .mPosition = position, .mCell = cell, .mSlot = cellItems.size() });
+            cellItems.push_back(mItems.size() - 1);
+        }
+
+        /// Updates position of a present point. Returns false if there is no point with such id.
+        bool update(const Id& id, const osg::Vec3f& position)
+        {
+            const auto it = mItemIndices.find(id);
+            if (it == mItemIndices.end())
+                return false;
+            move(it->second, position);
+            return true;
+        }
+
+        /// Returns false if there is no point with such id.
+        bool erase(const Id& id)
+        {
+            const auto it = mItemIndices.find(id);
+            if (it == mItemIndices.end())
+                return false;
+            const std::size_t index = it->second;
+            mItemIndices.erase(it);
+            removeFromCell(index);
+            if (index + 1 != mItems.size())
+            {
+                // Fill the gap with the last item and fix all references to it
+                mItems[index] = std::move(mItems.back());
+                mItemIndices[mItems[index].mId] = index;
+                mCells[mItems[index].mCell][mItems[index].mSlot] = index;
+            }
+            mItems.pop_back();
+            return true;
+        }
+
+        /// Calls `f(id, position)` for every point.
+        template <class F>
+        void forEach(F&& f) const
+        {
+            for (const Item& item : mItems)
+                f(item.mId, item.mPosition);
+        }
+
+        /// Calls `f(id, position)` for every point within `radius` from `center`.
+        template <class F>
+        void findInRadius(const osg::Vec3f& center, float radius, F&& f) const
+        {
+            const osg::Vec3f halfExtents(radius, radius, radius);
+            const float radius2 = radius * radius;
+            findInBox(center - halfExtents, center + halfExtents, [&](const Id& id, const osg::Vec3f& position) {
+                if ((position - center).length2() <= radius2)
+                    f(id, position);
+            });
+        }
+
+        /// Calls `f(id, position)` for every point inside axis aligned box [min, max].
+        template <class F>
+        void findInBox(const osg::Vec3f& min, const osg::Vec3f& max, F&& f) const
+        {
+            if (mItems.empty())
+                return;
+            const double minX = std::floor(static_cast<double>(min.x()) / mCellSize);
+            const double minY = std::floor(static_cast<double>(min.y()) / mCellSize);
+            const double maxX = std::floor(static_cast<double>(max.x()) / mCellSize);
+            const double maxY = std::floor(static_cast<double>(max.y()) / mCellSize);
+            // Huge boxes cover more cells than there are non empty cells, checking every point is cheaper then.
+            // Negated comparisons also handle infinite and NaN bounds.
+            constexpr double maxCellIndex = std::numeric_limits<int>::max() / 2;
+            const double cells = (maxX - minX + 1) * (maxY - minY + 1);
+            if (!(cells <= static_cast<double>(mCells.size())) || !(std::abs(minX) < maxCellIndex)
+                || !(std::abs(minY) < maxCellIndex) || !(std::abs(maxX) < maxCellIndex)
+                || !(std::abs(maxY) < maxCellIndex))
+            {
+                for (const Item& item : mItems)
+                    if (isInBox(item.mPosition, min, max))
+                        f(item.mId, item.mPosition);
+                return;
+            }
+            for (int x = static_cast<int>(minX); x <= static_cast<int>(maxX); ++x)
+                for (int y = static_cast<int>(minY); y <= static_cast<int>(maxY); ++y)
+                {
+                    const auto it = mCells.find(osg::Vec2i(x, y));
+                    if (it == mCells.end())
+                        continue;
+                    for (const std::size_t index : it->second)
+                    {
+                        const Item& item = mItems[index];
+                        if (isInBox(item.mPosition, min, max))
+                            f(item.mId, item.mPosition);
+                    }
+                }
+        }
+
+        /// Returns up to `count` points nearest to `center` within `maxDistance` ordered by distance.
+        std::vector<std::pair<Id, float>> findNearest(
+            const osg::Vec3f& center, std::size_t count, float maxDistance) const
+        {
+            std::vector<std::pair<Id, float>> result;
+            if (count == 0 || mItems.empty() || !(maxDistance >= 0))
+                return result;
+            const auto byDistance = [](const auto& l, const auto& r) { return l.second < r.second; };
+            const float maxDistance2 = maxDistance * maxDistance;
+            const osg::Vec2i centerCell = getCell(center);
+            const int maxRing
+                = static_cast<int>(std::min(std::ceil(maxDistance / mCellSize), getMaxRing(centerCell)));
+            for (int ring = 0; ring <= maxRing; ++ring)
+            {
+                forEachInRing(centerCell, ring, [&](const Item& item) {
+                    const float distance2 = (item.mPosition - center).length2();
+                    if (distance2 <= maxDistance2)
+                        result.emplace_back(item.mId, distance2);
+                });
+                // Points in the next rings are at least `ring * mCellSize` far from the center
+                if (result.size() >= count)
+                {
+                    std::nth_element(result.begin(), result.begin() + (count - 1), result.end(), byDistance);
+                    const float bound = ring * mCellSize;
+                    if (result[count - 1].second <= bound * bound)
+                        break;
+                }
+            }
+            const std::size_t resultSize = std::min(count, result.size());
+            std::partial_sort(result.begin(), result.begin() + resultSize, result.end(), byDistance);
+            result.resize(resultSize);
+            for (auto& [id, distance] : result)
+                distance = std::sqrt(distance);
+            return result;
+        }
+
+    private:
+        struct Item
+        {
+            Id mId;
+            osg::Vec3f mPosition;
+            osg::Vec2i mCell;
+            std::size_t mSlot; // Index in the cell's vector
+        };
+
+        struct CellHash
+        {
+            std::size_t operator()(const osg::Vec2i& v) const { return hash2dCoord(v.x(), v.y()); }
+        };
+
+        const float mCellSize;
+        std::vector<Item> mItems;
+        std::unordered_map<Id, std::size_t, Hash> mItemIndices;
+        std::unordered_map<osg::Vec2i, std::vector<std::size_t>, CellHash> mCells;
+
+        static bool isInBox(const osg::Vec3f& position, const osg::Vec3f& min, const osg::Vec3f& max)
+        {
+            return min.x() <= position.x() && position.x() <= max.x() && min.y() <= position.y()
+                && position.y() <= max.y() && min.z() <= position.z() && position.z() <= max.z();
+        }
+
+        osg::Vec2i getCell(const osg::Vec3f& position) const
+        {
+            return osg::Vec2i(static_cast<int>(std::floor(position.x() / mCellSize)),
+                static_cast<int>(std::floor(position.y() / mCellSize)));
+        }
+
+        // Number of rings around the cell covering all non empty cells
+        float getMaxRing(const osg::Vec2i& cell) const
+        {
+            int result = 0;
+            for (const auto& [key, items] : mCells)
+                result = std::max({ result, std::abs(key.x() - cell.x()), std::abs(key.y() - cell.y()) });
+            return static_cast<float>(result);
+        }
+
+        template <class F>
+        void forEachInRing(const osg::Vec2i& center, int ring, F&& f) const
+        {
+            const auto visit = [&](int x, int y) {
+                const auto it = mCells.find(osg::Vec2i(x, y));
+                if (it != mCells.end())
+                    for (const std::size_t index : it->second)
+                        f(mItems[index]);
+            };
+            if (ring == 0)
+                return visit(center.x(), center.y());
+            for (int i = -ring; i <= ring; ++i)
+            {
+                visit(center.x() + i, center.y() - ring);
+                visit(center.x() + i, center.y() + ring);
+            }
+            for (int i = -ring + 1; i <= ring - 1; ++i)
+            {
+                visit(center.x() - ring, center.y() + i);
+                visit(center.x() + ring, center.y() + i);
+            }
+        }
+
+        void move(std::size_t index, const osg::Vec3f& position)
+        {
+            Item& item = mItems[index];
+            item.mPosition = position;
+            const osg::Vec2i cell = getCell(position);
+            if (cell == item.mCell)
+                return;
+            removeFromCell(index);
+            std::vector<std::size_t>& cellItems = mCells[cell];
+            item.mCell = cell;
+            item.mSlot = cellItems.size();
+            cellItems.push_back(index);
+        }
+
+        void removeFromCell(std::size_t index)
+        {
+            const Item& item = mItems[index];
+            const auto it = mCells.find(item.mCell);
+            assert(it != mCells.end());
+            std::vector<std::size_t>& cellItems = it->second;
+            if (item.mSlot + 1 != cellItems.size())
+            {
+                cellItems[item.mSlot] = cellItems.back();
+                mItems[cellItems[item.mSlot]].mSlot = item.mSlot;
+            }
+            cellItems.pop_back();
+            if (cellItems.empty())
+                mCells.erase(it);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,323 @@
+#include "compressedtracks.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace NifOsg
+{
+    namespace
+    {
+        constexpr float maxQuantized = std::numeric_limits<std::uint16_t>::max();
+
+        // Limits the cost of checking whether keys can be dropped for long static tracks.
+        constexpr std::size_t maxDroppedKeys = 256;
+
+        constexpr float rotationStep = 2.f / maxQuantized;
+
+        std::uint16_t quantize(float value, float offset, float step)
+        {
+            if (step == 0)
+                return 0;
+            return static_cast<std::uint16_t>(std::clamp(std::round((value - offset) / step), 0.f, maxQuantized));
+        }
+
+        osg::Quat normalized(const osg::Quat& value)
+        {
+            const osg::Quat::value_type length = value.length();
+            if (length == 0)
+                return value;
+            return value / length;
+        }
+
+        osg::Quat slerp(const osg::Quat& from, const osg::Quat& to, float fraction)
+        {
+            osg::Quat result;
+            result.slerp(fraction, from, to);
+            return result;
+        }
+
+        float getAngle(const osg::Quat& a, const osg::Quat& b)
+        {
+            const double dot = std::abs(a.asVec4() * b.asVec4());
+            return static_cast<float>(2 * std::acos(std::min(dot, 1.0)));
+        }
+
+        template <class T>
+        T lerp(const T& from, const T& to, float fraction)
+        {
+            return from + (to - from) * fraction;
+        }
+
+        template <class T>
+        bool isStrictlySorted(const std::vector<std::pair<float, Nif::KeyT<T>>>& keys)
+        {
+            return std::adjacent_find(keys.begin(), keys.end(),
+                       [](const auto& l, const auto& r) { return l.first >= r.first; })
+                == keys.end();
+        }
+
+        // Returns indices of the keys required to reproduce the track within the tolerance
+        template <class T, class Interpolate, class Distance>
+        std::vector<std::size_t> selectKeys(const std::vector<std::pair<float, Nif::KeyT<T>>>& keys, bool constant,
+            float tolerance, Interpolate&& interpolate, Distance&& distance)
+        {
+            std::vector<std::size_t> result;
+
+            // Keys with equal or decreasing times are looked up in a way that depends on their neighbours
+            if (constant || tolerance <= 0 || keys.size() <= 2 || !isStrictlySorted(keys))
+            {
+                result.resize(keys.size());
+                std::iota(result.begin(), result.end(), std::size_t{ 0 });
+                return result;
+            }
+
+            result.push_back(0);
+
+            std::size_t anchor = 0;
+            for (std::size_t candidate = 2; candidate < keys.size(); ++candidate)
+            {
+                const auto& [anchorTime, anchorKey] = keys[anchor];
+                const auto& [candidateTime, candidateKey] = keys[candidate];
+                bool fits = candidate - anchor <= maxDroppedKeys;
+                for (std::size_t i = anchor + 1; fits && i < candidate; ++i)
+                {
+                    const float fraction = (keys[i].first - anchorTime) / (candidateTime - anchorTime);
+                    const T value = interpolate(anchorKey.mValue, candidateKey.mValue, fraction);
+                    fits = distance(value, keys[i].second.mValue) <= tolerance;
+                }
+                if (!fits)
+                {
+                    anchor = candidate - 1;
+                    result.push_back(anchor);
+                }
+            }
+
+            result.push_back(keys.size() - 1);
+
+            return result;
+        }
+    }
+
+    std::shared_ptr<const CompressedTransformTracks> CompressedTransformTracks::create(
+        const Nif::QuaternionKeyMap* rotations, const Nif::Vector3KeyMap* translations,
+        const Nif::FloatKeyMap* scales, const KeyframeCompressionSettings& settings)
+    {
+        auto result = std::make_shared<CompressedTransformTracks>();
+
+        if (rotations != nullptr && canCompress(*rotations))
+            result->addRotations(*rotations, settings.mRotationTolerance);
+        if (translations != nullptr && canCompress(*translations))
+            result->addTranslations(*translations, settings.mTranslationTolerance);
+        if (scales != nullptr && canCompress(*scales))
+            result->addScales(*scales, settings.mScaleTolerance);
+
+        if (result->mTimes.empty())
+            return nullptr;
+
+        result->mTimes.shrink_to_fit();
+        result->mValues.shrink_to_fit();
+
+        return result;
+    }
+
+    bool CompressedTransformTracks::canCompress(const Nif::QuaternionKeyMap& keys)
+    {
+        // Quaternions are always interpolated spherically except for constant interpolation
+        return !keys.mKeys.empty() && keys.mInterpolationType != Nif::InterpolationType_XYZ;
+    }
+
+    bool CompressedTransformTracks::canCompress(const Nif::Vector3KeyMap& keys)
+    {
+        return !keys.mKeys.empty()
+            && (keys.mInterpolationType == Nif::InterpolationType_Linear
+                || keys.mInterpolationType == Nif::InterpolationType_Constant);
+    }
+
+    bool CompressedTransformTracks::canCompress(const Nif::FloatKeyMap& keys)
+    {
+        return !keys.mKeys.empty()
+            && (keys.mInterpolationType == Nif::InterpolationType_Linear
+                || keys.mInterpolationType == Nif::InterpolationType_Constant);
+    }
+
+    float CompressedTransformTracks::getMaxRotationQuantizationError()
+    {
+        // Each of the 4 components is off by at most half a step, so the quaternion is off by at most a step.
+        // The rotation angle is twice the quaternion distance.
+        return 2 * rotationStep;
+    }
+
+    osg::Quat CompressedTransformTracks::getRotation(float time) const
+    {
+        const Segment segment = findSegment(mRotations, time);
+        if (segment.mLow == segment.mHigh)
+            return getRotationKey(segment.mLow);
+        return slerp(getRotationKey(segment.mLow), getRotationKey(segment.mHigh), segment.mFraction);
+    }
+
+    osg::Vec3f CompressedTransformTracks::getTranslation(float time) const
+    {
+        const Segment segment = findSegment(mTranslations, time);
+        if (segment.mLow == segment.mHigh)
+            return getTranslationKey(segment.mLow);
+        return lerp(getTranslationKey(segment.mLow), getTranslationKey(segment.mHigh), segment.mFraction);
+    }
+
+    float CompressedTransformTracks::getScale(float time) const
+    {
+        const Segment segment = findSegment(mScales, time);
+        if (segment.mLow == segment.mHigh)
+            return getScaleKey(segment.mLow);
+        return lerp(getScaleKey(segment.mLow), getScaleKey(segment.mHigh), segment.mFraction);
+    }
+
+    std::size_t CompressedTransformTracks::getMemoryUsage() const
+    {
+        return sizeof(CompressedTransformTracks) + mTimes.capacity() * sizeof(float)
+            + mValues.capacity() * sizeof(std::uint16_t);
+    }
+
+    CompressedTransformTracks::Segment CompressedTransformTracks::findSegment(const Track& track, float time) const
+    {
+        assert(track.mCount != 0);
+
+        // Matches the lookup done by ValueInterpolator
+        const float* const begin = mTimes.data() + track.mFirstKey;
+        const float* const end = begin + track.mCount;
+
+        if (time <= *begin)
+            return Segment{ 0, 0, 0 };
+
+        const float* const it = std::lower_bound(begin, end, time);
+        if (it == end)
+            return Segment{ track.mCount - 1u, track.mCount - 1u, 0 };
+
+        const std::size_t high = static_cast<std::size_t>(it - begin);
+        const std::size_t low = high - 1;
+        const float highTime = begin[high];
+        const float lowTime = begin[low];
+        if (highTime == lowTime)
+            return Segment{ low, low, 0 };
+
+        const float fraction = (time - lowTime) / (highTime - lowTime);
+        if (track.mConstant)
+        {
+            const std::size_t index = fraction > 0.5f ? high : low;
+            return Segment{ index, index, 0 };
+        }
+
+        return Segment{ low, high, fraction };
+    }
+
+    osg::Quat CompressedTransformTracks::getRotationKey(std::size_t index) const
+    {
+        const std::uint16_t* const value = mValues.data() + mRotations.mFirstValue + index * 4;
+        osg::Quat result;
+        for (std::size_t i = 0; i < 4; ++i)
+            result[i] = -1.f + value[i] * rotationStep;
+        return normalized(result);
+    }
+
+    osg::Vec3f CompressedTransformTracks::getTranslationKey(std::size_t index) const
+    {
+        const std::uint16_t* const value = mValues.data() + mTranslations.mFirstValue + index * 3;
+        osg::Vec3f result;
+        for (std::size_t i = 0; i < 3; ++i)
+            result[i] = mTranslations.mOffset[i] + value[i] * mTranslations.mStep[i];
+        return result;
+    }
+
+    float CompressedTransformTracks::getScaleKey(std::size_t index) const
+    {
+        const std::uint16_t value = mValues[mScales.mFirstValue + index];
+        return mScales.mOffset.x() + value * mScales.mStep.x();
+    }
+
+    void CompressedTransformTracks::addRotations(const Nif::QuaternionKeyMap& keys, float tolerance)
+    {
+        const bool constant = keys.mInterpolationType == Nif::InterpolationType_Constant;
+        const std::vector<std::size_t> selected = selectKeys(keys.mKeys, constant, tolerance, slerp, getAngle);
+
+        mRotations.mFirstKey = static_cast<std::uint32_t>(mTimes.size());
+        mRotations.mCount = static_cast<std::uint32_t>(selected.size());
+        mRotations.mFirstValue = static_cast<std::uint32_t>(mValues.size());
+        mRotations.mConstant = constant;
+
+        for (const std::size_t index : selected)
+        {
+            const auto& [time, key] = keys.mKeys[index];
+            mTimes.push_back(time);
+            const osg::Quat value = normalized(key.mValue);
+            for (std::size_t i = 0; i < 4; ++i)
+                mValues.push_back(quantize(static_cast<float>(value[i]), -1.f, rotationStep));
+        }
+    }
+
+    void CompressedTransformTracks::addTranslations(const Nif::Vector3KeyMap& keys, float tolerance)
+    {
+        const bool constant = keys.mInterpolationType == Nif::InterpolationType_Constant;
+        const std::vector<std::size_t> selected = selectKeys(keys.mKeys, constant, tolerance,
+            lerp<osg::Vec3f>, [](const osg::Vec3f& a, const osg::Vec3f& b) { return (a - b).length(); });
+
+        osg::Vec3f min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max());
+        osg::Vec3f max = -min;
+        for (const std::size_t index : selected)
+        {
+            const osg::Vec3f& value = keys.mKeys[index].second.mValue;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                min[i] = std::min(min[i], value[i]);
+                max[i] = std::max(max[i], value[i]);
+            }
+        }
+
+        mTranslations.mFirstKey = static_cast<std::uint32_t>(mTimes.size());
+        mTranslations.mCount = static_cast<std::uint32_t>(selected.size());
+        mTranslations.mFirstValue = static_cast<std::uint32_t>(mValues.size());
+        mTranslations.mConstant = constant;
+        mTranslations.mOffset = min;
+        mTranslations.mStep = (max - min) / maxQuantized;
+
+        for (const std::size_t index : selected)
+        {
+            const auto& [time, key] = keys.mKeys[index];
+            mTimes.push_back(time);
+            for (std::size_t i = 0; i < 3; ++i)
+                mValues.push_back(quantize(key.mValue[i], min[i], mTranslations.mStep[i]));
+        }
+    }
+
+    void CompressedTransformTracks::addScales(const Nif::FloatKeyMap& keys, float tolerance)
+    {
+        const bool constant = keys.mInterpolationType == Nif::InterpolationType_Constant;
+        const std::vector<std::size_t> selected = selectKeys(
+            keys.mKeys, constant, tolerance, lerp<float>, [](float a, float b) { return std::abs(a - b); });
+
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+        for (const std::size_t index : selected)
+        {
+            min = std::min(min, keys.mKeys[index].second.mValue);
+            max = std::max(max, keys.mKeys[index].second.mValue);
+        }
+
+        mScales.mFirstKey = static_cast<std::uint32_t>(mTimes.size());
+        mScales.mCount = static_cast<std::uint32_t>(selected.size());
+        mScales.mFirstValue = static_cast<std::uint32_t>(mValues.size());
+        mScales.mConstant = constant;
+        mScales.mOffset = osg::Vec3f(min, 0, 0);
+        mScales.mStep = osg::Vec3f((max - min) / maxQuantized, 0, 0);
+
+        for (const std::size_t index : selected)
+        {
+            const auto& [time, key] = keys.mKeys[index];
+            mTimes.push_back(time);
+            mValues.push_back(quantize(key.mValue, min, mScales.mStep.x()));
+        }
+    }
+
+}
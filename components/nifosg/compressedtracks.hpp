@@ -0,0 +1,110 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_COMPRESSEDTRACKS_H
+#define OPENMW_COMPONENTS_NIFOSG_COMPRESSEDTRACKS_H
+
+#include <components/nif/nifkey.hpp>
+
+#include <osg/Quat>
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace NifOsg
+{
+
+    struct KeyframeCompressionSettings
+    {
+        // Maximum error introduced by dropping keys, in radians.
+        float mRotationTolerance = 0;
+        // Maximum error introduced by dropping keys, in game units.
+        float mTranslationTolerance = 0;
+        // Maximum error introduced by dropping keys, as a scale factor.
+        float mScaleTolerance = 0;
+    };
+
+    struct KeyframeCompressionStats
+    {
+        std::size_t mOriginalSize = 0;
+        std::size_t mCompressedSize = 0;
+    };
+
+    template <class T>
+    std::size_t getKeysMemoryUsage(const T& keys)
+    {
+        return keys.mKeys.capacity() * sizeof(typename T::MapType::value_type);
+    }
+
+    /// Rotation, translation and scale tracks of a node stored in a single contiguous buffer. Keys that can be
+    /// reproduced by interpolating their neighbours within the tolerance are removed and the remaining values are
+    /// quantized to 16 bits per component.
+    /// @par Quantization adds an error of at most getMaxRotationQuantizationError() to rotations and half of the
+    /// track's value range divided by 65535 to translations and scales.
+    class CompressedTransformTracks
+    {
+    public:
+        /// Creates compressed copies of the given tracks. Null, empty and not compressible tracks are skipped.
+        /// Returns null if no track could be compressed.
+        static std::shared_ptr<const CompressedTransformTracks> create(const Nif::QuaternionKeyMap* rotations,
+            const Nif::Vector3KeyMap* translations, const Nif::FloatKeyMap* scales,
+            const KeyframeCompressionSettings& settings);
+
+        /// Quadratic and TCB interpolation of vectors and scalars needs tangents which are not stored.
+        static bool canCompress(const Nif::QuaternionKeyMap& keys);
+        static bool canCompress(const Nif::Vector3KeyMap& keys);
+        static bool canCompress(const Nif::FloatKeyMap& keys);
+
+        static float getMaxRotationQuantizationError();
+
+        bool hasRotations() const { return mRotations.mCount != 0; }
+        bool hasTranslations() const { return mTranslations.mCount != 0; }
+        bool hasScales() const { return mScales.mCount != 0; }
+
+        osg::Quat getRotation(float time) const;
+        osg::Vec3f getTranslation(float time) const;
+        float getScale(float time) const;
+
+        std::size_t getNumKeys() const { return mTimes.size(); }
+
+        std::size_t getMemoryUsage() const;
+
+    private:
+        struct Track
+        {
+            std::uint32_t mFirstKey = 0;
+            std::uint32_t mCount = 0;
+            std::uint32_t mFirstValue = 0;
+            bool mConstant = false;
+            // Dequantized value is mOffset + mStep * quantized
+            osg::Vec3f mOffset;
+            osg::Vec3f mStep;
+        };
+
+        struct Segment
+        {
+            std::size_t mLow;
+            std::size_t mHigh;
+            float mFraction;
+        };
+
+        Track mRotations;
+        Track mTranslations;
+        Track mScales;
+        std::vector<float> mTimes;
+        std::vector<std::uint16_t> mValues;
+
+        Segment findSegment(const Track& track, float time) const;
+
+        osg::Quat getRotationKey(std::size_t index) const;
+        osg::Vec3f getTranslationKey(std::size_t index) const;
+        float getScaleKey(std::size_t index) const;
+
+        void addRotations(const Nif::QuaternionKeyMap& keys, float tolerance);
+        void addTranslations(const Nif::Vector3KeyMap& keys, float tolerance);
+        void addScales(const Nif::FloatKeyMap& keys, float tolerance);
+    };
+
+}
+
+#endif
@@ -87,6 +87,8 @@ namespace NifOsg
         , mTranslations(copy.mTranslations)
         , mScales(copy.mScales)
         , mAxisOrder(copy.mAxisOrder)
+        , mCompressedTracks(copy.mCompressedTracks)
+        , mPoseCache(copy.mPoseCache)
     {
     }
 
@@ -170,6 +172,11 @@ namespace NifOsg
 
     osg::Vec3f KeyframeController::getTranslation(float time) const
     {
+        // Root movement has to match the pose evaluated by getCurrentTransformation
+        time = quantizePoseTime(time);
+
+        if (mCompressedTracks != nullptr && mCompressedTracks->hasTranslations())
+            return mCompressedTracks->getTranslation(time);
         if (!mTranslations.empty())
             return mTranslations.interpKey(time);
         return osg::Vec3f();
@@ -204,23 +211,68 @@ namespace NifOsg
 
         if (hasInput())
         {
-            float time = getInputValue(nv);
+            const float time = quantizePoseTime(getInputValue(nv));
+
+            const osg::FrameStamp* frameStamp = nv != nullptr ? nv->getFrameStamp() : nullptr;
+            if (frameStamp != nullptr)
+            {
+                if (const KfTransform* cached = mPoseCache->find(frameStamp->getFrameNumber(), time))
+                    return *cached;
+            }
 
-            if (!mRotations.empty())
+            if (mCompressedTracks != nullptr && mCompressedTracks->hasRotations())
+                out.mRotation = mCompressedTracks->getRotation(time);
+            else if (!mRotations.empty())
                 out.mRotation = mRotations.interpKey(time);
             else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
                 out.mRotation = getXYZRotation(time);
 
-            if (!mTranslations.empty())
+            if (mCompressedTracks != nullptr && mCompressedTracks->hasTranslations())
+                out.mTranslation = mCompressedTracks->getTranslation(time);
+            else if (!mTranslations.empty())
                 out.mTranslation = mTranslations.interpKey(time);
 
-            if (!mScales.empty())
+            if (mCompressedTracks != nullptr && mCompressedTracks->hasScales())
+                out.mScale = mCompressedTracks->getScale(time);
+            else if (!mScales.empty())
                 out.mScale = mScales.interpKey(time);
+
+            if (frameStamp != nullptr)
+                mPoseCache->insert(frameStamp->getFrameNumber(), time, out);
         }
 
         return out;
     }
 
+    KeyframeCompressionStats KeyframeController::compress(const KeyframeCompressionSettings& settings)
+    {
+        KeyframeCompressionStats stats;
+
+        mCompressedTracks = CompressedTransformTracks::create(mRotations.getKeys().get(),
+            mTranslations.getKeys().get(), mScales.getKeys().get(), settings);
+        if (mCompressedTracks == nullptr)
+            return stats;
+
+        if (mCompressedTracks->hasRotations())
+        {
+            stats.mOriginalSize += getKeysMemoryUsage(*mRotations.getKeys());
+            mRotations = QuaternionInterpolator();
+        }
+        if (mCompressedTracks->hasTranslations())
+        {
+            stats.mOriginalSize += getKeysMemoryUsage(*mTranslations.getKeys());
+            mTranslations = Vec3Interpolator();
+        }
+        if (mCompressedTracks->hasScales())
+        {
+            stats.mOriginalSize += getKeysMemoryUsage(*mScales.getKeys());
+            mScales = FloatInterpolator();
+        }
+        stats.mCompressedSize = mCompressedTracks->getMemoryUsage();
+
+        return stats;
+    }
+
     GeomMorpherController::GeomMorpherController() {}
 
     GeomMorpherController::GeomMorpherController(const GeomMorpherController& copy, const osg::CopyOp& copyop)
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_NIFOSG_CONTROLLER_H
 #define COMPONENTS_NIFOSG_CONTROLLER_H
 
+#include <memory>
 #include <set>
 #include <type_traits>
 
@@ -13,6 +14,9 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include "compressedtracks.hpp"
+#include "posecache.hpp"
+
 namespace osg
 {
     class Material;
@@ -127,6 +131,8 @@ namespace NifOsg
 
         bool empty() const { return !mKeys || mKeys->mKeys.empty(); }
 
+        const std::shared_ptr<const MapT>& getKeys() const { return mKeys; }
+
     private:
         template <typename ValueType>
         ValueType interpolate(
@@ -248,6 +254,11 @@ namespace NifOsg
 
         void operator()(NifOsg::MatrixTransform*, osg::NodeVisitor*);
 
+        /// Replace the rotation, translation and scale tracks by a compressed representation where possible.
+        /// References to the replaced keys are dropped, they are freed with the NIF file they came from.
+        /// @note Must be called before the controller is cloned.
+        KeyframeCompressionStats compress(const KeyframeCompressionSettings& settings);
+
     private:
         QuaternionInterpolator mRotations;
 
@@ -260,6 +271,10 @@ namespace NifOsg
 
         Nif::NiKeyframeData::AxisOrder mAxisOrder{ Nif::NiKeyframeData::AxisOrder::Order_XYZ };
 
+        std::shared_ptr<const CompressedTransformTracks> mCompressedTracks;
+
+        std::shared_ptr<PoseCache> mPoseCache = std::make_shared<PoseCache>();
+
         osg::Quat getXYZRotation(float time) const;
     };
 #ifdef _MSC_VER
@@ -1,5 +1,6 @@
 #include "nifloader.hpp"
 
+#include <atomic>
 #include <mutex>
 #include <string_view>
 
@@ -278,6 +279,33 @@ namespace NifOsg
         return sSoftEffectEnabled;
     }
 
+    std::optional<KeyframeCompressionSettings> Loader::sKeyframeCompression;
+
+    void Loader::setKeyframeCompression(const std::optional<KeyframeCompressionSettings>& settings)
+    {
+        sKeyframeCompression = settings;
+    }
+
+    const std::optional<KeyframeCompressionSettings>& Loader::getKeyframeCompression()
+    {
+        return sKeyframeCompression;
+    }
+
+    namespace
+    {
+        // Keyframes can be loaded by multiple threads
+        std::atomic<std::size_t> sKeyframeOriginalSize{ 0 };
+        std::atomic<std::size_t> sKeyframeCompressedSize{ 0 };
+    }
+
+    KeyframeCompressionStats Loader::getKeyframeCompressionStats()
+    {
+        return KeyframeCompressionStats{
+            .mOriginalSize = sKeyframeOriginalSize.load(std::memory_order_relaxed),
+            .mCompressedSize = sKeyframeCompressedSize.load(std::memory_order_relaxed),
+        };
+    }
+
     class LoaderImpl
     {
     public:
@@ -346,6 +374,9 @@ namespace NifOsg
             auto textKeyExtraData = static_cast<const Nif::NiTextKeyExtraData*>(extraList[0].getPtr());
             extractTextKeys(textKeyExtraData, target.mTextKeys);
 
+            const std::optional<KeyframeCompressionSettings>& compression = Loader::getKeyframeCompression();
+            KeyframeCompressionStats compressionStats;
+
             Nif::NiTimeControllerPtr ctrl = seq->mController;
             for (size_t i = 1; i < extraList.size() && !ctrl.empty(); i++, (ctrl = ctrl->mNext))
             {
@@ -374,13 +405,29 @@ namespace NifOsg
                     continue;
                 }
 
-                osg::ref_ptr<SceneUtil::KeyframeController> callback = new NifOsg::KeyframeController(key);
+                osg::ref_ptr<NifOsg::KeyframeController> callback = new NifOsg::KeyframeController(key);
                 setupController(key, callback, /*animflags*/ 0);
 
+                if (compression.has_value())
+                {
+                    const KeyframeCompressionStats stats = callback->compress(*compression);
+                    compressionStats.mOriginalSize += stats.mOriginalSize;
+                    compressionStats.mCompressedSize += stats.mCompressedSize;
+                }
+
                 if (!target.mKeyframeControllers.emplace(strdata->mData, callback).second)
                     Log(Debug::Verbose) << "Controller " << strdata->mData << " present more than once in "
                                         << nif.getFilename() << ", ignoring later version";
             }
+
+            if (compressionStats.mOriginalSize != 0)
+            {
+                sKeyframeOriginalSize.fetch_add(compressionStats.mOriginalSize, std::memory_order_relaxed);
+                sKeyframeCompressedSize.fetch_add(compressionStats.mCompressedSize, std::memory_order_relaxed);
+                Log(Debug::Verbose) << "Compressed keyframes in " << nif.getFilename() << " from "
+                                    << compressionStats.mOriginalSize << " to " << compressionStats.mCompressedSize
+                                    << " bytes";
+            }
         }
 
         struct HandleNodeArgs
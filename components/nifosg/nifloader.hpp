@@ -5,6 +5,10 @@
 
 #include <osg/ref_ptr>
 
+#include <optional>
+
+#include "compressedtracks.hpp"
+
 namespace SceneUtil
 {
     class KeyframeHolder;
@@ -58,11 +62,19 @@ namespace NifOsg
         static void setSoftEffectEnabled(bool enabled);
         static bool getSoftEffectEnabled();
 
+        /// Set how keyframes loaded by loadKf should be compressed. Default: not compressed.
+        static void setKeyframeCompression(const std::optional<KeyframeCompressionSettings>& settings);
+        static const std::optional<KeyframeCompressionSettings>& getKeyframeCompression();
+
+        /// Total size of keyframes compressed by all loadKf calls, thread safe.
+        static KeyframeCompressionStats getKeyframeCompressionStats();
+
     private:
         static unsigned int sHiddenNodeMask;
         static unsigned int sIntersectionDisabledNodeMask;
         static bool sShowMarkers;
         static bool sSoftEffectEnabled;
+        static std::optional<KeyframeCompressionSettings> sKeyframeCompression;
     };
 
 }
@@ -0,0 +1,76 @@
+#include "posecache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace NifOsg
+{
+    namespace
+    {
+        // Distinct animation times per controller and frame, more than that means the actors are not in sync and
+        // caching would not pay off.
+        constexpr std::size_t maxEntries = 16;
+
+        // Shared by all caches, so the functions below can be called from any thread
+        std::atomic<float> sTimeStep{ 0 };
+        std::atomic<std::size_t> sGet{ 0 };
+        std::atomic<std::size_t> sHit{ 0 };
+    }
+
+    const PoseCache::KfTransform* PoseCache::find(unsigned int frameNumber, float time)
+    {
+        sGet.fetch_add(1, std::memory_order_relaxed);
+
+        if (frameNumber != mFrameNumber)
+        {
+            reset(frameNumber);
+            return nullptr;
+        }
+
+        const auto it = std::find_if(
+            mEntries.begin(), mEntries.end(), [&](const auto& entry) { return entry.first == time; });
+        if (it == mEntries.end())
+            return nullptr;
+
+        sHit.fetch_add(1, std::memory_order_relaxed);
+        return &it->second;
+    }
+
+    void PoseCache::insert(unsigned int frameNumber, float time, const KfTransform& transform)
+    {
+        if (frameNumber != mFrameNumber)
+            reset(frameNumber);
+
+        if (mEntries.size() < maxEntries)
+            mEntries.emplace_back(time, transform);
+    }
+
+    void PoseCache::reset(unsigned int frameNumber)
+    {
+        mFrameNumber = frameNumber;
+        mEntries.clear();
+    }
+
+    void setPoseCacheTimeStep(float step)
+    {
+        sTimeStep.store(std::max(step, 0.f), std::memory_order_relaxed);
+    }
+
+    float quantizePoseTime(float time)
+    {
+        const float step = sTimeStep.load(std::memory_order_relaxed);
+        if (step == 0)
+            return time;
+        return std::round(time / step) * step;
+    }
+
+    PoseCacheStats takePoseCacheStats()
+    {
+        return PoseCacheStats{
+            .mGet = sGet.exchange(0, std::memory_order_relaxed),
+            .mHit = sHit.exchange(0, std::memory_order_relaxed),
+        };
+    }
+
+}
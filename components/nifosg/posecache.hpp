@@ -0,0 +1,49 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_POSECACHE_H
+#define OPENMW_COMPONENTS_NIFOSG_POSECACHE_H
+
+#include <components/sceneutil/keyframe.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace NifOsg
+{
+
+    /// Transforms a keyframe controller produced during the current frame. The cache is shared by all clones of a
+    /// controller, so actors playing the same animation at the same time evaluate its interpolators once per frame.
+    /// @note Not thread safe, controllers are only evaluated by the update traversal.
+    class PoseCache
+    {
+    public:
+        using KfTransform = SceneUtil::KeyframeController::KfTransform;
+
+        const KfTransform* find(unsigned int frameNumber, float time);
+
+        void insert(unsigned int frameNumber, float time, const KfTransform& transform);
+
+    private:
+        unsigned int mFrameNumber = 0;
+        std::vector<std::pair<float, KfTransform>> mEntries;
+
+        void reset(unsigned int frameNumber);
+    };
+
+    struct PoseCacheStats
+    {
+        std::size_t mGet = 0;
+        std::size_t mHit = 0;
+    };
+
+    /// Animation times are rounded to a multiple of the step before evaluation so that actors with nearly equal
+    /// times share the result. Zero disables rounding, then only exactly equal times are shared.
+    void setPoseCacheTimeStep(float step);
+
+    float quantizePoseTime(float time);
+
+    /// Returns the cache usage since the previous call and resets it.
+    PoseCacheStats takePoseCacheStats();
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <span>
 
 namespace Platform::File
 {
@@ -30,6 +31,11 @@ namespace Platform::File
 
     size_t read(Handle handle, void* data, size_t size);
 
+    // Maps first size bytes of the file for reading, the mapping stays valid after the handle is closed
+    const void* map(Handle handle, size_t size);
+
+    void unmap(const void* data, size_t size);
+
     class ScopedHandle
     {
         Handle mHandle{ Handle::Invalid };
@@ -63,6 +69,50 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    class ScopedMapping
+    {
+        const void* mData = nullptr;
+        size_t mSize = 0;
+
+    public:
+        ScopedMapping() noexcept = default;
+        explicit ScopedMapping(const std::filesystem::path& filename)
+        {
+            const ScopedHandle handle(open(filename));
+            const size_t fileSize = size(handle);
+            if (fileSize == 0)
+                return;
+            mData = map(handle, fileSize);
+            mSize = fileSize;
+        }
+        ScopedMapping(const ScopedMapping& other) = delete;
+        ScopedMapping(ScopedMapping&& other) noexcept
+            : mData(other.mData)
+            , mSize(other.mSize)
+        {
+            other.mData = nullptr;
+            other.mSize = 0;
+        }
+        ScopedMapping& operator=(const ScopedMapping& other) = delete;
+        ScopedMapping& operator=(ScopedMapping&& other) noexcept
+        {
+            if (mData != nullptr)
+                unmap(mData, mSize);
+            mData = other.mData;
+            mSize = other.mSize;
+            other.mData = nullptr;
+            other.mSize = 0;
+            return *this;
+        }
+        ~ScopedMapping()
+        {
+            if (mData != nullptr)
+                unmap(mData, mSize);
+        }
+
+        std::span<const char> getData() const { return { static_cast<const char*>(mData), mSize }; }
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
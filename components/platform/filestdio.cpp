@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <errno.h>
+#include <new>
 #include <stdexcept>
 #include <string.h>
 #include <string>
@@ -93,4 +94,33 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    // There is no portable way to map a file, so it's read into memory
+    const void* map(Handle handle, size_t size)
+    {
+        void* data = malloc(size);
+        if (data == nullptr)
+            throw std::bad_alloc();
+
+        seek(handle, 0);
+        size_t offset = 0;
+        while (offset < size)
+        {
+            const size_t amount = read(handle, static_cast<char*>(data) + offset, size - offset);
+            if (amount == 0)
+                break;
+            offset += amount;
+        }
+        if (offset != size)
+        {
+            free(data);
+            throw std::runtime_error("An attempt to read " + std::to_string(size) + " bytes failed");
+        }
+        return data;
+    }
+
+    void unmap(const void* data, size_t /*size*/)
+    {
+        free(const_cast<void*>(data));
+    }
+
 }
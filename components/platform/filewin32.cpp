@@ -99,4 +99,28 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    const void* map(Handle handle, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        HANDLE mapping = CreateFileMappingW(nativeHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            throw std::runtime_error(
+                std::string("A file mapping creation failed: ") + std::to_string(GetLastError()));
+
+        // The view keeps the mapping object alive
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+        const DWORD errCode = GetLastError();
+        CloseHandle(mapping);
+        if (data == nullptr)
+            throw std::runtime_error(std::string("A file view mapping failed: ") + std::to_string(errCode));
+
+        return data;
+    }
+
+    void unmap(const void* data, size_t /*size*/)
+    {
+        UnmapViewOfFile(data);
+    }
 }
@@ -222,6 +222,8 @@ namespace Resource
             Nif::Reader reader(*file, mEncoder);
             reader.parse(mVFS->get(name));
             NifOsg::Loader::loadKf(*file, *loaded.get());
+            // The file is the last owner of the key maps replaced by compressed tracks, don't keep it around
+            file.reset();
         }
         else
         {
@@ -238,9 +240,21 @@ namespace Resource
         return loaded;
     }
 
+    KeyframeManager::~KeyframeManager()
+    {
+        const NifOsg::KeyframeCompressionStats compression = NifOsg::Loader::getKeyframeCompressionStats();
+        if (compression.mOriginalSize != 0)
+            Log(Debug::Info) << "Compressed keyframes from " << compression.mOriginalSize << " to "
+                             << compression.mCompressedSize << " bytes";
+    }
+
     void KeyframeManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Keyframe", frameNumber, mCache->getStats(), *stats);
+
+        const NifOsg::KeyframeCompressionStats compression = NifOsg::Loader::getKeyframeCompressionStats();
+        stats->setAttribute(frameNumber, "Keyframe Uncompressed Size", static_cast<double>(compression.mOriginalSize));
+        stats->setAttribute(frameNumber, "Keyframe Compressed Size", static_cast<double>(compression.mCompressedSize));
     }
 
 }
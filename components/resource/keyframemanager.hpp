@@ -52,7 +52,7 @@ namespace Resource
     public:
         explicit KeyframeManager(const VFS::Manager* vfs, SceneManager* sceneManager, double expiryDelay,
             const ToUTF8::StatelessUtf8Encoder* encoder);
-        ~KeyframeManager() = default;
+        ~KeyframeManager();
 
         /// Retrieve a read-only keyframe resource by name (case-insensitive).
         /// @note Throws an exception if the resource is not found.
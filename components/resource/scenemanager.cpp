@@ -24,6 +24,7 @@
 #include <osgDB/SharedStateManager>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 
 #include <components/nifosg/controller.hpp>
 #include <components/nifosg/nifloader.hpp>
@@ -999,6 +1000,7 @@ namespace Resource
             return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
         else
         {
+            const Debug::Trace::Scope trace("SceneManager::getTemplate");
             osg::ref_ptr<osg::Node> loaded;
             try
             {
@@ -126,6 +126,27 @@ namespace Resource
                 "NavMesh Recast Water",
             };
 
+            constexpr std::string_view animation[] = {
+                "Morph Geometries",
+                "Morph Targets",
+                "Morph Vertices",
+                "Pose Cache Get",
+                "Pose Cache Hit",
+                "Keyframe Uncompressed Size",
+                "Keyframe Compressed Size",
+            };
+
+            constexpr std::string_view scripts[] = {
+                "Local Scripts Run",
+                "Local Scripts Skipped",
+                "Local Scripts Deferred",
+            };
+
+            constexpr std::string_view physics[] = {
+                "Physics Async Rays Queued",
+                "Physics Async Rays Cast",
+            };
+
             std::vector<std::string> statNames;
 
             for (std::string_view name : firstPage)
@@ -147,6 +168,24 @@ namespace Resource
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : animation)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : scripts)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : physics)
+                statNames.emplace_back(name);
+
             return statNames;
         }
 
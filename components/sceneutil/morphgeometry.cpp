@@ -2,11 +2,67 @@
 
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <components/resource/scenemanager.hpp>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        // Contribution of a target with a smaller weight is below what is visible on screen.
+        constexpr float minMorphWeight = 1e-4f;
+
+        std::atomic<std::size_t> sMorphedGeometries{ 0 };
+        std::atomic<std::size_t> sMorphedTargets{ 0 };
+        std::atomic<std::size_t> sMorphedVertices{ 0 };
+
+        std::shared_ptr<const MorphGeometry::SparseOffsets> makeSparseOffsets(const osg::Vec3Array* offsets)
+        {
+            if (offsets == nullptr)
+                return nullptr;
+
+            auto result = std::make_shared<MorphGeometry::SparseOffsets>();
+            for (unsigned int i = 0; i < offsets->size(); ++i)
+            {
+                const osg::Vec3f& offset = (*offsets)[i];
+                if (offset == osg::Vec3f())
+                    continue;
+                // Scattered writes are slower than a dense vectorized pass once many vertices are moved.
+                if (result->mIndices.size() >= offsets->size() / 2)
+                    return nullptr;
+                result->mIndices.push_back(i);
+                result->mDeltas.push_back(offset);
+            }
+
+            return result;
+        }
+
+        // Works on the underlying float arrays so the loop can be vectorized by the compiler.
+        void addScaled(const osg::Vec3f* src, float weight, std::size_t count, osg::Vec3f* dst)
+        {
+            static_assert(sizeof(osg::Vec3f) == 3 * sizeof(float));
+            const float* from = src->ptr();
+            float* to = dst->ptr();
+            for (std::size_t i = 0, n = count * 3; i < n; ++i)
+                to[i] += from[i] * weight;
+        }
+    }
+
+    MorphGeometry::MorphTarget::MorphTarget(osg::Vec3Array* offsets, float w)
+        : mOffsets(offsets)
+        , mSparseOffsets(makeSparseOffsets(offsets))
+        , mWeight(w)
+    {
+    }
+
+    void MorphGeometry::MorphTarget::setOffsets(osg::Vec3Array* offsets)
+    {
+        mOffsets = offsets;
+        mSparseOffsets = makeSparseOffsets(offsets);
+    }
 
     MorphGeometry::MorphGeometry()
         : mLastFrameNumber(0)
@@ -185,21 +241,8 @@ namespace SceneUtil
         mLastFrameNumber = nv->getTraversalNumber();
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
-        const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
         osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        assert(positionSrc->size() == positionDst->size());
-        for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-            (*positionDst)[vertex] = (*positionSrc)[vertex];
-
-        for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
-        {
-            float weight = mMorphTargets[i].getWeight();
-            if (weight == 0.f)
-                continue;
-            const osg::Vec3Array* offsets = mMorphTargets[i].getOffsets();
-            for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-                (*positionDst)[vertex] += (*offsets)[vertex] * weight;
-        }
+        blend(*positionDst);
 
         positionDst->dirty();
 
@@ -210,9 +253,61 @@ namespace SceneUtil
         nv->popFromNodePath();
     }
 
+    void MorphGeometry::blend(osg::Vec3Array& positionDst) const
+    {
+        const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
+        assert(positionSrc->size() == positionDst.size());
+        const std::size_t numVertices = positionSrc->size();
+        if (numVertices == 0)
+            return;
+
+        std::copy(positionSrc->begin(), positionSrc->end(), positionDst.begin());
+
+        std::size_t numTargets = 0;
+        std::size_t numMorphedVertices = numVertices;
+
+        for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
+        {
+            const MorphTarget& target = mMorphTargets[i];
+            const float weight = target.getWeight();
+            if (std::abs(weight) < minMorphWeight)
+                continue;
+
+            ++numTargets;
+
+            if (const SparseOffsets* sparse = target.getSparseOffsets())
+            {
+                const std::size_t count = sparse->mIndices.size();
+                for (std::size_t j = 0; j < count; ++j)
+                    positionDst[sparse->mIndices[j]] += sparse->mDeltas[j] * weight;
+                numMorphedVertices += count;
+            }
+            else
+            {
+                const osg::Vec3Array& offsets = *target.getOffsets();
+                const std::size_t count = std::min<std::size_t>(offsets.size(), numVertices);
+                addScaled(&offsets.front(), weight, count, &positionDst.front());
+                numMorphedVertices += count;
+            }
+        }
+
+        sMorphedGeometries.fetch_add(1, std::memory_order_relaxed);
+        sMorphedTargets.fetch_add(numTargets, std::memory_order_relaxed);
+        sMorphedVertices.fetch_add(numMorphedVertices, std::memory_order_relaxed);
+    }
+
     osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
     {
         return mGeometry[frame % 2];
     }
 
+    MorphStats takeMorphStats()
+    {
+        MorphStats result;
+        result.mGeometries = sMorphedGeometries.exchange(0, std::memory_order_relaxed);
+        result.mTargets = sMorphedTargets.exchange(0, std::memory_order_relaxed);
+        result.mVertices = sMorphedVertices.exchange(0, std::memory_order_relaxed);
+        return result;
+    }
+
 }
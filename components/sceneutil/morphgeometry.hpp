@@ -3,6 +3,10 @@
 
 #include <osg/Geometry>
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 namespace SceneUtil
 {
 
@@ -27,23 +31,31 @@ namespace SceneUtil
         // static parts of the model.
         void compileGLObjects(osg::RenderInfo& renderInfo) const override {}
 
+        /// Non-zero offsets of a morph target stored as vertex index and delta pairs. Most morph targets only move
+        /// a small part of the mesh (e.g. the mouth of a head), so blending only these is much cheaper.
+        struct SparseOffsets
+        {
+            std::vector<unsigned int> mIndices;
+            std::vector<osg::Vec3f> mDeltas;
+        };
+
         class MorphTarget
         {
         protected:
             osg::ref_ptr<osg::Vec3Array> mOffsets;
+            // Shared between clones of the same geometry, null when the target is too dense to benefit from it.
+            std::shared_ptr<const SparseOffsets> mSparseOffsets;
             float mWeight;
 
         public:
-            MorphTarget(osg::Vec3Array* offsets, float w = 1.0)
-                : mOffsets(offsets)
-                , mWeight(w)
-            {
-            }
+            MorphTarget(osg::Vec3Array* offsets, float w = 1.0);
             void setWeight(float weight) { mWeight = weight; }
             float getWeight() const { return mWeight; }
+            /// @note If you modify the returned array you will have to call setOffsets() to update the sparse data.
             osg::Vec3Array* getOffsets() { return mOffsets.get(); }
             const osg::Vec3Array* getOffsets() const { return mOffsets.get(); }
-            void setOffsets(osg::Vec3Array* offsets) { mOffsets = offsets; }
+            void setOffsets(osg::Vec3Array* offsets);
+            const SparseOffsets* getSparseOffsets() const { return mSparseOffsets.get(); }
         };
 
         typedef std::vector<MorphTarget> MorphTargetList;
@@ -76,6 +88,8 @@ namespace SceneUtil
     private:
         void cull(osg::NodeVisitor* nv);
 
+        void blend(osg::Vec3Array& positionDst) const;
+
         MorphTargetList mMorphTargets;
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
@@ -89,6 +103,16 @@ namespace SceneUtil
         mutable bool mMorphedBoundingBox;
     };
 
+    struct MorphStats
+    {
+        std::size_t mGeometries = 0;
+        std::size_t mTargets = 0;
+        std::size_t mVertices = 0;
+    };
+
+    /// Returns the amount of morphing work done by all MorphGeometries since the previous call and resets it.
+    MorphStats takeMorphStats();
+
 }
 
 #endif
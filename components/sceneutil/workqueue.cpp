@@ -1,6 +1,7 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/trace.hpp>
 
 #include <numeric>
 
@@ -125,6 +126,7 @@ namespace SceneUtil
 
     void WorkThread::run()
     {
+        Debug::Trace::setThreadName("Work queue");
         while (true)
         {
             osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
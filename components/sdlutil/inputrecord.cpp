@@ -0,0 +1,145 @@
+#include "inputrecord.hpp"
+
+#include <components/files/conversion.hpp>
+
+#include <SDL_version.h>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace SDLUtil
+{
+    namespace
+    {
+        constexpr std::array<char, 8> magic{ 'O', 'M', 'W', 'I', 'N', 'P', 'U', 'T' };
+        constexpr std::uint32_t version = 3;
+
+        template <class T>
+        void writeValue(std::ofstream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        bool readValue(std::ifstream& stream, T& value)
+        {
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return stream.gcount() == static_cast<std::streamsize>(sizeof(value));
+        }
+
+        std::string toString(const SDL_version& value)
+        {
+            return std::to_string(value.major) + "." + std::to_string(value.minor) + "." + std::to_string(value.patch);
+        }
+
+        std::runtime_error makeError(const std::filesystem::path& path, const std::string& message)
+        {
+            return std::runtime_error("Input record \"" + Files::pathToUnicodeString(path) + "\" " + message);
+        }
+    }
+
+    bool isRecordable(const SDL_Event& event)
+    {
+        switch (event.type)
+        {
+            case SDL_SYSWMEVENT:
+            case SDL_DROPFILE:
+            case SDL_DROPTEXT:
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+            case SDL_TEXTEDITING_EXT:
+#endif
+                return false;
+            default:
+                return event.type < SDL_USEREVENT;
+        }
+    }
+
+    InputRecordWriter::InputRecordWriter(const std::filesystem::path& path, std::uint32_t seed)
+        : mPath(path)
+        , mStream(path, std::ios::binary)
+    {
+        if (!mStream.is_open())
+            throw makeError(mPath, "can't be opened for writing");
+        mStream.write(magic.data(), magic.size());
+        writeValue(mStream, version);
+        writeValue(mStream, static_cast<std::uint32_t>(sizeof(SDL_Event)));
+        SDL_version sdlVersion;
+        SDL_GetVersion(&sdlVersion);
+        writeValue(mStream, sdlVersion.major);
+        writeValue(mStream, sdlVersion.minor);
+        writeValue(mStream, sdlVersion.patch);
+        writeValue(mStream, seed);
+    }
+
+    void InputRecordWriter::write(float duration, std::span<const SDL_Event> events, std::span<const InputPoll> polls)
+    {
+        writeValue(mStream, duration);
+        writeValue(mStream, static_cast<std::uint32_t>(events.size()));
+        mStream.write(reinterpret_cast<const char*>(events.data()), events.size_bytes());
+        writeValue(mStream, static_cast<std::uint32_t>(polls.size()));
+        for (const InputPoll& poll : polls)
+        {
+            writeValue(mStream, static_cast<std::uint32_t>(poll.mType));
+            writeValue(mStream, poll.mValue);
+        }
+        if (!mStream.good())
+            throw makeError(mPath, "write has failed");
+    }
+
+    InputRecordReader::InputRecordReader(const std::filesystem::path& path)
+        : mPath(path)
+        , mStream(path, std::ios::binary)
+    {
+        if (!mStream.is_open())
+            throw makeError(mPath, "can't be opened for reading");
+        std::array<char, magic.size()> fileMagic;
+        std::uint32_t fileVersion = 0;
+        std::uint32_t eventSize = 0;
+        SDL_version fileSdlVersion{};
+        mStream.read(fileMagic.data(), fileMagic.size());
+        if (mStream.gcount() != static_cast<std::streamsize>(fileMagic.size()) || fileMagic != magic)
+            throw makeError(mPath, "has invalid format");
+        if (!readValue(mStream, fileVersion) || fileVersion != version)
+            throw makeError(mPath, "has unsupported version " + std::to_string(fileVersion));
+        if (!readValue(mStream, eventSize) || !readValue(mStream, fileSdlVersion.major)
+            || !readValue(mStream, fileSdlVersion.minor) || !readValue(mStream, fileSdlVersion.patch))
+            throw makeError(mPath, "is truncated");
+        // Layout of events may change between any versions even when their size is the same
+        SDL_version sdlVersion;
+        SDL_GetVersion(&sdlVersion);
+        if (eventSize != sizeof(SDL_Event) || fileSdlVersion.major != sdlVersion.major
+            || fileSdlVersion.minor != sdlVersion.minor || fileSdlVersion.patch != sdlVersion.patch)
+            throw makeError(
+                mPath, "is written by SDL " + toString(fileSdlVersion) + " but " + toString(sdlVersion) + " is used");
+        if (!readValue(mStream, mSeed))
+            throw makeError(mPath, "is truncated");
+    }
+
+    bool InputRecordReader::read(InputRecordFrame& frame)
+    {
+        std::uint32_t count = 0;
+        if (!readValue(mStream, frame.mDuration))
+            return false;
+        if (!readValue(mStream, count))
+            throw makeError(mPath, "is truncated");
+        frame.mEvents.resize(count);
+        const auto size = static_cast<std::streamsize>(count * sizeof(SDL_Event));
+        mStream.read(reinterpret_cast<char*>(frame.mEvents.data()), size);
+        if (mStream.gcount() != size)
+            throw makeError(mPath, "is truncated");
+        if (!readValue(mStream, count))
+            throw makeError(mPath, "is truncated");
+        frame.mPolls.resize(count);
+        for (InputPoll& poll : frame.mPolls)
+        {
+            std::uint32_t type = 0;
+            if (!readValue(mStream, type) || !readValue(mStream, poll.mValue))
+                throw makeError(mPath, "is truncated");
+            if (type > static_cast<std::uint32_t>(InputPollType::ControllerButton))
+                throw makeError(mPath, "has invalid input state type " + std::to_string(type));
+            poll.mType = static_cast<InputPollType>(type);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef OPENMW_COMPONENTS_SDLUTIL_INPUTRECORD_H
+#define OPENMW_COMPONENTS_SDLUTIL_INPUTRECORD_H
+
+#include <SDL_events.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace SDLUtil
+{
+    /// Events referring to memory owned by SDL can't be written into a record
+    bool isRecordable(const SDL_Event& event);
+
+    /// Input state queried instead of being received as events
+    enum class InputPollType : std::uint32_t
+    {
+        RelativeMouseX,
+        RelativeMouseY,
+        ModState,
+        Key,
+        ControllerAxis,
+        ControllerButton,
+    };
+
+    struct InputPoll
+    {
+        InputPollType mType;
+        std::int32_t mValue;
+    };
+
+    struct InputRecordFrame
+    {
+        float mDuration = 0;
+        std::vector<SDL_Event> mEvents;
+        std::vector<InputPoll> mPolls;
+    };
+
+    /// \brief Writes a session record: random seed followed by duration, input events and results of input state
+    /// queries of each frame.
+    ///
+    /// Events are stored as is, so a record can be replayed only by a build using the same SDL version.
+    class InputRecordWriter
+    {
+    public:
+        explicit InputRecordWriter(const std::filesystem::path& path, std::uint32_t seed);
+
+        void write(float duration, std::span<const SDL_Event> events, std::span<const InputPoll> polls);
+
+    private:
+        std::filesystem::path mPath;
+        std::ofstream mStream;
+    };
+
+    class InputRecordReader
+    {
+    public:
+        explicit InputRecordReader(const std::filesystem::path& path);
+
+        std::uint32_t getSeed() const { return mSeed; }
+
+        /// Returns false when there are no more frames
+        bool read(InputRecordFrame& frame);
+
+    private:
+        std::filesystem::path mPath;
+        std::ifstream mStream;
+        std::uint32_t mSeed = 0;
+    };
+}
+
+#endif
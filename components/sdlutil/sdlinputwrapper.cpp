@@ -1,5 +1,7 @@
 #include "sdlinputwrapper.hpp"
 
+#include "inputrecord.hpp"
+
 #include <components/debug/debuglog.hpp>
 #include <components/settings/values.hpp>
 
@@ -32,6 +34,10 @@ namespace SDLUtil
         , mMouseY(0)
         , mWindowHasFocus(true)
         , mMouseInWindow(true)
+        , mRecord(false)
+        , mReplay(false)
+        , mNextReplayedPoll(0)
+        , mReplayedPollsMismatch(false)
     {
         Uint32 flags = SDL_GetWindowFlags(mSDLWindow);
         mWindowHasFocus = (flags & SDL_WINDOW_INPUT_FOCUS);
@@ -63,7 +69,13 @@ namespace SDLUtil
         {
             // During loading, handle window events, discard button presses and mouse movement and keep others for later
             while (SDL_PeepEvents(&evt, 1, SDL_GETEVENT, SDL_WINDOWEVENT, SDL_WINDOWEVENT) > 0)
+            {
+                if (mReplay)
+                    continue;
+                if (mRecord)
+                    mRecordedEvents.push_back(evt);
                 handleWindowEvent(evt);
+            }
 
             SDL_FlushEvent(SDL_KEYDOWN);
             SDL_FlushEvent(SDL_CONTROLLERBUTTONDOWN);
@@ -71,6 +83,24 @@ namespace SDLUtil
             SDL_FlushEvent(SDL_MOUSEMOTION);
             SDL_FlushEvent(SDL_MOUSEWHEEL);
 
+            // Replayed events are treated the same way as the real ones
+            std::erase_if(mReplayedEvents, [&](const SDL_Event& replayed) {
+                switch (replayed.type)
+                {
+                    case SDL_WINDOWEVENT:
+                        handleWindowEvent(replayed);
+                        return true;
+                    case SDL_KEYDOWN:
+                    case SDL_CONTROLLERBUTTONDOWN:
+                    case SDL_MOUSEBUTTONDOWN:
+                    case SDL_MOUSEMOTION:
+                    case SDL_MOUSEWHEEL:
+                        return true;
+                    default:
+                        return false;
+                }
+            });
+
             return;
         }
 
@@ -88,156 +118,170 @@ namespace SDLUtil
             if (evt.type > SDL_SYSWMEVENT && evt.type < SDL_KEYDOWN)
                 continue;
 #endif
-            switch (evt.type)
-            {
-                case SDL_MOUSEMOTION:
-                    // Ignore this if it happened due to a warp
-                    if (!_handleWarpMotion(evt.motion))
-                    {
-                        // If in relative mode, don't trigger events unless window has focus
-                        if (!mWantRelative || mWindowHasFocus)
-                            mMouseListener->mouseMoved(_packageMouseMotion(evt));
-
-                        // Try to keep the mouse inside the window
-                        if (mWindowHasFocus)
-                            _wrapMousePointer(evt.motion);
-                    }
-                    break;
-                case SDL_MOUSEWHEEL:
-                    mMouseListener->mouseMoved(_packageMouseMotion(evt));
-                    mMouseListener->mouseWheelMoved(evt.wheel);
-                    break;
-                case SDL_SENSORUPDATE:
-                    mSensorListener->sensorUpdated(evt.sensor);
-                    break;
-                case SDL_MOUSEBUTTONDOWN:
-                    mMouseListener->mousePressed(evt.button, evt.button.button);
-                    break;
-                case SDL_MOUSEBUTTONUP:
-                    mMouseListener->mouseReleased(evt.button, evt.button.button);
-                    break;
-                case SDL_KEYDOWN:
-                    mKeyboardListener->keyPressed(evt.key);
+            // Replayed events replace the real ones, only closing the window is still possible
+            if (mReplay && evt.type != SDL_QUIT)
+                continue;
+
+            if (mRecord && isRecordable(evt))
+                mRecordedEvents.push_back(evt);
+
+            handleEvent(evt);
+        }
+
+        for (const SDL_Event& replayed : mReplayedEvents)
+            handleEvent(replayed);
+
+        mReplayedEvents.clear();
+    }
+
+    void InputWrapper::handleEvent(const SDL_Event& evt)
+    {
+        switch (evt.type)
+        {
+            case SDL_MOUSEMOTION:
+                // Ignore this if it happened due to a warp
+                if (!_handleWarpMotion(evt.motion))
+                {
+                    // If in relative mode, don't trigger events unless window has focus
+                    if (!mWantRelative || mWindowHasFocus)
+                        mMouseListener->mouseMoved(_packageMouseMotion(evt));
+
+                    // Try to keep the mouse inside the window
+                    if (mWindowHasFocus)
+                        _wrapMousePointer(evt.motion);
+                }
+                break;
+            case SDL_MOUSEWHEEL:
+                mMouseListener->mouseMoved(_packageMouseMotion(evt));
+                mMouseListener->mouseWheelMoved(evt.wheel);
+                break;
+            case SDL_SENSORUPDATE:
+                mSensorListener->sensorUpdated(evt.sensor);
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+                mMouseListener->mousePressed(evt.button, evt.button.button);
+                break;
+            case SDL_MOUSEBUTTONUP:
+                mMouseListener->mouseReleased(evt.button, evt.button.button);
+                break;
+            case SDL_KEYDOWN:
+                mKeyboardListener->keyPressed(evt.key);
+
+                if (!isModifierHeld(KMOD_ALT) && evt.key.keysym.sym >= SDLK_F1 && evt.key.keysym.sym <= SDLK_F12)
+                {
+                    mViewer->getEventQueue()->keyPress(osgGA::GUIEventAdapter::KEY_F1 + (evt.key.keysym.sym - SDLK_F1));
+                }
+
+                break;
+            case SDL_KEYUP:
+                if (!evt.key.repeat)
+                {
+                    mKeyboardListener->keyReleased(evt.key);
 
                     if (!isModifierHeld(KMOD_ALT) && evt.key.keysym.sym >= SDLK_F1 && evt.key.keysym.sym <= SDLK_F12)
-                    {
-                        mViewer->getEventQueue()->keyPress(
+                        mViewer->getEventQueue()->keyRelease(
                             osgGA::GUIEventAdapter::KEY_F1 + (evt.key.keysym.sym - SDLK_F1));
-                    }
-
-                    break;
-                case SDL_KEYUP:
-                    if (!evt.key.repeat)
-                    {
-                        mKeyboardListener->keyReleased(evt.key);
-
-                        if (!isModifierHeld(KMOD_ALT) && evt.key.keysym.sym >= SDLK_F1
-                            && evt.key.keysym.sym <= SDLK_F12)
-                            mViewer->getEventQueue()->keyRelease(
-                                osgGA::GUIEventAdapter::KEY_F1 + (evt.key.keysym.sym - SDLK_F1));
-                    }
-
-                    break;
-                case SDL_TEXTEDITING:
-                    break;
-                case SDL_TEXTINPUT:
-                    mKeyboardListener->textInput(evt.text);
-                    break;
-                case SDL_KEYMAPCHANGED:
-                    break;
-                case SDL_JOYHATMOTION: // As we manage everything with GameController, don't even bother with these.
-                case SDL_JOYAXISMOTION:
-                case SDL_JOYBUTTONDOWN:
-                case SDL_JOYBUTTONUP:
-                case SDL_JOYDEVICEADDED:
-                case SDL_JOYDEVICEREMOVED:
-                    break;
-                case SDL_CONTROLLERDEVICEADDED:
-                    if (mConListener)
-                        mConListener->controllerAdded(
-                            1, evt.cdevice); // We only support one joystick, so give everything a generic deviceID
-                    break;
-                case SDL_CONTROLLERDEVICEREMOVED:
-                    if (mConListener)
-                        mConListener->controllerRemoved(evt.cdevice);
-                    break;
-                case SDL_CONTROLLERBUTTONDOWN:
-                    if (mConListener)
-                        mConListener->buttonPressed(1, evt.cbutton);
-                    break;
-                case SDL_CONTROLLERBUTTONUP:
-                    if (mConListener)
-                        mConListener->buttonReleased(1, evt.cbutton);
-                    break;
-                case SDL_CONTROLLERAXISMOTION:
-                    if (mConListener)
-                        mConListener->axisMoved(1, evt.caxis);
-                    break;
-                case SDL_CONTROLLERSENSORUPDATE:
-                    // controller sensor data is received on demand
-                    break;
-                case SDL_CONTROLLERTOUCHPADDOWN:
-                    mConListener->touchpadPressed(1, TouchEvent(evt.ctouchpad));
-                    break;
-                case SDL_CONTROLLERTOUCHPADMOTION:
-                    mConListener->touchpadMoved(1, TouchEvent(evt.ctouchpad));
-                    break;
-                case SDL_CONTROLLERTOUCHPADUP:
-                    mConListener->touchpadReleased(1, TouchEvent(evt.ctouchpad));
-                    break;
-                case SDL_WINDOWEVENT:
-                    handleWindowEvent(evt);
-                    break;
-                case SDL_QUIT:
-                    if (mWindowListener)
-                        mWindowListener->windowClosed();
-                    break;
-                case SDL_DISPLAYEVENT:
-                    switch (evt.display.event)
-                    {
-                        case SDL_DISPLAYEVENT_ORIENTATION:
-                            if (mSensorListener
-                                && evt.display.display == static_cast<Uint32>(Settings::video().mScreen))
-                            {
-                                mSensorListener->displayOrientationChanged();
-                            }
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                case SDL_CLIPBOARDUPDATE:
-                    break; // We don't need this event, clipboard is retrieved on demand
-
-                case SDL_FINGERDOWN:
-                case SDL_FINGERUP:
-                case SDL_FINGERMOTION:
-                case SDL_DOLLARGESTURE:
-                case SDL_DOLLARRECORD:
-                case SDL_MULTIGESTURE:
-                    // No use for touch & gesture events
-                    break;
-
-                case SDL_APP_WILLENTERBACKGROUND:
-                case SDL_APP_WILLENTERFOREGROUND:
-                case SDL_APP_DIDENTERBACKGROUND:
-                case SDL_APP_DIDENTERFOREGROUND:
-                    // We do not need background/foreground switch event for mobile devices so far
-                    break;
-
-                case SDL_APP_TERMINATING:
-                    // There is nothing we can do here.
-                    break;
-
-                case SDL_APP_LOWMEMORY:
-                    Log(Debug::Warning) << "System reports that free RAM on device is running low. You may encounter "
-                                           "an unexpected behaviour.";
-                    break;
-
-                default:
-                    Log(Debug::Info) << "Unhandled SDL event of type 0x" << std::hex << evt.type;
-                    break;
-            }
+                }
+
+                break;
+            case SDL_TEXTEDITING:
+                break;
+            case SDL_TEXTINPUT:
+                mKeyboardListener->textInput(evt.text);
+                break;
+            case SDL_KEYMAPCHANGED:
+                break;
+            case SDL_JOYHATMOTION: // As we manage everything with GameController, don't even bother with these.
+            case SDL_JOYAXISMOTION:
+            case SDL_JOYBUTTONDOWN:
+            case SDL_JOYBUTTONUP:
+            case SDL_JOYDEVICEADDED:
+            case SDL_JOYDEVICEREMOVED:
+                break;
+            case SDL_CONTROLLERDEVICEADDED:
+                if (mConListener)
+                    mConListener->controllerAdded(
+                        1, evt.cdevice); // We only support one joystick, so give everything a generic deviceID
+                break;
+            case SDL_CONTROLLERDEVICEREMOVED:
+                if (mConListener)
+                    mConListener->controllerRemoved(evt.cdevice);
+                break;
+            case SDL_CONTROLLERBUTTONDOWN:
+                if (mConListener)
+                    mConListener->buttonPressed(1, evt.cbutton);
+                break;
+            case SDL_CONTROLLERBUTTONUP:
+                if (mConListener)
+                    mConListener->buttonReleased(1, evt.cbutton);
+                break;
+            case SDL_CONTROLLERAXISMOTION:
+                if (mConListener)
+                    mConListener->axisMoved(1, evt.caxis);
+                break;
+            case SDL_CONTROLLERSENSORUPDATE:
+                // controller sensor data is received on demand
+                break;
+            case SDL_CONTROLLERTOUCHPADDOWN:
+                mConListener->touchpadPressed(1, TouchEvent(evt.ctouchpad));
+                break;
+            case SDL_CONTROLLERTOUCHPADMOTION:
+                mConListener->touchpadMoved(1, TouchEvent(evt.ctouchpad));
+                break;
+            case SDL_CONTROLLERTOUCHPADUP:
+                mConListener->touchpadReleased(1, TouchEvent(evt.ctouchpad));
+                break;
+            case SDL_WINDOWEVENT:
+                handleWindowEvent(evt);
+                break;
+            case SDL_QUIT:
+                if (mWindowListener)
+                    mWindowListener->windowClosed();
+                break;
+            case SDL_DISPLAYEVENT:
+                switch (evt.display.event)
+                {
+                    case SDL_DISPLAYEVENT_ORIENTATION:
+                        if (mSensorListener && evt.display.display == static_cast<Uint32>(Settings::video().mScreen))
+                        {
+                            mSensorListener->displayOrientationChanged();
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case SDL_CLIPBOARDUPDATE:
+                break; // We don't need this event, clipboard is retrieved on demand
+
+            case SDL_FINGERDOWN:
+            case SDL_FINGERUP:
+            case SDL_FINGERMOTION:
+            case SDL_DOLLARGESTURE:
+            case SDL_DOLLARRECORD:
+            case SDL_MULTIGESTURE:
+                // No use for touch & gesture events
+                break;
+
+            case SDL_APP_WILLENTERBACKGROUND:
+            case SDL_APP_WILLENTERFOREGROUND:
+            case SDL_APP_DIDENTERBACKGROUND:
+            case SDL_APP_DIDENTERFOREGROUND:
+                // We do not need background/foreground switch event for mobile devices so far
+                break;
+
+            case SDL_APP_TERMINATING:
+                // There is nothing we can do here.
+                break;
+
+            case SDL_APP_LOWMEMORY:
+                Log(Debug::Warning) << "System reports that free RAM on device is running low. You may encounter "
+                                       "an unexpected behaviour.";
+                break;
+
+            default:
+                Log(Debug::Info) << "Unhandled SDL event of type 0x" << std::hex << evt.type;
+                break;
         }
     }
 
@@ -305,14 +349,65 @@ namespace SDLUtil
         }
     }
 
+    template <class Function>
+    std::int32_t InputWrapper::poll(InputPollType type, Function&& function)
+    {
+        if (mReplay)
+        {
+            if (mNextReplayedPoll < mReplayedPolls.size() && mReplayedPolls[mNextReplayedPoll].mType == type)
+                return mReplayedPolls[mNextReplayedPoll++].mValue;
+            if (!mReplayedPollsMismatch)
+                Log(Debug::Warning) << "Input state queries don't match the replayed record, neutral state is used";
+            mReplayedPollsMismatch = true;
+            return 0;
+        }
+
+        const std::int32_t value = function();
+        if (mRecord)
+            mRecordedPolls.push_back(InputPoll{ type, value });
+        return value;
+    }
+
+    void InputWrapper::setReplayedPolls(std::span<const InputPoll> polls)
+    {
+        mReplayedPolls.assign(polls.begin(), polls.end());
+        mNextReplayedPoll = 0;
+    }
+
     bool InputWrapper::isModifierHeld(int mod)
     {
-        return (SDL_GetModState() & mod) != 0;
+        return (poll(InputPollType::ModState, [] { return static_cast<std::int32_t>(SDL_GetModState()); }) & mod) != 0;
     }
 
     bool InputWrapper::isKeyDown(SDL_Scancode key)
     {
-        return (SDL_GetKeyboardState(nullptr)[key]) != 0;
+        return poll(InputPollType::Key, [&] { return static_cast<std::int32_t>(SDL_GetKeyboardState(nullptr)[key]); })
+            != 0;
+    }
+
+    void InputWrapper::getRelativeMouseState(int& x, int& y)
+    {
+        // Reading resets the state, so both coordinates have to be read at once
+        int moveX = 0;
+        int moveY = 0;
+        if (!mReplay)
+            SDL_GetRelativeMouseState(&moveX, &moveY);
+        x = poll(InputPollType::RelativeMouseX, [&] { return moveX; });
+        y = poll(InputPollType::RelativeMouseY, [&] { return moveY; });
+    }
+
+    Sint16 InputWrapper::getControllerAxis(SDL_GameController* controller, SDL_GameControllerAxis axis)
+    {
+        return static_cast<Sint16>(poll(InputPollType::ControllerAxis, [&]() -> std::int32_t {
+            return controller != nullptr ? SDL_GameControllerGetAxis(controller, axis) : 0;
+        }));
+    }
+
+    bool InputWrapper::isControllerButtonDown(SDL_GameController* controller, SDL_GameControllerButton button)
+    {
+        return poll(InputPollType::ControllerButton, [&]() -> std::int32_t {
+            return controller != nullptr ? SDL_GameControllerGetButton(controller, button) : 0;
+        }) != 0;
     }
 
     /// \brief Moves the mouse to the specified point within the viewport
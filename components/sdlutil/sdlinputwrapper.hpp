@@ -4,9 +4,17 @@
 #include <osg/ref_ptr>
 
 #include <SDL_events.h>
+#include <SDL_gamecontroller.h>
 #include <SDL_version.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
 #include "events.hpp"
+#include "inputrecord.hpp"
 
 namespace osgViewer
 {
@@ -32,6 +40,13 @@ namespace SDLUtil
         bool isModifierHeld(int mod);
         bool isKeyDown(SDL_Scancode key);
 
+        /// Mouse movement since the previous call
+        void getRelativeMouseState(int& x, int& y);
+
+        /// Neutral state is returned for a null controller
+        Sint16 getControllerAxis(SDL_GameController* controller, SDL_GameControllerAxis axis);
+        bool isControllerButtonDown(SDL_GameController* controller, SDL_GameControllerButton button);
+
         void setMouseVisible(bool visible);
         void setMouseRelative(bool relative);
         bool getMouseRelative() { return mMouseRelative; }
@@ -41,7 +56,22 @@ namespace SDLUtil
 
         void updateMouseSettings();
 
+        /// Keep handled events and results of input state queries to be written into an input record
+        void setRecord(bool record) { mRecord = record; }
+        std::vector<SDL_Event> takeRecordedEvents() { return std::exchange(mRecordedEvents, {}); }
+        std::vector<InputPoll> takeRecordedPolls() { return std::exchange(mRecordedPolls, {}); }
+
+        /// Ignore events from the user and handle the replayed ones on next capture instead. Input state queries
+        /// return replayed results in the recorded order.
+        void setReplay(bool replay) { mReplay = replay; }
+        void addReplayedEvents(std::span<const SDL_Event> events)
+        {
+            mReplayedEvents.insert(mReplayedEvents.end(), events.begin(), events.end());
+        }
+        void setReplayedPolls(std::span<const InputPoll> polls);
+
     private:
+        void handleEvent(const SDL_Event& evt);
         void handleWindowEvent(const SDL_Event& evt);
 
         bool _handleWarpMotion(const SDL_MouseMotionEvent& evt);
@@ -49,6 +79,9 @@ namespace SDLUtil
         MouseMotionEvent _packageMouseMotion(const SDL_Event& evt);
         void _setWindowScale();
 
+        template <class Function>
+        std::int32_t poll(InputPollType type, Function&& function);
+
         SDL_Window* mSDLWindow;
         osg::ref_ptr<osgViewer::Viewer> mViewer;
 
@@ -81,6 +114,15 @@ namespace SDLUtil
 
         Uint16 mScaleX;
         Uint16 mScaleY;
+
+        bool mRecord;
+        bool mReplay;
+        std::vector<SDL_Event> mRecordedEvents;
+        std::vector<SDL_Event> mReplayedEvents;
+        std::vector<InputPoll> mRecordedPolls;
+        std::vector<InputPoll> mReplayedPolls;
+        std::size_t mNextReplayedPoll;
+        bool mReplayedPollsMismatch;
     };
 
 }
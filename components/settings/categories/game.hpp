@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Settings
 {
@@ -40,6 +41,8 @@ namespace Settings
         SettingValue<bool> mRebalanceSoulGemValues{ mIndex, "Game", "rebalance soul gem values" };
         SettingValue<bool> mUseAdditionalAnimSources{ mIndex, "Game", "use additional anim sources" };
         SettingValue<bool> mSmoothAnimTransitions{ mIndex, "Game", "smooth animation transitions" };
+        SettingValue<float> mAnimationPoseCacheTimeStep{ mIndex, "Game", "animation pose cache time step",
+            makeMaxSanitizerFloat(0) };
         SettingValue<bool> mBarterDispositionChangeIsPermanent{ mIndex, "Game",
             "barter disposition change is permanent" };
         SettingValue<int> mStrengthInfluencesHandToHand{ mIndex, "Game", "strength influences hand to hand",
@@ -74,6 +77,14 @@ namespace Settings
         SettingValue<DetourNavigator::CollisionShapeType> mActorCollisionShapeType{ mIndex, "Game",
             "actor collision shape type" };
         SettingValue<bool> mPlayerMovementIgnoresAnimation{ mIndex, "Game", "player movement ignores animation" };
+        SettingValue<bool> mScheduleLocalScripts{ mIndex, "Game", "schedule local scripts" };
+        SettingValue<float> mLocalScriptsFullRateDistance{ mIndex, "Game", "local scripts full rate distance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mThrottleIdleLocalScripts{ mIndex, "Game", "throttle idle local scripts" };
+        SettingValue<float> mLocalScriptsFrameBudget{ mIndex, "Game", "local scripts frame budget",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<std::vector<std::string>> mUnscheduledLocalScripts{ mIndex, "Game",
+            "unscheduled local scripts" };
     };
 }
 
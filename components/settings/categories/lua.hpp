@@ -21,12 +21,18 @@ namespace Settings
         SettingValue<bool> mLuaDebug{ mIndex, "Lua", "lua debug" };
         SettingValue<int> mLuaNumThreads{ mIndex, "Lua", "lua num threads", makeEnumSanitizerInt({ 0, 1 }) };
         SettingValue<bool> mLuaProfiler{ mIndex, "Lua", "lua profiler" };
+        SettingValue<bool> mLuaProfilerSampling{ mIndex, "Lua", "lua profiler sampling" };
+        SettingValue<float> mLuaProfilerWindow{ mIndex, "Lua", "lua profiler window", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<std::string> mLuaProfilerOutput{ mIndex, "Lua", "lua profiler output" };
         SettingValue<std::uint64_t> mSmallAllocMaxSize{ mIndex, "Lua", "small alloc max size" };
         SettingValue<std::uint64_t> mMemoryLimit{ mIndex, "Lua", "memory limit" };
         SettingValue<bool> mLogMemoryUsage{ mIndex, "Lua", "log memory usage" };
         SettingValue<std::uint64_t> mInstructionLimitPerCall{ mIndex, "Lua", "instruction limit per call",
             makeMaxSanitizerUInt64(1001) };
         SettingValue<int> mGcStepsPerFrame{ mIndex, "Lua", "gc steps per frame", makeMaxSanitizerInt(0) };
+        SettingValue<int> mGcBudgetPerFrame{ mIndex, "Lua", "gc budget per frame", makeMaxSanitizerInt(0) };
+        SettingValue<int> mLocalScriptShards{ mIndex, "Lua", "local script shards", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mBytecodeCache{ mIndex, "Lua", "bytecode cache" };
     };
 }
 
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_SETTINGS_CATEGORIES_MODELS_H
 #define OPENMW_COMPONENTS_SETTINGS_CATEGORIES_MODELS_H
 
+#include <components/settings/sanitizerimpl.hpp>
 #include <components/settings/settingvalue.hpp>
 #include <components/vfs/pathutil.hpp>
 
@@ -11,6 +12,13 @@ namespace Settings
         using WithIndex::WithIndex;
 
         SettingValue<bool> mLoadUnsupportedNifFiles{ mIndex, "Models", "load unsupported nif files" };
+        SettingValue<bool> mCompressKeyframes{ mIndex, "Models", "compress keyframes" };
+        SettingValue<float> mKeyframeRotationTolerance{ mIndex, "Models", "keyframe rotation tolerance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mKeyframeTranslationTolerance{ mIndex, "Models", "keyframe translation tolerance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mKeyframeScaleTolerance{ mIndex, "Models", "keyframe scale tolerance",
+            makeMaxSanitizerFloat(0) };
         SettingValue<VFS::Path::Normalized> mXbaseanim{ mIndex, "Models", "xbaseanim" };
         SettingValue<VFS::Path::Normalized> mBaseanim{ mIndex, "Models", "baseanim" };
         SettingValue<VFS::Path::Normalized> mXbaseanim1st{ mIndex, "Models", "xbaseanim1st" };
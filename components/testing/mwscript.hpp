@@ -1,8 +1,11 @@
-#ifndef MWSCRIPT_TESTING_UTIL_H
-#define MWSCRIPT_TESTING_UTIL_H
+#ifndef OPENMW_COMPONENTS_TESTING_MWSCRIPT_H
+#define OPENMW_COMPONENTS_TESTING_MWSCRIPT_H
 
+#include <functional>
+#include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -22,7 +25,7 @@
 
 #include <components/misc/strings/algorithm.hpp>
 
-namespace
+namespace TestingOpenMW
 {
     class TestCompilerContext : public Compiler::Context
     {
@@ -264,6 +267,22 @@ namespace
         {
         }
     };
+
+    // Script doing arithmetic on local variables only, so it can be run by any context
+    inline const std::string sMathScript = R"mwscript(Begin math
+
+short a
+short b
+short c
+short d
+short e
+
+set b to ( a + 1 )
+set c to ( a - 1 )
+set d to ( b * c )
+set e to ( d / a )
+
+End)mwscript";
 }
 
 #endif
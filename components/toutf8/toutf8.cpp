@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <ios>
 #include <iterator>
 #include <stdexcept>
@@ -47,9 +48,36 @@ using namespace ToUTF8;
 
 namespace
 {
-    std::string_view::iterator skipAscii(std::string_view input)
+    constexpr std::size_t blockSize = 16;
+
+    // Check whether a block has neither a null terminator nor non-ascii characters. The block is checked by 64-bit
+    // words to not depend on platform specific SIMD instructions.
+    bool isAsciiBlock(const char* data)
     {
-        return std::find_if(input.begin(), input.end(), [](unsigned char v) { return v == 0 || v >= 128; });
+        constexpr std::uint64_t lowBits = 0x0101010101010101;
+        constexpr std::uint64_t highBits = 0x8080808080808080;
+
+        std::uint64_t first;
+        std::uint64_t second;
+        std::memcpy(&first, data, sizeof(first));
+        std::memcpy(&second, data + sizeof(first), sizeof(second));
+
+        // Subtraction sets the highest bit of a zero byte, borrow can affect only the bytes after it
+        return (((first - lowBits) | first | (second - lowBits) | second) & highBits) == 0;
+    }
+
+    // Return number of leading characters which are neither a null terminator nor non-ascii.
+    std::size_t skipAscii(std::string_view input)
+    {
+        std::size_t pos = 0;
+
+        while (input.size() - pos >= blockSize && isAsciiBlock(input.data() + pos))
+            pos += blockSize;
+
+        while (pos < input.size() && input[pos] != 0 && static_cast<unsigned char>(input[pos]) < 128)
+            ++pos;
+
+        return pos;
     }
 
     std::span<const signed char> getTranslationArray(FromType sourceEncoding)
@@ -126,9 +154,25 @@ std::string_view StatelessUtf8Encoder::getUtf8(
     resize(outlen, bufferAllocationPolicy, buffer);
     char* out = buffer.data();
 
-    // Translate
-    for (auto it = input.begin(); it != input.end() && *it != 0; ++it)
-        copyFromArray(*it, out);
+    // Translate, copying ascii blocks as is
+    for (std::size_t pos = 0; pos < input.size();)
+    {
+        if (input.size() - pos >= blockSize && isAsciiBlock(input.data() + pos))
+        {
+            std::memcpy(out, input.data() + pos, blockSize);
+            out += blockSize;
+            pos += blockSize;
+            continue;
+        }
+
+        const std::size_t end = std::min(pos + blockSize, input.size());
+
+        for (; pos < end && input[pos] != 0; ++pos)
+            copyFromArray(input[pos], out);
+
+        if (pos < end)
+            break;
+    }
 
     // Make sure that we wrote the correct number of bytes
     assert((out - buffer.data()) == (int)outlen);
@@ -192,23 +236,37 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLength(std::string_view in
 {
     // Do away with the ascii part of the string first (this is almost
     // always the entire string.)
-    auto it = skipAscii(input);
+    std::size_t pos = skipAscii(input);
 
     // If we're not at the null terminator at this point, then there
-    // were some non-ascii characters to deal with. Go to slow-mode for
-    // the rest of the string.
-    if (it == input.end() || *it == 0)
-        return { it - input.begin(), true };
+    // were some non-ascii characters to deal with. Look up the rest of
+    // the string in the table skipping ascii blocks.
+    if (pos == input.size() || input[pos] == 0)
+        return { pos, true };
 
-    std::size_t len = it - input.begin();
+    std::size_t len = pos;
 
-    do
+    while (pos < input.size())
     {
-        // Find the translated length of this character in the
-        // lookup table.
-        len += mTranslationArray[static_cast<unsigned char>(*it) * 6];
-        ++it;
-    } while (it != input.end() && *it != 0);
+        if (input.size() - pos >= blockSize && isAsciiBlock(input.data() + pos))
+        {
+            len += blockSize;
+            pos += blockSize;
+            continue;
+        }
+
+        const std::size_t end = std::min(pos + blockSize, input.size());
+
+        for (; pos < end; ++pos)
+        {
+            if (input[pos] == 0)
+                return { len, false };
+
+            // Find the translated length of this character in the
+            // lookup table.
+            len += mTranslationArray[static_cast<unsigned char>(input[pos]) * 6];
+        }
+    }
 
     return { len, false };
 }
@@ -234,7 +292,7 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLengthLegacyEnc(std::strin
 {
     // Do away with the ascii part of the string first (this is almost
     // always the entire string.)
-    auto it = skipAscii(input);
+    auto it = input.begin() + skipAscii(input);
 
     // If we're not at the null terminator at this point, then there
     // were some non-ascii characters to deal with. Go to slow-mode for
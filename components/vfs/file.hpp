@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_VFS_FILE_H
 
 #include <filesystem>
+#include <optional>
 #include <string>
 
 #include <components/files/istreamptr.hpp>
@@ -18,6 +19,9 @@ namespace VFS
         virtual std::filesystem::file_time_type getLastModified() const = 0;
 
         virtual std::string getStem() const = 0;
+
+        // Returns path to the file on the filesystem or nullopt if it is a part of an archive
+        virtual std::optional<std::filesystem::path> getFilesystemPath() const { return std::nullopt; }
     };
 }
 
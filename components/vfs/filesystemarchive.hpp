@@ -21,6 +21,8 @@ namespace VFS
 
         std::string getStem() const override;
 
+        std::optional<std::filesystem::path> getFilesystemPath() const override { return mPath; }
+
     private:
         std::filesystem::path mPath;
     };
@@ -97,6 +97,14 @@ namespace VFS
         return found->second->getStem();
     }
 
+    std::optional<std::filesystem::path> Manager::getFilesystemPath(VFS::Path::NormalizedView name) const
+    {
+        const auto found = mIndex.find(name);
+        if (found == mIndex.end())
+            return std::nullopt;
+        return found->second->getFilesystemPath();
+    }
+
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
     {
         if (path.empty())
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -71,6 +72,10 @@ namespace VFS
         // Equivalent to std::filesystem::path::stem. The result isn't normalized.
         std::string getStem(VFS::Path::NormalizedView name) const;
 
+        /// Returns path to the file on the filesystem or nullopt if it is a part of an archive or does not exist.
+        /// @note May be called from any thread once the index has been built.
+        std::optional<std::filesystem::path> getFilesystemPath(VFS::Path::NormalizedView name) const;
+
     private:
         std::vector<std::unique_ptr<Archive>> mArchives;
 
@@ -30,6 +30,61 @@
 -- List of nearby players. Currently (since multiplayer is not yet implemented) always has one element.
 -- @field [parent=#nearby] openmw.core#ObjectList players
 
+---
+-- @type OBJECT_GROUP
+-- @field [parent=#OBJECT_GROUP] #number Activators Objects from `nearby.activators`
+-- @field [parent=#OBJECT_GROUP] #number Actors Objects from `nearby.actors`
+-- @field [parent=#OBJECT_GROUP] #number Containers Objects from `nearby.containers`
+-- @field [parent=#OBJECT_GROUP] #number Doors Objects from `nearby.doors`
+-- @field [parent=#OBJECT_GROUP] #number Items Objects from `nearby.items`
+
+---
+-- Groups of nearby objects that can be used to filter spatial queries.
+-- @field [parent=#nearby] #OBJECT_GROUP OBJECT_GROUP
+
+---
+-- A table of parameters for @{#nearby.getObjectsInRadius} and @{#nearby.getObjectsInBox}
+-- @type ObjectQueryOptions
+-- @field #number group One of @{#OBJECT_GROUP}; if not set, all groups are searched.
+
+---
+-- A table of parameters for @{#nearby.getNearestObjects}
+-- @type NearestObjectsOptions
+-- @field #number group One of @{#OBJECT_GROUP}; if not set, all groups are searched.
+-- @field #number maxDistance Objects farther than this are ignored (default: unlimited).
+
+---
+-- Return nearby objects within the given distance from a point.
+-- Positions are indexed once per frame, so the query is much faster than checking distance to every object in Lua.
+-- The order of the objects in the result is not specified.
+-- @function [parent=#nearby] getObjectsInRadius
+-- @param openmw.util#Vector3 position
+-- @param #number radius
+-- @param #ObjectQueryOptions options (optional)
+-- @return openmw.core#ObjectList
+-- @usage local items = nearby.getObjectsInRadius(self.position, 500, { group = nearby.OBJECT_GROUP.Items })
+
+---
+-- Return nearby objects inside of an axis aligned box.
+-- The order of the objects in the result is not specified.
+-- @function [parent=#nearby] getObjectsInBox
+-- @param openmw.util#Vector3 min Corner of the box with minimal coordinates
+-- @param openmw.util#Vector3 max Corner of the box with maximal coordinates
+-- @param #ObjectQueryOptions options (optional)
+-- @return openmw.core#ObjectList
+
+---
+-- Return up to `count` nearby objects that are the nearest to a point, ordered by distance.
+-- @function [parent=#nearby] getNearestObjects
+-- @param openmw.util#Vector3 position
+-- @param #number count
+-- @param #NearestObjectsOptions options (optional)
+-- @return openmw.core#ObjectList
+-- @usage local nearest = nearby.getNearestObjects(self.position, 3, {
+--     group = nearby.OBJECT_GROUP.Actors,
+--     maxDistance = 1000,
+-- })
+
 ---
 -- Return an object by RefNum/FormId.
 -- Note: the function always returns @{openmw.core#GameObject} and doesn't validate that
@@ -67,7 +122,7 @@
 -- @field [parent=#RayCastingResult] openmw.core#GameObject hitObject The object the ray has collided with (can be nil)
 
 ---
--- A table of parameters for @{#nearby.castRay}
+-- A table of parameters for @{#nearby.castRay} and @{#nearby.asyncCastRay}
 -- @type CastRayOptions
 -- @field #any ignore An @{openmw.core#GameObject} or @{openmw.core#ObjectList} to ignore (specify here the source of the ray, or other objects which should not collide)
 -- @field #number collisionType Object types to work with (see @{openmw.nearby#COLLISION_TYPE})
@@ -89,6 +144,18 @@
 --     radius = 10,
 -- })
 
+---
+-- Asynchronously cast a ray from one point to another and find the first collision.
+-- Rays are cast by physics threads together with the simulation, so it is cheaper than `castRay` when many rays are
+-- needed. The result is passed to the callback in the next frame.
+-- @function [parent=#nearby] asyncCastRay
+-- @param openmw.async#Callback callback The callback to pass the result to (should accept a single argument @{openmw.nearby#RayCastingResult}).
+-- @param openmw.util#Vector3 from Start point of the ray.
+-- @param openmw.util#Vector3 to End point of the ray.
+-- @param #CastRayOptions options An optional table with additional optional arguments
+-- @usage nearby.asyncCastRay(async:callback(function(res) visible = not res.hit end), self.position, target.position,
+--     {ignore=self})
+
 ---
 -- A table of parameters for @{#nearby.castRenderingRay} and @{#nearby.asyncCastRenderingRay}
 -- @type CastRenderingRayOptions
@@ -174,7 +241,7 @@
 -- (default: 1).
 
 ---
--- A table of parameters for @{#nearby.findPath}
+-- A table of parameters for @{#nearby.findPath} and @{#nearby.asyncFindPath}
 -- @type FindPathOptions
 -- @field [parent=#FindPathOptions] #AgentBounds agentBounds identifies which navmesh to use.
 -- @field [parent=#FindPathOptions] #number includeFlags allowed areas for agent to move, a sum of @{#NAVIGATOR_FLAGS}
@@ -224,6 +291,27 @@
 --     agentBounds = Actor.getPathfindingAgentBounds(self),
 -- })
 
+---
+-- A result of @{#nearby.asyncFindPath}
+-- @type FindPathResult
+-- @field [parent=#FindPathResult] #FIND_PATH_STATUS status
+-- @field [parent=#FindPathResult] #list<openmw.util#Vector3> path
+
+---
+-- Asynchronously find a path over the navigation mesh from the source to the destination with the given options.
+-- The path is found in a background thread when `async path query threads` in the `[Navigator]` section of settings.cfg
+-- is positive, otherwise in the main thread, and passed to the callback in one of the next frames.
+-- @function [parent=#nearby] asyncFindPath
+-- @param openmw.async#Callback callback The callback to pass the result to (should accept a single argument @{#FindPathResult}).
+-- @param openmw.util#Vector3 source Initial path position.
+-- @param openmw.util#Vector3 destination Final path position.
+-- @param #FindPathOptions options An optional table with additional optional arguments.
+-- @usage nearby.asyncFindPath(async:callback(function(result)
+--     if result.status == nearby.FIND_PATH_STATUS.Success then
+--         print(#result.path)
+--     end
+-- end), source, destination)
+
 ---
 -- Returns a random location on the navigation mesh within the reach of the specified location.
 -- The location is not exactly constrained by the circle, but it limits the area.